@@ -38,6 +38,7 @@
 #include <array>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <cassert>
@@ -66,6 +67,18 @@ namespace monocypher {
     /// @note  This returns `bool`, not `int` like `memcmp` or `crypto_verify`!
     bool constant_time_compare(const void *a, const void *b, size_t size);
 
+    namespace internal {
+        // Calls `fn(job)` for each job in `[0, jobs)`, on up to `threads` threads (0 means one
+        // per CPU core), but no more than `max_threads`; the calling thread is one of them. Each
+        // thread takes the next job as it becomes free. Starting a thread costs far more than a
+        // function call, so callers size their jobs and `max_threads` to keep every thread busy
+        // for a while. If `fn` throws, or a thread can't be started, no more jobs are started
+        // and the exception is rethrown here once the running threads have finished. Used by
+        // the batch APIs.
+        void parallel_for(size_t jobs, unsigned threads, size_t max_threads,
+                          std::function<void(size_t job)> const& fn);
+    }
+
 
     /// General-purpose byte array. Used for hashes, nonces, MACs, etc.
     template <size_t Size>
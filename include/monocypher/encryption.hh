@@ -258,6 +258,61 @@ namespace monocypher {
                 return out.size == output.size();
             }
 
+            /// Encrypts in place a message that's already in its final position in a buffer,
+            /// preceded by `sizeof(mac)` bytes of reserved headroom. `buffer` covers both the
+            /// headroom and the plaintext; on return it holds the MAC and ciphertext, in the same
+            /// format `box` produces, without any data having been moved.
+            output_bytes box_in_place(const nonce &nonce,
+                                      output_bytes buffer) const
+            {
+                assert(buffer.size >= sizeof(mac));
+                auto mac_p = (mac*)buffer.data;
+                auto text = (uint8_t*)(mac_p + 1);
+                *mac_p = lock(nonce, input_bytes{text, buffer.size - sizeof(mac)}, text);
+                return buffer;
+            }
+
+            /// Decrypts in place a MAC-and-ciphertext produced by `box` or `box_in_place`.
+            /// Returns the plaintext, which is `boxed` minus its first `sizeof(mac)` bytes,
+            /// or {NULL,0} if the ciphertext is invalid. No data is moved.
+            [[nodiscard]]
+            output_bytes unbox_in_place(const nonce &nonce,
+                                        output_bytes boxed) const
+            {
+                if (boxed.size < sizeof(mac))
+                    return {};
+                auto mac_p = (const mac*)boxed.data;
+                auto text = (uint8_t*)(mac_p + 1);
+                size_t size = boxed.size - sizeof(mac);
+                if (!unlock(nonce, *mac_p, input_bytes{text, size}, text))
+                    return {};
+                return {text, size};
+            }
+
+            /// A version of `unbox` for messages whose nonce is the sequence number `seq`, which
+            /// may arrive out of order or duplicated. `window` is typically an
+            /// `ext::replay_window`; any type with `bool check(uint64_t)` and
+            /// `bool commit(uint64_t)` methods works. The window is only updated after the
+            /// message authenticates, so forgeries can't advance it. Returns {NULL,0} if the
+            /// message is invalid or `seq` has already been seen or is too old.
+            template <class Window>
+            [[nodiscard]]
+            output_bytes unbox(Window &window,
+                               uint64_t seq,
+                               input_bytes boxed_cipher_text,
+                               output_bytes output_buffer) const
+            {
+                if (!window.check(seq))
+                    return {};
+                output_bytes out = unbox(nonce(seq), boxed_cipher_text, output_buffer);
+                if (out && !window.commit(seq)) {
+                    // Another thread committed the same `seq` since the `check`:
+                    c::crypto_wipe(out.data, out.size);
+                    return {};
+                }
+                return out;
+            }
+
         private:
             // `crypto_lock` only allows input and output buffers to overlap if they're identical.
             // If the src and dst ranges overlap but are not identical, copy src to dst and set
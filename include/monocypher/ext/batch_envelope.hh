@@ -0,0 +1,165 @@
+//
+//  monocypher/ext/batch_envelope.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// Packs many small records into one encrypted envelope, sealed with a single nonce and MAC,
+    /// instead of boxing each record separately.
+    ///
+    /// An envelope is `nonce (24) || mac (16) || ciphertext`. The plaintext is the records
+    /// concatenated, followed by an index of their lengths as LEB128 varints (one byte each for
+    /// records under 128 bytes), followed by the index size as 4 bytes little-endian. The index
+    /// is encrypted along with the records.
+    ///
+    /// The receiver calls `batch_envelope::open`, which decrypts the envelope in place; the
+    /// records can then be iterated without copying.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class batch_envelope {
+    public:
+        using key = session::key;
+        using clock = std::chrono::steady_clock;
+
+        /// Fixed size of an envelope, not counting records or their index entries.
+        static constexpr size_t overhead = sizeof(session::nonce) + sizeof(session::mac) + 4;
+
+
+        /// Accumulates records and seals them into envelopes, which it passes to a callback.
+        /// Not thread-safe.
+        class writer {
+        public:
+            struct options {
+                size_t                    max_size    = 16 * 1024;  ///< Max envelope size
+                size_t                    max_records = 4096;       ///< Max records per envelope
+                std::chrono::microseconds max_delay   = std::chrono::milliseconds(10); ///< Max time a record waits
+            };
+
+            /// Called with each sealed envelope. The data is only valid during the call.
+            using flush_fn = std::function<void(input_bytes envelope)>;
+
+            writer(key const&, flush_fn);
+            writer(key const&, options const&, flush_fn);
+            ~writer();
+
+            /// Adds a record. If it doesn't fit in the current envelope, that envelope is
+            /// flushed first. If the oldest record has waited longer than `max_delay`, the
+            /// envelope is flushed afterwards. Throws `std::invalid_argument` if the record is
+            /// too large to fit in an envelope by itself.
+            void add(input_bytes record);
+
+            /// Seals and delivers the current envelope, if it's not empty.
+            void flush();
+
+            /// Flushes if the oldest record has waited longer than `max_delay`. Call this
+            /// periodically (e.g. from an event loop timer) so records don't wait for the next
+            /// `add`. Returns true if it flushed.
+            bool flush_if_due(clock::time_point now = clock::now());
+
+            /// The number of records waiting in the current envelope.
+            size_t pending_records() const          {return _count;}
+
+            /// The size the current envelope would be, if flushed now.
+            size_t pending_size() const             {return _buffer.size() + _index.size() + 4;}
+
+        private:
+            key                 _key;
+            options             _options;
+            flush_fn            _flush;
+            std::vector<uint8_t> _buffer;           // nonce and mac space, then records
+            std::vector<uint8_t> _index;            // record lengths, as varints
+            size_t              _count = 0;
+            clock::time_point   _first_time;        // when the oldest pending record was added
+        };
+
+
+        /// The records in an opened envelope. Iterating yields `input_bytes` pointing into the
+        /// envelope buffer.
+        class records {
+        public:
+            class iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = input_bytes;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const input_bytes*;
+                using reference         = input_bytes;
+
+                input_bytes operator*() const       {return {_record, _size};}
+                iterator& operator++ ();
+                bool operator== (iterator const& other) const {return _index == other._index;}
+                bool operator!= (iterator const& other) const {return _index != other._index;}
+
+            private:
+                friend class records;
+                iterator(const uint8_t *record, const uint8_t *index, const uint8_t *index_end);
+
+                void read_entry();
+
+                const uint8_t *_record;             // start of current record
+                size_t         _size = 0;           // size of current record
+                const uint8_t *_index;              // current record's index entry
+                const uint8_t *_next = nullptr;     // next index entry
+                const uint8_t *_index_end;
+            };
+
+            iterator begin() const                  {return iterator(_data, _index, _index_end);}
+            iterator end() const                    {return iterator(nullptr, _index_end, _index_end);}
+            size_t size() const                     {return _count;}
+            bool empty() const                      {return _count == 0;}
+
+        private:
+            friend class batch_envelope;
+            records(const uint8_t *data, const uint8_t *index, const uint8_t *index_end,
+                    size_t count)
+            :_data(data), _index(index), _index_end(index_end), _count(count) { }
+
+            const uint8_t *_data, *_index, *_index_end;
+            size_t         _count;
+        };
+
+
+        /// Authenticates and decrypts an envelope in place. Returns its records, which point
+        /// into the envelope buffer, or `nullopt` if the envelope is invalid.
+        [[nodiscard]]
+        static std::optional<records> open(key const&, output_bytes envelope);
+    };
+
+}
@@ -42,6 +42,10 @@ namespace monocypher::ext {
         using context = byte_array<1912>;
         static void init_fn  (context *ctx);
         static void update_fn(context *ctx, const uint8_t *message, size_t  message_size);
+
+        static constexpr uint8_t checkpoint_id = 4;
+        static void save_fn(const context*, std::vector<uint8_t>&);
+        static void restore_fn(context*, const uint8_t *state, size_t size);
     protected:
         static void final_fn(context *ctx, uint8_t *hash, size_t hash_size);
         static void create_fn(uint8_t *hash, size_t hash_size, const uint8_t *msg, size_t msg_size);
@@ -80,6 +84,8 @@ namespace monocypher::ext {
             }
             static constexpr auto update_fn     = Blake3::update_fn;
             static constexpr auto final_fn      = Blake3::final_fn;
+            static constexpr auto save_fn       = Blake3::save_fn;
+            static constexpr auto restore_fn    = Blake3::restore_fn;
         };
     };
 
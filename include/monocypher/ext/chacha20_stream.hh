@@ -0,0 +1,111 @@
+//
+//  monocypher/ext/chacha20_stream.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../base.hh"
+
+namespace monocypher::ext {
+
+    /// The raw ChaCha20 stream cipher (the original variant with a 64-bit nonce and 64-bit block
+    /// counter), with random access: you can encrypt or decrypt any byte range of the stream
+    /// without processing what comes before it. Runs of whole blocks use an 8-way (AVX2) or
+    /// 16-way (AVX-512) SIMD implementation where available.
+    ///
+    /// Byte offset `64 * n` of the stream is the start of block `n`, i.e. what Monocypher's
+    /// `crypto_chacha20_djb` produces when called with counter `n`.
+    ///
+    /// @warning  This is encryption _without authentication_: an attacker can flip any bit of
+    ///     the plaintext by flipping the same bit of the ciphertext. Only use it where integrity
+    ///     is provided by some other layer. Never reuse a key+nonce for different data.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself, though it uses Monocypher's
+    ///     ChaCha20 for partial blocks.
+    class chacha20_stream {
+    public:
+        chacha20_stream(byte_array<32> const& key, byte_array<8> const& nonce, uint64_t offset = 0)
+        :_key(key), _nonce(nonce), _offset(offset) { }
+
+        /// Moves to byte offset `offset` in the keystream.
+        void seek(uint64_t offset)                  {_offset = offset;}
+
+        /// The current byte offset in the keystream.
+        uint64_t tell() const                       {return _offset;}
+
+        /// XORs the keystream at the current offset with `in`, writing the result to `out`
+        /// (which may be the same address), and advances the offset by `in.size`.
+        /// Encryption and decryption are the same operation.
+        void apply(input_bytes in, void *out) {
+            apply_at(_offset, in, out);
+            _offset += in.size;
+        }
+
+        /// XORs the keystream starting at byte offset `offset` with `in`, writing the result to
+        /// `out` (which may be the same address.) Doesn't change the stream's offset, so
+        /// multiple threads can safely call this on one stream to process different slices.
+        void apply_at(uint64_t offset, input_bytes in, void *out) const;
+
+        /// Writes `size` bytes of raw keystream, starting at byte offset `offset`, to `out`.
+        void keystream_at(uint64_t offset, void *out, size_t size) const {
+            apply_at(offset, {nullptr, size}, out);
+        }
+
+        /// Limits the number of blocks the SIMD path processes at once to `max_lanes` (16, 8 or
+        /// 1), for testing and benchmarking. Returns the number actually used, which also depends
+        /// on the CPU.
+        static unsigned set_lanes(unsigned max_lanes);
+
+    protected:
+        explicit chacha20_stream(uint64_t offset)   :_offset(offset) { }
+
+        secret_byte_array<32> _key;
+        byte_array<8>         _nonce;
+        uint64_t              _offset;
+    };
+
+
+    /// XChaCha20 with random access: like `chacha20_stream` but with a 24-byte nonce, so nonces
+    /// can be chosen at random. Produces the same keystream as Monocypher's `crypto_chacha20_x`,
+    /// whose counter `n` corresponds to byte offset `64 * n`. (The key and nonce can be a
+    /// `session::key` and `session::nonce`.)
+    ///
+    /// @warning  This is encryption _without authentication_; see `chacha20_stream`.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself, though it uses Monocypher's
+    ///     ChaCha20 for partial blocks.
+    class xchacha20_stream : public chacha20_stream {
+    public:
+        xchacha20_stream(byte_array<32> const& key, byte_array<24> const& nonce,
+                         uint64_t offset = 0);
+    };
+
+}
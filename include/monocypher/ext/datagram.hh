@@ -0,0 +1,164 @@
+//
+//  monocypher/ext/datagram.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include "replay_window.hh"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// Encrypts datagrams (e.g. UDP packets) with implicit sequence-number nonces.
+    ///
+    /// A packet is `seq || mac || ciphertext`, where `seq` is only the low `seq_size` bytes
+    /// (little-endian) of a 64-bit sequence number. The nonce is the full sequence number, which
+    /// the `datagram_receiver` reconstructs, so the per-packet overhead is `seq_size + 16` bytes
+    /// instead of the 40 bytes of a random nonce plus MAC.
+    ///
+    /// `seal` is thread-safe; each call atomically takes the next sequence number.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class datagram_sender {
+    public:
+        using key = session::encryption_key<XChaCha20_Poly1305>;
+
+        /// @param seq_size  Number of sequence-number bytes sent per packet, from 1 to 8.
+        ///        The receiver can handle reordering of up to half that range (2^31 packets
+        ///        for the default of 4.) Must match the receiver's.
+        explicit datagram_sender(key const&, size_t seq_size = 4);
+
+        /// The number of bytes a packet is larger than its message.
+        size_t overhead() const                     {return _seq_size + sizeof(session::mac);}
+
+        /// Encrypts `message` into `packet`, which must have room for `overhead()` extra bytes.
+        /// Returns `packet` shrunk to the size of the packet.
+        output_bytes seal(input_bytes message, output_bytes packet);
+
+        /// The sequence number the next packet will use.
+        uint64_t next_sequence() const              {return _next_seq;}
+
+    private:
+        key                   _key;
+        size_t                _seq_size;
+        std::atomic<uint64_t> _next_seq {0};
+    };
+
+
+    /// Decrypts datagrams created by a `datagram_sender`. Packets may arrive out of order.
+    ///
+    /// The full sequence number of a packet is taken to be the one closest to the highest
+    /// sequence number authenticated so far, given its truncated bits. Duplicate packets, and
+    /// packets older than the replay window, are rejected.
+    ///
+    /// `open` is thread-safe.
+    class datagram_receiver {
+    public:
+        using key = datagram_sender::key;
+
+        /// @param window_size  How far out of order packets may arrive (see `replay_window`.)
+        explicit datagram_receiver(key const&, size_t seq_size = 4, size_t window_size = 1024);
+
+        size_t overhead() const                     {return _seq_size + sizeof(session::mac);}
+
+        /// Authenticates and decrypts a packet into `message`, which needs `packet.size -
+        /// overhead()` bytes. It may point to `packet.data + overhead()`, to decrypt in place.
+        /// Returns `message` shrunk to the message size, or `{nullptr, 0}` if the packet is
+        /// invalid.
+        [[nodiscard]]
+        output_bytes open(input_bytes packet, output_bytes message);
+
+        /// Reconstructs a full sequence number from its truncated form in a packet.
+        uint64_t expand_sequence(uint64_t truncated) const;
+
+        /// One more than the highest sequence number received so far (0 if none.)
+        uint64_t expected_sequence() const          {return _window.top();}
+
+    private:
+        key                   _key;
+        size_t                _seq_size;
+        replay_window         _window;
+    };
+
+
+#ifndef _WIN32
+    /// A reusable set of packet buffers, for sending or receiving many datagrams at once over a
+    /// connected datagram socket. On Linux this uses single `sendmmsg` / `recvmmsg` calls;
+    /// elsewhere it loops over `send` / `recv`.
+    ///
+    /// I/O errors throw `std::system_error`.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself. It's only available on
+    ///       POSIX platforms.
+    class datagram_batch {
+    public:
+        explicit datagram_batch(size_t capacity = 64, size_t max_packet_size = 1500);
+
+        size_t capacity() const                     {return _capacity;}
+        size_t size() const                         {return _count;}
+        bool full() const                           {return _count == _capacity;}
+        void clear()                                {_count = 0; _messages.clear(); _rejected = 0;}
+
+        /// Encrypts `message` and appends the packet to the batch. Returns false if the batch is
+        /// full. Throws `std::invalid_argument` if the packet would exceed the max packet size.
+        bool add(datagram_sender&, input_bytes message);
+
+        /// Sends all the packets, then clears the batch. Returns the number sent.
+        size_t send(int fd);
+
+        /// Clears the batch, then blocks until at least one datagram arrives and reads as many
+        /// as are available, up to the capacity. Packets are decrypted in place; invalid ones
+        /// are dropped. Returns the number of valid messages. Throws `std::invalid_argument`
+        /// if the max packet size is smaller than the receiver's overhead.
+        size_t receive(int fd, datagram_receiver&);
+
+        /// After `receive`, the decrypted messages.
+        std::vector<input_bytes> const& messages() const    {return _messages;}
+
+        /// After `receive`, the number of packets that were dropped as invalid.
+        size_t rejected() const                     {return _rejected;}
+
+    private:
+        uint8_t* slot(size_t i)                     {return &_buffer[i * _max_packet_size];}
+
+        size_t                     _capacity, _max_packet_size;
+        std::unique_ptr<uint8_t[]> _buffer;
+        std::vector<size_t>        _sizes;
+        size_t                     _count = 0;
+        std::vector<input_bytes>   _messages;
+        size_t                     _rejected = 0;
+    };
+#endif // _WIN32
+
+}
@@ -41,15 +41,24 @@ namespace monocypher {
     // This functionality is an extension that comes with Monocypher.
     // It's not considered part of the core API, but is provided for compatibility.
 
+    /// Ed25519 versions of `eddsa_key_pair` and `eddsa_sign`: the same as Monocypher's
+    /// `crypto_ed25519_key_pair` and `crypto_ed25519_sign`, but with the CMake option
+    /// `MONOCYPHER_WIDE_COMB` they use the library's larger fixed-base table.
+    void ed25519_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]);
+    void ed25519_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                      const uint8_t *message, size_t message_size);
+
+
     /// EdDSA with Curve25519 and SHA-512.
     /// \note This algorithm is more widely used than `EdDSA`, but slower and brings in more code.
     /// (Use as `<Algorithm>` parameter to `signature`, `public_key`, `key_pair`.)
     struct Ed25519 {
         static constexpr const char* name = "Ed25519";
-        static constexpr auto generate_fn      = c::crypto_ed25519_key_pair;
+        static constexpr auto generate_fn      = ed25519_key_pair;
         static constexpr auto check_fn         = c::crypto_ed25519_check;
-        static constexpr auto sign_fn          = c::crypto_ed25519_sign;
+        static constexpr auto sign_fn          = ed25519_sign;
         static constexpr auto public_to_kx_fn  = c::crypto_eddsa_to_x25519; // yup, it's the same
+        static constexpr auto public_to_kx_many_fn = eddsa_to_x25519_many;
 
         static void private_to_kx_fn(uint8_t x25519[32], const uint8_t eddsa[32]) {
             // Adapted from Monocypher 3's crypto_from_ed25519_private()
@@ -58,6 +67,19 @@ namespace monocypher {
             ::memcpy(x25519, a.data(), 32);
         }
 
+        /// Computes the verification challenge `k = SHA512(R || A || M) mod L`.
+        static void challenge_fn(uint8_t k[32], const uint8_t R[32], const uint8_t A[32],
+                                 const uint8_t *msg, size_t msg_size) {
+            c::crypto_sha512_ctx ctx;
+            uint8_t h[64];
+            c::crypto_sha512_init(&ctx);
+            c::crypto_sha512_update(&ctx, R, 32);
+            c::crypto_sha512_update(&ctx, A, 32);
+            c::crypto_sha512_update(&ctx, msg, msg_size);
+            c::crypto_sha512_final(&ctx, h);
+            c::crypto_eddsa_reduce(k, h);
+        }
+
         // Convenient type aliases for those who don't like angle brackets
         using signature   = monocypher::signature<Ed25519>;
         using public_key  = monocypher::public_key<Ed25519>;
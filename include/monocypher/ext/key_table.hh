@@ -0,0 +1,212 @@
+//
+//  monocypher/ext/key_table.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// A concurrent table mapping 64-bit connection IDs to session keys, optimized for
+    /// read-mostly workloads: many threads looking up keys on every packet, while keys are
+    /// added, rotated or removed comparatively rarely.
+    ///
+    /// - Lookups go through a `reader`, one per thread. They take no locks and do no
+    ///   read-modify-write operations, and finish in a bounded number of steps (wait-free.)
+    /// - Writers are serialized by a mutex. The table uses open addressing (linear probing) over
+    ///   an array of indexes of immutable key nodes. Replacing a key publishes a new node; the
+    ///   index array itself is replaced when tombstones accumulate.
+    /// - Replaced nodes and arrays are reclaimed with epoch-based reclamation: a retired node's
+    ///   key is wiped only after every reader that might still see it has finished its lookup.
+    /// - Key nodes live in a fixed-size pool of memory that's `mlock`ed (if the process's
+    ///   RLIMIT_MEMLOCK allows) and excluded from core dumps (on Linux.)
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class session_key_table {
+    private:
+        struct node;
+        struct reader_slot;
+    public:
+        using key = session::key;
+
+        struct options {
+            size_t max_keys    = 1 << 20;   ///< Max number of keys in the table at once
+            size_t max_readers = 128;       ///< Max number of `reader`s at once
+        };
+
+        session_key_table();
+        explicit session_key_table(options const&);
+        ~session_key_table();
+
+        session_key_table(session_key_table const&) = delete;
+        session_key_table& operator=(session_key_table const&) = delete;
+
+        /// Adds a key, or replaces (rotates) the existing key for `id`. Returns false if the
+        /// table already has `max_keys` keys.
+        /// If too many retired keys are awaiting reclamation, this waits for the readers that
+        /// are holding them up; so don't call it from inside `reader::with_key`.
+        [[nodiscard]] bool insert_or_assign(uint64_t id, key const&);
+
+        /// Removes the key for `id`; returns false if there wasn't one.
+        bool erase(uint64_t id);
+
+        /// The number of keys in the table.
+        size_t size() const;
+
+        /// Wipes and frees retired keys whose grace period is over, i.e. that no reader can
+        /// still be looking at. Called automatically by `insert_or_assign` and `erase`.
+        void collect();
+
+        /// The number of retired keys not yet reclaimed.
+        size_t retired_count() const;
+
+        /// True if the key memory was successfully locked into RAM.
+        bool is_memory_locked() const                   {return _locked;}
+
+
+        /// A per-thread handle for looking up keys. Not thread-safe itself; create one per
+        /// thread. Throws `std::runtime_error` if there are already `max_readers` readers.
+        class reader {
+        public:
+            explicit reader(session_key_table&);
+            ~reader();
+            reader(reader const&) = delete;
+            reader& operator=(reader const&) = delete;
+
+            /// Looks up the key for `id` and, if found, calls `fn(key const&)` and returns true.
+            /// The key reference is only valid during the call. If `fn` throws, the exception
+            /// propagates and the reader is left usable.
+            template <class Fn>
+            bool with_key(uint64_t id, Fn &&fn) {
+                auto &epoch = _slot->epoch;
+                assert(epoch.load(std::memory_order_relaxed) == 0);     // not re-entrant
+                epoch.store(_table._epoch.load());
+                // The epoch must be visible before any index slot is read: the writer's exchange
+                // on a slot and its later read of reader epochs must not both miss each other.
+                // An acquire load of the slot alone doesn't order it after the store above.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // Leave the epoch even if `fn` throws, or reclamation would stall forever:
+                struct epoch_guard {
+                    std::atomic<uint64_t> &epoch;
+                    ~epoch_guard()      {epoch.store(0, std::memory_order_release);}
+                } guard {epoch};
+                if (const node *n = _table.find_node(id)) {
+                    fn(n->k);
+                    return true;
+                }
+                return false;
+            }
+
+            /// Returns a copy of the key for `id`, if any.
+            std::optional<key> find(uint64_t id) {
+                std::optional<key> result;
+                with_key(id, [&](key const& k) {result.emplace(k);});
+                return result;
+            }
+
+        private:
+            session_key_table&     _table;
+            reader_slot*           _slot;
+        };
+
+    private:
+        struct node {
+            uint64_t id;
+            key      k;
+        };
+
+        struct table_array {
+            size_t                                   capacity;      // power of 2
+            std::unique_ptr<std::atomic<uint32_t>[]> index;         // node index, or empty/deleted
+        };
+
+        static constexpr uint32_t kEmpty = UINT32_MAX, kDeleted = UINT32_MAX - 1;
+
+        size_t bucket(uint64_t id) const {
+            // splitmix64 finalizer, randomly seeded so IDs can't be chosen to collide
+            uint64_t z = id ^ _seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return size_t(z ^ (z >> 31));
+        }
+
+        node* node_at(uint32_t i) const                 {return &_nodes[i];}
+
+        // Wait-free: probes at most `capacity` buckets.
+        const node* find_node(uint64_t id) const {
+            table_array *t = _table.load();
+            size_t mask = t->capacity - 1;
+            for (size_t i = bucket(id), n = 0; n <= mask; ++i, ++n) {
+                uint32_t ni = t->index[i & mask].load(std::memory_order_acquire);
+                if (ni == kEmpty)
+                    break;
+                else if (ni != kDeleted && node_at(ni)->id == id)
+                    return node_at(ni);
+            }
+            return nullptr;
+        }
+
+        size_t find_bucket(table_array*, uint64_t id) const;
+        uint32_t allocate_node(uint64_t id, key const&);
+        void retire_node(uint32_t);
+        void rebuild_table();
+        void reclaim();
+
+        options                          _options;
+        uint64_t                         _seed;
+        node*                            _nodes;            // mlock'ed pool of key nodes
+        size_t                           _pool_size;        // node count
+        size_t                           _pool_bytes;
+        bool                             _locked = false;
+        std::atomic<table_array*>        _table;
+        std::atomic<uint64_t>            _epoch {1};
+
+        struct alignas(64) reader_slot {
+            std::atomic<uint64_t> epoch {0};            // 0 if not in a lookup
+            std::atomic<bool>     in_use {false};
+        };
+        std::unique_ptr<reader_slot[]>   _readers;
+
+        // Writer state, protected by `_mutex`:
+        mutable std::mutex                              _mutex;
+        std::vector<uint32_t>                           _free_nodes;
+        std::vector<std::pair<uint64_t,uint32_t>>       _retired_nodes;     // (epoch, node)
+        std::vector<std::pair<uint64_t,std::unique_ptr<table_array>>> _retired_tables;
+        size_t                                          _count = 0, _tombstones = 0;
+    };
+
+}
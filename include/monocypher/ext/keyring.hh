@@ -0,0 +1,147 @@
+//
+//  monocypher/ext/keyring.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../signatures.hh"
+#include "ed25519.hh"
+#include <optional>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// A read-only set of trusted public keys, each with optional metadata, stored in a compact
+    /// binary file that's memory-mapped rather than parsed, so opening even a huge keyring is
+    /// instantaneous and its pages are shared between processes through the OS page cache.
+    ///
+    /// The file contains the keys in sorted order, plus a radix index on their first two bytes,
+    /// so a lookup jumps straight to a bucket (~n/65536 keys) and binary-searches only that.
+    /// Keys can also be found by their `key_id`, an 8-byte Blake2b fingerprint, through a
+    /// second sorted array with its own radix index.
+    ///
+    /// Keyring files are created with `keyring::builder`, or the `monocypher-keyring` tool.
+    /// Opening a file checks its header and section bounds; lookups never read outside the
+    /// mapping, even if the file's contents are corrupt. (They'd just fail to find things.)
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class keyring {
+    public:
+        using key    = byte_array<32>;
+        using key_id = byte_array<8>;
+
+        /// Computes a key's fingerprint: the first 8 bytes of its Blake2b hash.
+        static key_id id_of(key const&);
+
+        /// Opens and memory-maps a keyring file. Throws `std::system_error` if the file can't
+        /// be opened, or `std::runtime_error` if it's not a valid keyring.
+        explicit keyring(const char *path);
+        ~keyring();
+
+        keyring(keyring const&) = delete;
+        keyring& operator=(keyring const&) = delete;
+
+        /// A key in the keyring.
+        struct entry {
+            size_t      index;              ///< Position in the keyring (in sorted key order)
+            const key*  key_ptr;            ///< Points into the mapped file
+            input_bytes metadata;           ///< Points into the mapped file; may be empty
+
+            /// The key as a typed public key.
+            template <class Algorithm = Ed25519>
+            monocypher::public_key<Algorithm> typed_key() const {
+                return monocypher::public_key<Algorithm>(key_ptr->data(), 32);
+            }
+        };
+
+        /// The number of keys.
+        size_t size() const                         {return _count;}
+
+        /// The key at an index, which must be less than `size()`.
+        entry operator[] (size_t index) const;
+
+        /// True if the keyring contains the key.
+        bool contains(key const& k) const           {return find(k).has_value();}
+
+        /// Looks up a key.
+        std::optional<entry> find(key const&) const;
+
+        /// Looks up a key by its fingerprint. If several keys share the fingerprint (only
+        /// possible with maliciously chosen keys), returns the first; use `find_all` to get all.
+        std::optional<entry> find(key_id const&) const;
+
+        /// Returns all keys with the given fingerprint.
+        std::vector<entry> find_all(key_id const&) const;
+
+
+        /// Creates keyring files.
+        class builder {
+        public:
+            /// Adds a key with optional metadata.
+            void add(key const&, input_bytes metadata = {nullptr, 0});
+
+            /// The number of keys added so far.
+            size_t size() const                     {return _keys.size();}
+
+            /// Writes the keyring file. It's written to a temporary file and then renamed, so
+            /// readers never see a partial keyring. Throws `std::invalid_argument` if the same key
+            /// was added twice, or `std::system_error` on I/O errors.
+            void write(const char *path) const;
+
+        private:
+            struct item {
+                key      k;
+                uint64_t meta_start;
+                uint32_t meta_size;
+            };
+            std::vector<item>    _keys;
+            std::vector<uint8_t> _metadata;
+        };
+
+    private:
+        static constexpr size_t kRadixSize = 65536 + 1;
+
+        std::pair<size_t,size_t> bucket(const uint8_t *radix, const uint8_t *prefix) const;
+        size_t lower_bound_id(key_id const&) const;
+
+        const uint8_t*  _map = nullptr;         // The mapped file
+        size_t          _map_size = 0;
+        size_t          _count = 0;
+        const uint8_t*  _key_radix;             // kRadixSize uint32s, little-endian
+        const key*      _keys;                  // _count keys, sorted
+        const uint8_t*  _id_radix;              // kRadixSize uint32s, little-endian
+        const uint8_t*  _ids;                   // _count 16-byte records: id, uint32 key index, 0
+        const uint8_t*  _meta_index;            // _count + 1 uint64 offsets into _meta
+        const uint8_t*  _meta;
+        uint64_t        _meta_size;
+    };
+
+}
@@ -0,0 +1,197 @@
+//
+//  monocypher/ext/mlkem.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../base.hh"
+#include <stdexcept>
+#include <utility>
+
+namespace monocypher::ext {
+
+    /// ML-KEM-768 (FIPS 203), the post-quantum key encapsulation mechanism formerly known as
+    /// Kyber; use as the `<Algorithm>` parameter of `kem`.
+    ///
+    /// The number-theoretic transforms use AVX2 when the CPU supports it (detected at runtime),
+    /// otherwise portable C++. The two produce identical results.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    struct ML_KEM_768 {
+        static constexpr const char* name = "ML-KEM-768";
+        static constexpr size_t seed_size          = 64;    ///< Key-generation seed (d || z)
+        static constexpr size_t public_key_size    = 1184;
+        static constexpr size_t secret_key_size    = 2400;
+        static constexpr size_t ciphertext_size    = 1088;
+        static constexpr size_t encapsulation_seed_size = 32;
+
+        static void generate_fn(uint8_t public_key[public_key_size],
+                                uint8_t secret_key[secret_key_size],
+                                const uint8_t seed[seed_size]);
+        static bool check_public_key_fn(const uint8_t public_key[public_key_size]);
+        static void encapsulate_fn(uint8_t ciphertext[ciphertext_size],
+                                   uint8_t shared_secret[32],
+                                   const uint8_t public_key[public_key_size],
+                                   const uint8_t seed[encapsulation_seed_size]);
+        static void decapsulate_fn(uint8_t shared_secret[32],
+                                   const uint8_t ciphertext[ciphertext_size],
+                                   const uint8_t secret_key[secret_key_size]);
+
+        /// Enables or disables the AVX2 code (it's enabled by default if the CPU supports it.)
+        /// For testing and benchmarking; don't call this while other threads are using ML-KEM.
+        /// Returns true if AVX2 is now in use.
+        static bool set_simd_enabled(bool);
+    };
+
+
+    /// Hybrid post-quantum key encapsulation combining X25519 and ML-KEM-768, so the shared
+    /// secret is safe as long as _either_ of them is unbroken. Use as the `<Algorithm>`
+    /// parameter of `kem`.
+    ///
+    /// - The public key is the ML-KEM public key followed by the X25519 public key; the
+    ///   ciphertext is the ML-KEM ciphertext followed by an ephemeral X25519 public key.
+    /// - The secret key is derived from a 32-byte seed, expanded with SHAKE256 into an ML-KEM
+    ///   seed and an X25519 secret key.
+    /// - The shared secret is SHA3-256 of a domain-separation label, the two component shared
+    ///   secrets, the ephemeral X25519 key and the recipient's X25519 public key.
+    ///
+    /// (The construction follows X-Wing, but the label differs, so it doesn't interoperate.)
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    struct X25519_MLKEM768 {
+        static constexpr const char* name = "X25519+ML-KEM-768";
+        static constexpr size_t seed_size          = 32;
+        static constexpr size_t public_key_size    = ML_KEM_768::public_key_size + 32;
+        static constexpr size_t secret_key_size    = ML_KEM_768::secret_key_size + 32 + 32;
+        static constexpr size_t ciphertext_size    = ML_KEM_768::ciphertext_size + 32;
+        static constexpr size_t encapsulation_seed_size = 64;
+
+        static void generate_fn(uint8_t public_key[public_key_size],
+                                uint8_t secret_key[secret_key_size],
+                                const uint8_t seed[seed_size]);
+        static bool check_public_key_fn(const uint8_t public_key[public_key_size]);
+        static void encapsulate_fn(uint8_t ciphertext[ciphertext_size],
+                                   uint8_t shared_secret[32],
+                                   const uint8_t public_key[public_key_size],
+                                   const uint8_t seed[encapsulation_seed_size]);
+        static void decapsulate_fn(uint8_t shared_secret[32],
+                                   const uint8_t ciphertext[ciphertext_size],
+                                   const uint8_t secret_key[secret_key_size]);
+    };
+
+
+    /// Key encapsulation: the counterpart of `key_exchange` for algorithms like ML-KEM that
+    /// aren't Diffie-Hellman. The recipient publishes its public key; the sender calls
+    /// `encapsulate` with it, getting a shared secret plus a ciphertext to send; the recipient
+    /// passes the ciphertext to `decapsulate` to get the same shared secret.
+    ///
+    /// Decapsulating a corrupted or forged ciphertext doesn't fail; it produces a pseudorandom
+    /// secret that won't match the sender's ("implicit rejection".) So use the shared secret as
+    /// a key for authenticated encryption, which will then fail.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    template <class Algorithm>
+    class kem {
+    public:
+        /// Random seed from which a key pair is derived; the compact form of the secret key.
+        struct seed : public secret_byte_array<Algorithm::seed_size> { };
+
+        /// The recipient's public key, to be given to senders.
+        struct public_key : public byte_array<Algorithm::public_key_size> {
+            public_key()                                :byte_array<Algorithm::public_key_size>(0) { }
+            public_key(const void *data, size_t size)   :byte_array<Algorithm::public_key_size>(data, size) { }
+        };
+
+        /// The encapsulated secret, sent from the sender to the recipient.
+        struct ciphertext : public byte_array<Algorithm::ciphertext_size> {
+            ciphertext()                                :byte_array<Algorithm::ciphertext_size>(0) { }
+            ciphertext(const void *data, size_t size)   :byte_array<Algorithm::ciphertext_size>(data, size) { }
+        };
+
+        /// A secret known to both parties, for use as a symmetric key.
+        struct shared_secret : public secret_byte_array<32> { };
+
+
+        /// Generates a random key pair.
+        kem() {
+            seed s;
+            s.randomize();
+            Algorithm::generate_fn(_public_key.data(), _secret_key.data(), s.data());
+        }
+
+        /// Regenerates a key pair from a seed.
+        explicit kem(seed const& s) {
+            Algorithm::generate_fn(_public_key.data(), _secret_key.data(), s.data());
+        }
+
+        /// Returns the public key to give to senders.
+        public_key const& get_public_key() const        {return _public_key;}
+
+        /// Returns true if a public key is well-formed. (`encapsulate` checks this too.)
+        static bool is_valid(public_key const& pk) {
+            return Algorithm::check_public_key_fn(pk.data());
+        }
+
+        /// Sender side: creates a random shared secret and the ciphertext encapsulating it for
+        /// the owner of `recipient`. Throws `std::invalid_argument` if the public key is invalid.
+        static std::pair<ciphertext,shared_secret> encapsulate(public_key const& recipient) {
+            secret_byte_array<Algorithm::encapsulation_seed_size> randomness;
+            randomness.randomize();
+            return encapsulate(recipient, randomness);
+        }
+
+        /// Deterministic version of `encapsulate`, for testing. `randomness` must be random and
+        /// never reused.
+        static std::pair<ciphertext,shared_secret>
+        encapsulate(public_key const& recipient,
+                    byte_array<Algorithm::encapsulation_seed_size> const& randomness)
+        {
+            if (!is_valid(recipient))
+                throw std::invalid_argument("invalid KEM public key");
+            std::pair<ciphertext,shared_secret> result;
+            Algorithm::encapsulate_fn(result.first.data(), result.second.data(),
+                                      recipient.data(), randomness.data());
+            return result;
+        }
+
+        /// Recipient side: recovers the shared secret from the sender's ciphertext.
+        shared_secret decapsulate(ciphertext const& ct) const {
+            shared_secret result;
+            Algorithm::decapsulate_fn(result.data(), ct.data(), _secret_key.data());
+            return result;
+        }
+
+    private:
+        secret_byte_array<Algorithm::secret_key_size> _secret_key;
+        public_key                                    _public_key;
+    };
+
+}
@@ -0,0 +1,102 @@
+//
+//  monocypher/ext/multi_recipient.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include "../key_exchange.hh"
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// Encrypts one payload for many recipients. The payload is encrypted once, under a random
+    /// session key; that key is then wrapped for each recipient using X25519 between a single
+    /// ephemeral key pair and the recipient's public key.
+    ///
+    /// Envelope format (integers little-endian):
+    ///
+    ///     version (1) = 1
+    ///     ephemeral public key (32)
+    ///     fanout bits `b` (1)
+    ///     recipient count `n` (4)
+    ///     fanout table: 2^b x 4 bytes; entry i is the number of slots whose hint's top b bits
+    ///                   are <= i
+    ///     n slots, sorted by hint: hint (4) || mac (16) || wrapped key (32)
+    ///     payload: mac (16) || ciphertext
+    ///
+    /// A recipient's wrapping key and 4-byte hint are derived by hashing the X25519 shared
+    /// secret with both public keys. The hint is therefore not linkable to the recipient's
+    /// public key, yet each recipient can compute its own hint and find its slot directly via
+    /// the fanout table, in O(1) time on average.
+    ///
+    /// @warning  This provides confidentiality, not sender authentication: anyone can create an
+    ///           envelope, and any recipient could construct a different payload for the
+    ///           others. Sign the envelope if that matters.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class multi_recipient {
+    public:
+        using key_exchange = monocypher::key_exchange<X25519_Raw>;
+        using public_key   = key_exchange::public_key;
+
+        static constexpr size_t slot_size = 4 + sizeof(session::mac) + sizeof(session::key);
+
+        /// The size of an envelope for the given number of recipients and payload size.
+        static size_t envelope_size(size_t recipient_count, size_t payload_size);
+
+        /// Encrypts `payload` for the `count` recipients. The per-recipient key agreement is
+        /// spread over `threads` threads (0 means one per CPU core.)
+        static std::vector<uint8_t> seal(input_bytes payload,
+                                         const public_key recipients[], size_t count,
+                                         unsigned threads = 0);
+
+        static std::vector<uint8_t> seal(input_bytes payload,
+                                         std::vector<public_key> const& recipients,
+                                         unsigned threads = 0)
+        {
+            return seal(payload, recipients.data(), recipients.size(), threads);
+        }
+
+        /// The size of the payload in an envelope, or 0 if it's malformed.
+        static size_t payload_size(input_bytes envelope);
+
+        /// Decrypts the payload of an envelope, using the recipient's key pair, into
+        /// `payload_out`, which must be at least `payload_size(envelope)` bytes.
+        /// Returns `payload_out` shrunk to the payload size, or `{nullptr, 0}` if the envelope
+        /// is malformed or corrupted, or isn't addressed to this recipient.
+        [[nodiscard]]
+        static output_bytes open(input_bytes envelope,
+                                 key_exchange const& recipient,
+                                 output_bytes payload_out);
+    };
+
+}
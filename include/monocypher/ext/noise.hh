@@ -0,0 +1,331 @@
+//
+//  monocypher/ext/noise.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../hash.hh"
+#include "../key_exchange.hh"
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace monocypher::ext::noise {
+
+    // An implementation of the Noise Protocol Framework, revision 34 <https://noiseprotocol.org>,
+    // with the cipher suite `25519_ChaChaPoly_BLAKE2b`.
+    //
+    // @note This functionality is NOT part of Monocypher itself; it's built on top of it.
+
+    /// The handshake patterns supported by `handshake`.
+    enum class pattern : uint8_t {
+        NK,     ///< Initiator knows the responder's static key; initiator is anonymous.
+        XX,     ///< Both parties transmit their static keys during the handshake.
+        IK,     ///< Initiator knows the responder's static key, and sends its own in message 1.
+    };
+
+    enum class role : uint8_t {
+        initiator,
+        responder,
+    };
+
+    using dh         = key_exchange<X25519_Raw>;
+    using public_key = dh::public_key;
+    using secret_key = dh::secret_key;
+
+    static constexpr size_t dh_size          = 32;      ///< DHLEN
+    static constexpr size_t hash_size        = 64;      ///< HASHLEN
+    static constexpr size_t mac_size         = 16;      ///< Size of an AEAD authentication tag
+    static constexpr size_t max_message_size = 65535;   ///< Max size of any Noise message
+
+
+    /// A Noise "CipherState": a ChaCha20-Poly1305 (IETF) key and a 64-bit message counter.
+    /// After a handshake completes, one `cipher_state` encrypts outgoing transport messages and
+    /// another decrypts incoming ones; both sides must process messages in the same order.
+    class cipher_state {
+    public:
+        cipher_state() = default;
+        explicit cipher_state(byte_array<32> const& k)             {initialize_key(k);}
+
+        void initialize_key(byte_array<32> const& k) {
+            _k.fillWith(k.data(), k.size());
+            _n = 0;
+            _has_key = true;
+        }
+
+        bool has_key() const                                       {return _has_key;}
+
+        /// The nonce that will be used for the next message.
+        uint64_t nonce() const                                     {return _n;}
+        void set_nonce(uint64_t n)                                 {_n = n;}
+
+        /// Encrypts `plain_text`, writing the ciphertext followed by the 16-byte MAC to `out`.
+        /// Returns `out` shrunk to `plain_text.size + mac_size`. If no key has been set, the
+        /// plaintext is copied unchanged. (It's OK for `plain_text` and `out` to be the same.)
+        output_bytes encrypt(input_bytes additional_data,
+                             input_bytes plain_text,
+                             output_bytes out);
+
+        /// Authenticates and decrypts a message produced by `encrypt`.
+        /// Returns `out` shrunk to the plaintext size, or `nullopt` if authentication fails;
+        /// in that case the nonce is not advanced.
+        [[nodiscard]]
+        std::optional<output_bytes> decrypt(input_bytes additional_data,
+                             input_bytes cipher_text,
+                             output_bytes out);
+
+        /// Replaces the key with a one-way function of itself, as per the spec's `Rekey()`.
+        /// Both sides must rekey at the same point in the message sequence.
+        void rekey();
+
+    private:
+        secret_byte_array<32> _k;
+        uint64_t              _n = 0;
+        bool                  _has_key = false;
+    };
+
+
+    /// The pair of cipher states produced by a completed handshake, oriented by role.
+    struct transport {
+        cipher_state send;          ///< Encrypts messages to the peer.
+        cipher_state receive;       ///< Decrypts messages from the peer.
+    };
+
+
+    /// An opaque single-use ticket that lets a peer resume a session without Diffie-Hellman.
+    /// Both parties of a completed handshake derive the same ticket; the initiator keeps it and
+    /// the responder stores it in its `ticket_cache`.
+    struct resumption_ticket {
+        struct id : public byte_array<16> { };
+        struct secret : public secret_byte_array<32> { };
+
+        id     ticket_id;
+        secret ticket_secret;
+    };
+
+
+    /// A Noise "SymmetricState": the chaining key, handshake hash and current cipher state.
+    /// Used internally by `handshake` and `resumption`.
+    class symmetric_state {
+    public:
+        void initialize(const char *protocol_name);
+        void mix_key(input_bytes input_key_material);
+        void mix_hash(input_bytes data);
+        output_bytes encrypt_and_hash(input_bytes plain_text, output_bytes out);
+        [[nodiscard]] std::optional<output_bytes> decrypt_and_hash(input_bytes cipher_text,
+                                                                   output_bytes out);
+        void split(role, transport&) const;
+        void derive_ticket(resumption_ticket&) const;
+
+        bool has_key() const                            {return _cipher.has_key();}
+        byte_array<hash_size> const& hash() const       {return _h;}
+
+    private:
+        secret_byte_array<hash_size> _ck;       // chaining key
+        byte_array<hash_size>        _h;        // handshake hash
+        cipher_state                 _cipher;
+    };
+
+
+    /// A Noise handshake in progress, using the pattern NK, XX or IK.
+    ///
+    /// Call `write_message` and `read_message` alternately (the initiator writes first) until
+    /// `is_complete` returns true, then call `split` to get the transport cipher states.
+    ///
+    /// The object is a fixed-size value with no heap allocation; the state touched on every
+    /// message (chaining key, hash, cipher key) sits at the start, and the whole thing is
+    /// cache-line aligned, so large arrays of concurrent handshakes stay compact.
+    class alignas(64) handshake {
+    public:
+        struct options {
+            /// Data both parties must agree on, e.g. a protocol version; it's hashed, not sent.
+            input_bytes               prologue {nullptr, 0};
+            /// Our static key pair ("s"). Required by XX, by IK on both sides, and by the
+            /// NK responder.
+            std::optional<secret_key> local_static;
+            /// The peer's static public key ("rs"), if known in advance. Required by the
+            /// NK and IK initiators.
+            std::optional<public_key> remote_static;
+            /// Our ephemeral key ("e"), for reproducing test vectors only. By default a new
+            /// random one is generated. @warning Never set this outside of tests; reusing an
+            /// ephemeral key destroys the handshake's security.
+            std::optional<secret_key> local_ephemeral;
+        };
+
+        /// Initializes a handshake. Throws `std::invalid_argument` if a key required by the
+        /// pattern and role is missing.
+        handshake(pattern, role, options const&);
+
+        pattern get_pattern() const                     {return _pattern;}
+        role    get_role() const                        {return _role;}
+
+        /// True if the next step is `write_message`, false if it's `read_message`.
+        bool is_my_turn() const;
+
+        /// True once all handshake messages have been written/read.
+        bool is_complete() const;
+
+        /// The exact size of the next message `write_message` will produce (or `read_message`
+        /// will expect), given the size of its payload.
+        size_t message_size(size_t payload_size) const;
+
+        /// Writes the next handshake message, with an optional payload, into `out`.
+        /// Returns `out` shrunk to the message size.
+        /// Throws `std::logic_error` if it's not our turn to write.
+        output_bytes write_message(input_bytes payload, output_bytes out);
+
+        /// Reads the peer's next handshake message, writing its payload to `payload_out`.
+        /// Returns `payload_out` shrunk to the payload size, or `{nullptr,0}` if the message is
+        /// malformed or fails authentication (the handshake must then be abandoned.) A valid
+        /// message with an empty payload succeeds even if `payload_out` is `{nullptr,0}`.
+        /// Throws `std::logic_error` if it's not our turn to read.
+        [[nodiscard]]
+        output_bytes read_message(input_bytes message, output_bytes payload_out);
+
+        /// After completion, returns the transport cipher states.
+        transport split() const;
+
+        /// The handshake hash, a unique identifier of this session usable for channel binding.
+        byte_array<hash_size> const& handshake_hash() const {return _ss.hash();}
+
+        /// The peer's static public key, once known (`nullopt` for an NK initiator's peer.)
+        std::optional<public_key> remote_static_key() const;
+
+        /// After completion, returns a ticket for resuming the session later via `resumption`.
+        resumption_ticket get_resumption_ticket() const;
+
+    private:
+        bool mix_dh(uint8_t token);
+
+        symmetric_state _ss;
+        pattern         _pattern;
+        role            _role;
+        uint8_t         _message = 0;           // index of next message in pattern
+        uint8_t         _has = 0;               // bit flags for which keys below are set
+        secret_key      _s, _e;
+        public_key      _s_pub, _e_pub, _rs, _re;
+    };
+
+
+    /// A bounded, thread-safe store of resumption tickets, used by responders.
+    /// Tickets are single-use: `take` removes the ticket it returns. When full, the oldest ticket
+    /// is evicted; tickets older than `lifetime` are never returned.
+    class ticket_cache {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        explicit ticket_cache(size_t capacity = 10000,
+                              clock::duration lifetime = std::chrono::hours(12));
+
+        /// Stores a ticket issued by a completed handshake.
+        void insert(resumption_ticket const&);
+
+        /// Looks up a ticket by ID and removes it from the cache.
+        std::optional<resumption_ticket::secret> take(resumption_ticket::id const&);
+
+        size_t size() const;
+
+    private:
+        struct id_hash {
+            size_t operator() (resumption_ticket::id const& id) const {
+                size_t h;
+                ::memcpy(&h, id.data(), sizeof(h));
+                return h;
+            }
+        };
+        struct entry {
+            resumption_ticket::secret secret;
+            clock::time_point         expires;
+            std::list<resumption_ticket::id>::iterator age;
+        };
+        using map = std::unordered_map<resumption_ticket::id, entry, id_hash>;
+
+        mutable std::mutex               _mutex;
+        map                              _tickets;
+        std::list<resumption_ticket::id> _order;      // oldest first
+        size_t                           _capacity;
+        clock::duration                  _lifetime;
+    };
+
+
+    /// An abbreviated one-round-trip handshake that re-establishes a session from a
+    /// `resumption_ticket`, performing no Diffie-Hellman operations.
+    ///
+    /// Message 1 is `ticket_id || random || payload+MAC`, message 2 is `random || payload+MAC`.
+    /// The resulting session is keyed from the ticket secret plus both parties' fresh randoms.
+    /// A new ticket can be taken from a completed resumption, to chain resumptions.
+    ///
+    /// @warning  A resumed session is not forward-secret with respect to the ticket: anyone who
+    ///     later obtains the ticket secret can decrypt it. Message 1's payload can't be replayed to
+    ///     the same `ticket_cache` (tickets are single-use) but has no other replay protection.
+    /// @note  This is an extension, not a pattern defined by the Noise specification.
+    class resumption {
+    public:
+        static constexpr size_t random_size = 32;
+
+        /// Initiator: resumes with a ticket from an earlier `handshake` or `resumption`.
+        explicit resumption(resumption_ticket const&, input_bytes prologue = {nullptr, 0});
+
+        /// Responder: will look up the initiator's ticket in `cache`.
+        explicit resumption(ticket_cache &cache, input_bytes prologue = {nullptr, 0});
+
+        bool is_my_turn() const;
+        bool is_complete() const                        {return _message >= 2;}
+
+        size_t message_size(size_t payload_size) const;
+
+        output_bytes write_message(input_bytes payload, output_bytes out);
+
+        /// Reads the peer's message, like `handshake::read_message`. Returns `{nullptr,0}` if the
+        /// message is invalid or, on the responder side, if the ticket is unknown or expired --
+        /// in which case the peer should fall back to a full `handshake`.
+        [[nodiscard]]
+        output_bytes read_message(input_bytes message, output_bytes payload_out);
+
+        transport split() const;
+
+        byte_array<hash_size> const& handshake_hash() const {return _ss.hash();}
+
+        resumption_ticket get_resumption_ticket() const;
+
+    private:
+        void start(input_bytes prologue);
+
+        symmetric_state            _ss;
+        role                       _role;
+        uint8_t                    _message = 0;
+        ticket_cache*              _cache = nullptr;
+        resumption_ticket          _ticket;
+    };
+
+}
@@ -0,0 +1,217 @@
+//
+//  monocypher/ext/paseto.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include "ed25519.hh"
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace monocypher::ext {
+
+    //======== BASE64URL
+
+
+    /// The length of the unpadded base64url encoding of `size` bytes.
+    constexpr size_t base64url_encoded_size(size_t size)    {return (size * 4 + 2) / 3;}
+
+    /// The number of bytes encoded by `length` characters of unpadded base64url; a buffer of
+    /// `length` bytes is always big enough.
+    constexpr size_t base64url_decoded_size(size_t length) {
+        return length / 4 * 3 + (length % 4 * 3) / 4;
+    }
+
+    /// Encodes data as base64url (RFC 4648 section 5) without padding.
+    std::string base64url_encode(input_bytes);
+
+    /// Decodes unpadded base64url into `out`, which needs `base64url_decoded_size(in.size())`
+    /// bytes. Returns `out` shrunk to the decoded size, or `{nullptr, 0}` if the input contains
+    /// any other character, has an impossible length, or isn't canonical (nonzero unused bits.)
+    /// (So `out.data` must not be null, even when the input is empty.)
+    /// Long inputs are decoded 32 characters at a time with AVX2 where available.
+    [[nodiscard]]
+    output_bytes base64url_decode(std::string_view in, output_bytes out);
+
+    /// Enables or disables the SIMD base64url decoder, for testing and benchmarking. Returns
+    /// whether it's actually in use, which also depends on the CPU.
+    bool base64url_set_simd(bool enabled);
+
+
+    //======== PASETO
+
+
+    /// PASETO version 4 tokens (<https://github.com/paseto-standard/paseto-spec>): the
+    /// `v4.local` purpose, symmetric authenticated encryption with XChaCha20 and keyed Blake2b,
+    /// and the `v4.public` purpose, Ed25519 signatures.
+    ///
+    /// A token is `v4.<purpose>.<payload>[.<footer>]`, the payload and footer being base64url.
+    /// The footer is authenticated but not encrypted; it typically names the key (`kid`.) An
+    /// "implicit assertion" is authenticated too, but is never part of the token: the
+    /// application supplies the same value when creating and decoding it.
+    ///
+    /// Decoding doesn't copy or allocate: the token is parsed in place, and the message is
+    /// decoded straight into the caller's buffer, which needs no more bytes than the token's
+    /// length. (The `std::string` overloads are conveniences.) Claims inside the message, such as
+    /// `exp`, are up to the application to check.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    namespace paseto {
+
+        /// Returns a token's decoded footer, or nullopt if the token is malformed. The footer is
+        /// **not** authenticated until the token has been decoded successfully; this is for
+        /// choosing the key to decode it with.
+        std::optional<std::string> footer(std::string_view token);
+
+
+        /// Creates and decodes `v4.local` tokens.
+        class local {
+        public:
+            using key = session::encryption_key<XChaCha20_Poly1305>;
+
+            explicit local(key const& k)                    :_key(k) { }
+
+            /// Encrypts `message` into a token, with a random nonce.
+            std::string encrypt(input_bytes message,
+                                std::string_view footer = {},
+                                std::string_view implicit = {}) const;
+
+            /// Encrypts with a given 32-byte nonce. Only for reproducing test vectors: a nonce
+            /// must never be used twice with the same key.
+            std::string encrypt(input_bytes message,
+                                std::string_view footer,
+                                std::string_view implicit,
+                                byte_array<32> const& nonce) const;
+
+            /// Authenticates and decrypts a token into `message`, which needs `token.size()`
+            /// bytes. Returns `message` shrunk to the message size, or `{nullptr, 0}` if the
+            /// token is malformed or not authentic, or the implicit assertion doesn't match.
+            [[nodiscard]]
+            output_bytes decrypt(std::string_view token, output_bytes message,
+                                 std::string_view implicit = {}) const;
+
+            std::optional<std::string> decrypt(std::string_view token,
+                                               std::string_view implicit = {}) const;
+
+        private:
+            key _key;
+        };
+
+
+        /// Creates `v4.public` tokens.
+        class signer {
+        public:
+            explicit signer(key_pair<Ed25519> const& kp)    :_key_pair(kp) { }
+
+            /// Signs `message`, producing a token. (The message is only encoded, not encrypted.)
+            std::string sign(input_bytes message,
+                             std::string_view footer = {},
+                             std::string_view implicit = {}) const;
+
+            public_key<Ed25519> const& get_public_key() const {return _key_pair.get_public_key();}
+
+        private:
+            key_pair<Ed25519> _key_pair;
+        };
+
+
+        /// Verifies `v4.public` tokens, checking signatures under `signature_rules::strict`
+        /// (RFC 8032 with every optional check.) It can keep a bounded cache of digests of
+        /// recently verified tokens, so that a token seen again -- an API client typically sends
+        /// the same one with every request -- is accepted without checking its signature again.
+        /// Entries are evicted oldest first, and expire after `cache_lifetime`.
+        ///
+        /// `verify` is thread-safe.
+        class verifier {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            /// @param cache_capacity  Maximum number of tokens to remember; 0 disables the cache.
+            /// @param cache_lifetime  How long a verified token is remembered. Keep it shorter
+            ///        than the tokens' own lifetimes if they matter to you.
+            explicit verifier(public_key<Ed25519> const&,
+                              size_t cache_capacity = 0,
+                              clock::duration cache_lifetime = std::chrono::minutes(5));
+
+            /// Verifies a token and decodes its message into `message`, which needs
+            /// `token.size()` bytes. Returns `message` shrunk to the message size, or
+            /// `{nullptr, 0}` if the token is malformed or its signature isn't valid, or the
+            /// implicit assertion doesn't match.
+            [[nodiscard]]
+            output_bytes verify(std::string_view token, output_bytes message,
+                                std::string_view implicit = {}) const;
+
+            std::optional<std::string> verify(std::string_view token,
+                                              std::string_view implicit = {}) const;
+
+            /// The number of tokens in the cache.
+            size_t cache_size() const;
+
+            /// The number of `verify` calls that were satisfied by the cache.
+            uint64_t cache_hits() const;
+
+        private:
+            using digest = byte_array<32>;
+            struct digest_hash {
+                size_t operator() (digest const& d) const {
+                    size_t h;
+                    ::memcpy(&h, d.data(), sizeof(h));
+                    return h;
+                }
+            };
+            struct entry {
+                clock::time_point                expires;
+                std::list<digest>::iterator      age;
+            };
+
+            digest token_digest(std::string_view token, std::string_view implicit) const;
+            bool cache_lookup(digest const&) const;
+            void cache_insert(digest const&) const;
+
+            public_key<Ed25519>                                     _key;
+            size_t                                                  _capacity;
+            clock::duration                                         _lifetime;
+            secret_byte_array<32>                                   _cache_key;
+            mutable std::mutex                                      _mutex;
+            mutable std::unordered_map<digest, entry, digest_hash>  _cache;
+            mutable std::list<digest>                               _order;     // oldest first
+            mutable uint64_t                                        _hits = 0;
+        };
+
+    }
+
+}
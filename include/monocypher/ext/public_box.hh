@@ -0,0 +1,123 @@
+//
+//  monocypher/ext/public_box.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include "../key_exchange.hh"
+#include "xsalsa20.hh"
+#include <stdexcept>
+
+namespace monocypher::ext {
+
+    /// Derives a `public_box` symmetric key from an X25519 shared secret; specialized for each
+    /// supported encryption algorithm.
+    template <class Algorithm> struct public_box_key_derivation;
+
+    /// XSalsa20_Poly1305 uses HSalsa20, like NaCl's `crypto_box_beforenm`.
+    template <> struct public_box_key_derivation<XSalsa20_Poly1305> {
+        static void derive(uint8_t key[32], const uint8_t shared_secret[32]) {
+            static constexpr uint8_t zero[16] = {};
+            XSalsa20_Poly1305::hsalsa20(key, shared_secret, zero);
+        }
+    };
+
+    /// XChaCha20_Poly1305 uses HChaCha20, like `X25519_HChaCha20`.
+    template <> struct public_box_key_derivation<XChaCha20_Poly1305> {
+        static void derive(uint8_t key[32], const uint8_t shared_secret[32]) {
+            static constexpr uint8_t zero[16] = {};
+            c::crypto_chacha20_h(key, shared_secret, zero);
+        }
+    };
+
+
+    /// Public-key authenticated encryption between two parties, like NaCl's `crypto_box`.
+    ///
+    /// Constructing a `public_box` is the expensive "precompute" step (`crypto_box_beforenm`):
+    /// an X25519 key agreement between your secret key and the peer's public key, hashed into
+    /// a symmetric key. Keep the object around for the lifetime of the peer relationship; after
+    /// that, each message costs only the symmetric AEAD.
+    ///
+    /// With the default `XSalsa20_Poly1305` algorithm, `box` output is identical to libsodium's
+    /// `crypto_box_easy` (and `crypto_box_easy_afternm`.) The `XChaCha20_Poly1305` variant
+    /// uses Monocypher's AEAD and is not compatible with libsodium.
+    ///
+    /// As with `crypto_box`, both parties derive the same key, so each must avoid reusing the
+    /// other's nonces as well as its own; random nonces (the default) take care of that.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    template <class Algorithm = XSalsa20_Poly1305>
+    class public_box {
+    public:
+        using key_exchange   = monocypher::key_exchange<X25519_Raw>;
+        using public_key     = key_exchange::public_key;
+        using encryption_key = session::encryption_key<Algorithm>;
+        using nonce          = session::nonce;
+
+        /// Precomputes the shared key between your key pair and the peer's public key.
+        /// Throws `std::invalid_argument` if the peer's key is a low-order point, which would
+        /// make the shared key predictable.
+        public_box(key_exchange const& my_key, public_key const& their_key)
+        :_key(derive_key(my_key, their_key))
+        { }
+
+        /// The precomputed symmetric key, for use with the rest of the `encryption_key` API.
+        encryption_key const& key() const                   {return _key;}
+
+        /// Encrypts and authenticates a message. The output buffer must be at least
+        /// `plain_text.size + sizeof(session::mac)` bytes.
+        output_bytes box(nonce const& n, input_bytes plain_text, output_bytes out) const {
+            return _key.box(n, plain_text, out);
+        }
+
+        /// Authenticates and decrypts a message produced by the peer's `box`. Returns
+        /// `{nullptr, 0}` if it's invalid.
+        [[nodiscard]]
+        output_bytes unbox(nonce const& n, input_bytes boxed, output_bytes out) const {
+            return _key.unbox(n, boxed, out);
+        }
+
+    private:
+        static encryption_key derive_key(key_exchange const& my_key, public_key const& their_key) {
+            auto shared = my_key.get_shared_secret(their_key);
+            static constexpr uint8_t zero[32] = {};
+            if (c::crypto_verify32(shared.data(), zero) == 0)
+                throw std::invalid_argument("invalid public key for public_box");
+            secret_byte_array<32> k;
+            public_box_key_derivation<Algorithm>::derive(k.data(), shared.data());
+            return encryption_key(k.data(), k.size());
+        }
+
+        encryption_key _key;
+    };
+
+}
@@ -0,0 +1,85 @@
+//
+//  monocypher/ext/replay_window.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace monocypher::ext {
+
+    /// Anti-replay protection for messages numbered with sequence numbers that may arrive out
+    /// of order, such as datagrams. It remembers which of the most recent `width()` sequence
+    /// numbers have been seen, and rejects duplicates and anything older than that.
+    ///
+    /// The window is a bitmap in a ring of 64-bit slots, each holding 32 bits plus a tag naming
+    /// the block of sequence numbers they belong to. All updates are single-word atomic
+    /// compare-and-swaps, so any number of threads can check and commit concurrently without
+    /// locks; a sequence number is accepted by `commit` at most once.
+    ///
+    /// Use it with `session::encryption_key::unbox(window, seq, ...)`, which only commits a
+    /// sequence number after its message has been authenticated.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class replay_window {
+    public:
+        /// @param width  How many sequence numbers back from the highest one are remembered;
+        ///               rounded up to a multiple of 32.
+        explicit replay_window(size_t width = 1024);
+
+        size_t width() const                    {return (_slot_count - 1) * kBitsPerSlot;}
+
+        /// One more than the highest sequence number committed (0 if none.)
+        uint64_t top() const                    {return _top.load(std::memory_order_acquire);}
+
+        /// Returns true if `seq` has not been committed and is not too old. Does not change
+        /// anything. (A true result may be stale by the time you call `commit`.)
+        bool check(uint64_t seq) const;
+
+        /// Records `seq` as seen. Returns false if it was already seen or is too old.
+        [[nodiscard]] bool commit(uint64_t seq);
+
+    private:
+        static constexpr uint64_t kBitsPerSlot = 32;
+
+        bool too_old(uint64_t seq) const        {return seq + width() < top();}
+        std::atomic<uint64_t>& slot_for(uint64_t block) const {
+            return _slots[block % _slot_count];
+        }
+
+        size_t                                     _slot_count;
+        std::unique_ptr<std::atomic<uint64_t>[]>   _slots;
+        std::atomic<uint64_t>                      _top {0};
+    };
+
+}
@@ -0,0 +1,155 @@
+//
+//  monocypher/ext/sealed_box.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "public_box.hh"
+#include "../hash.hh"
+#include <algorithm>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// Anonymous public-key encryption, like libsodium's `crypto_box_seal`: anyone can encrypt a
+    /// message to a recipient's public key, and only the recipient can decrypt it, but the
+    /// recipient can't tell who sent it.
+    ///
+    /// Each message gets a new ephemeral X25519 key pair. The sealed box is
+    /// `ephemeral public key (32) || mac (16) || ciphertext`, where the rest is a `public_box`
+    /// from the ephemeral key to the recipient, with the nonce
+    /// `Blake2b-192(ephemeral public key || recipient public key)`.
+    /// With the default `XSalsa20_Poly1305` algorithm this is byte-compatible with libsodium's
+    /// `crypto_box_seal` / `crypto_box_seal_open`.
+    ///
+    /// `open` does no heap allocation.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    template <class Algorithm = XSalsa20_Poly1305>
+    struct sealed_box {
+        using key_exchange = monocypher::key_exchange<X25519_Raw>;
+        using public_key   = key_exchange::public_key;
+
+        /// The number of bytes a sealed box is larger than its message.
+        static constexpr size_t overhead = sizeof(public_key) + sizeof(session::mac);
+
+        /// Encrypts `message` for `recipient`. The output buffer must be at least
+        /// `message.size + overhead` bytes. Returns it shrunk to the sealed size.
+        /// Throws `std::invalid_argument` if `recipient` is a low-order point.
+        static output_bytes seal(public_key const& recipient, input_bytes message,
+                                 output_bytes out)
+        {
+            key_exchange ephemeral;
+            return seal_with(ephemeral, recipient, message, out);
+        }
+
+        /// Seals many messages to one recipient: `out[i]` is the sealed box of `messages[i]`.
+        /// The ephemeral secret keys are generated by a single RNG call, and the key agreements
+        /// are spread across `threads` threads (0 means one per CPU core.)
+        /// Throws `std::invalid_argument` if `recipient` is a low-order point.
+        static void seal_many(public_key const& recipient,
+                              const input_bytes messages[],
+                              output_bytes out[],
+                              size_t count,
+                              unsigned threads = 0)
+        {
+            if (count == 0)
+                return;
+            std::vector<typename key_exchange::secret_key> secrets(count);
+            randomize(secrets.data(), count * sizeof(secrets[0]));
+            // 16 messages per job:
+            internal::parallel_for((count + 15) / 16, threads, SIZE_MAX, [&](size_t job) {
+                for (size_t i = 16 * job; i < std::min(16 * job + 16, count); ++i)
+                    out[i] = seal_with(key_exchange(secrets[i]), recipient, messages[i], out[i]);
+            });
+        }
+
+        /// Decrypts a sealed box with the recipient's key pair. The output buffer must be at
+        /// least `sealed.size - overhead` bytes. Returns it shrunk to the message size, or
+        /// `{nullptr, 0}` if the box is invalid.
+        [[nodiscard]]
+        static output_bytes open(key_exchange const& recipient, input_bytes sealed,
+                                 output_bytes out)
+        {
+            return open(recipient, recipient.get_public_key(), sealed, out);
+        }
+
+        /// A faster version of `open` that takes the recipient's public key too, instead of
+        /// recomputing it.
+        [[nodiscard]]
+        static output_bytes open(key_exchange const& recipient, public_key const& recipient_pub,
+                                 input_bytes sealed, output_bytes out)
+        {
+            if (sealed.size < overhead)
+                return {};
+            public_key ephemeral_pub(sealed.data, sizeof(public_key));
+            sealed.consume(sizeof(public_key));
+            static constexpr uint8_t zero[32] = {};
+            auto shared = recipient.get_shared_secret(ephemeral_pub);
+            if (c::crypto_verify32(shared.data(), zero) == 0)
+                return {};
+            return box_key(shared).unbox(nonce_for(ephemeral_pub, recipient_pub), sealed, out);
+        }
+
+    private:
+        static output_bytes seal_with(key_exchange const& ephemeral,
+                                      public_key const& recipient,
+                                      input_bytes message,
+                                      output_bytes out)
+        {
+            assert(out.size >= message.size + overhead);
+            public_key ephemeral_pub = ephemeral.get_public_key();
+            ::memcpy(out.data, ephemeral_pub.data(), sizeof(public_key));
+            auto shared = ephemeral.get_shared_secret(recipient);
+            static constexpr uint8_t zero[32] = {};
+            if (c::crypto_verify32(shared.data(), zero) == 0)
+                throw std::invalid_argument("invalid public key for sealed_box");
+            auto key = box_key(shared);
+            key.box(nonce_for(ephemeral_pub, recipient), message,
+                    {u8(out.data) + sizeof(public_key), out.size - sizeof(public_key)});
+            return out.shrunk_to(message.size + overhead);
+        }
+
+        static session::encryption_key<Algorithm>
+        box_key(typename key_exchange::shared_secret const& shared) {
+            secret_byte_array<32> k;
+            public_box_key_derivation<Algorithm>::derive(k.data(), shared.data());
+            return session::encryption_key<Algorithm>(k.data(), k.size());
+        }
+
+        static session::nonce nonce_for(public_key const& ephemeral_pub,
+                                        public_key const& recipient) {
+            auto h = hash<Blake2b<24>>::builder().update(ephemeral_pub).update(recipient).final();
+            return session::nonce(h);
+        }
+    };
+
+}
@@ -0,0 +1,142 @@
+//
+//  monocypher/ext/secure_channel.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../encryption.hh"
+#include <memory>
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// A TLS-like record layer that encrypts a byte stream over a file descriptor, typically a
+    /// connected TCP or Unix-domain socket. Each direction has its own key, e.g. the two keys
+    /// from a completed `noise::handshake`, or two keys derived from a `key_exchange`.
+    ///
+    /// Each record on the wire is `length (4 bytes LE) || mac (16) || ciphertext`, i.e. a
+    /// length-prefixed `encryption_key::box`. Nonces are implicit record sequence numbers, so
+    /// records can't be dropped, replayed or reordered undetected. After every `rekey_interval`
+    /// records in a direction, both sides replace that direction's key with a one-way hash of it.
+    ///
+    /// Small writes are coalesced: `write` encrypts data straight into the currently open record
+    /// (there is no separate plaintext copy), and a record is sealed only when it reaches
+    /// `max_record_size` or on `flush`. All sealed records are then sent with a single
+    /// scatter-gather `sendmsg`/`writev` call.
+    ///
+    /// The file descriptor must be in blocking mode. I/O errors throw `std::system_error`.
+    /// The class does not own the descriptor and never closes it.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself. It's only available on
+    ///       POSIX platforms.
+    class secure_channel {
+    public:
+        using key = session::encryption_key<XChaCha20_Poly1305>;
+
+        static constexpr size_t header_size = 4 + sizeof(session::mac);
+
+        struct options {
+            size_t   max_record_size   = 16 * 1024; ///< Max plaintext bytes per record
+            size_t   max_queued_records = 16;       ///< Sealed records buffered before sending
+            uint64_t rekey_interval    = 1 << 20;   ///< Records per key; must match the peer's
+        };
+
+        secure_channel(int fd, key const& send_key, key const& receive_key);
+        secure_channel(int fd, key const& send_key, key const& receive_key, options const&);
+        ~secure_channel();
+
+        int fd() const                              {return _fd;}
+
+        /// Writes data. It's buffered (as ciphertext) until a record fills up, so call `flush`
+        /// when you want the peer to see what you've written.
+        void write(input_bytes);
+
+        /// Writes several buffers, as though `write` were called on each.
+        void write(std::initializer_list<input_bytes> buffers) {
+            for (auto &buf : buffers)
+                write(buf);
+        }
+
+        /// Seals the current record, if it's not empty, and sends all buffered records.
+        void flush();
+
+        /// Flushes, then sends an authenticated end-of-stream record and shuts down the write
+        /// side of the socket. The peer's `read` will then return 0 bytes.
+        void close_write();
+
+        /// Reads and decrypts available data into `buffer`, blocking if none is available.
+        /// Returns `buffer` shrunk to the number of bytes read; the size is 0 at the end of the
+        /// stream (after the peer's `close_write`.)
+        /// Returns `{nullptr, 0}` if a record fails authentication or the stream was truncated;
+        /// the channel is then unusable for reading.
+        [[nodiscard]]
+        output_bytes read(output_bytes buffer);
+
+        /// Reads exactly `buffer.size` bytes; returns false on EOF or failure.
+        [[nodiscard]]
+        bool read_exactly(output_bytes buffer);
+
+        uint64_t records_sent() const                   {return _send_seq;}
+        uint64_t records_received() const               {return _recv_seq;}
+
+    private:
+        class record_sealer;
+
+        void begin_record();
+        void seal_record();
+        void send_queued();
+        bool receive_record();
+        static void rekey(key&);
+
+        int                   _fd;
+        options               _options;
+        key                   _send_key, _receive_key;
+        uint64_t              _send_seq = 0, _recv_seq = 0;
+
+        // Send side: a pool of record buffers; the first `_queued` are sealed, and the next one
+        // is open (being written) if `_open` is true.
+        std::unique_ptr<record_sealer>          _sealer;
+        std::vector<std::unique_ptr<uint8_t[]>> _records;
+        std::vector<size_t>                     _record_sizes;
+        size_t                                  _queued = 0;
+        bool                                    _open = false;
+        bool                                    _use_writev = false;
+
+        // Receive side: raw bytes read from the fd; decrypted plaintext is served in place.
+        std::unique_ptr<uint8_t[]> _recv_buf;
+        size_t                     _recv_capacity;
+        size_t                     _recv_len = 0;           // bytes of valid data in buffer
+        size_t                     _plain_pos = 0, _plain_end = 0;  // unread plaintext range
+        size_t                     _record_end = 0;         // end of current record in buffer
+        bool                       _eof = false, _failed = false;
+    };
+
+}
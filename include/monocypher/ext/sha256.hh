@@ -50,6 +50,10 @@ namespace monocypher::ext {
         static void update_fn(context *ctx, const uint8_t *message, size_t  message_size);
         static void final_fn (context *ctx, uint8_t hash[32]);
         static void create_fn(uint8_t hash[32], const uint8_t *message, size_t message_size);
+
+        static constexpr uint8_t checkpoint_id = 2;
+        static void save_fn(const context*, std::vector<uint8_t>&);
+        static void restore_fn(context*, const uint8_t *state, size_t size);
         // (no MAC support, sorry)
     };
 
@@ -51,12 +51,19 @@ namespace monocypher {
         static constexpr auto update_fn = c::crypto_sha512_update;
         static constexpr auto final_fn  = c::crypto_sha512_final;
 
+        static constexpr uint8_t checkpoint_id = 3;
+        static void save_fn(const context*, std::vector<uint8_t>&);
+        static void restore_fn(context*, const uint8_t *state, size_t size);
+
         struct mac {
             using context = c::crypto_sha512_hmac_ctx;
             static constexpr auto create_fn = c::crypto_sha512_hmac;
             static constexpr auto init_fn   = c::crypto_sha512_hmac_init;
             static constexpr auto update_fn = c::crypto_sha512_hmac_update;
             static constexpr auto final_fn  = c::crypto_sha512_hmac_final;
+
+            static void save_fn(const context*, std::vector<uint8_t>&);
+            static void restore_fn(context*, const uint8_t *state, size_t size);
         };
     };
 
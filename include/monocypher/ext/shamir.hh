@@ -0,0 +1,97 @@
+//
+//  monocypher/ext/shamir.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include "../base.hh"
+#include <vector>
+
+namespace monocypher::ext {
+
+    /// Shamir secret sharing over GF(2^8): splits a secret (a key, or a blob of any size) into
+    /// `count` shares, any `threshold` of which can reconstruct it, while fewer reveal nothing.
+    ///
+    /// Arithmetic uses the AES field polynomial (x^8 + x^4 + x^3 + x + 1). Multiplying a whole
+    /// buffer by a field element is done 16 or 32 bytes at a time with `pshufb`-style nibble
+    /// table lookups (AVX2 or SSSE3 on x86, chosen at runtime; NEON on ARM64), with a portable
+    /// bitwise fallback. All of it is constant-time: no branches or memory addresses depend on
+    /// secret data.
+    ///
+    /// Every share of a split carries a random salt and the commitment
+    /// `Blake2b-256(salt || secret)`, which `combine` checks after reconstruction, so wrong or
+    /// corrupted shares are detected rather than silently producing garbage.
+    /// @warning  The commitment would let an attacker holding one share confirm guesses of a
+    ///           low-entropy secret. That's not a concern for keys.
+    ///
+    /// @note This functionality is NOT part of Monocypher itself.
+    class shamir {
+    public:
+        struct share {
+            uint8_t              x = 0;             ///< The share's index (1...255)
+            uint8_t              threshold = 0;     ///< Number of shares needed to combine
+            byte_array<16>       salt;              ///< Random; the same for all shares of a split
+            byte_array<32>       commitment;        ///< Blake2b-256(salt || secret)
+            std::vector<uint8_t> y;                 ///< The share data, the same size as the secret
+
+            share() = default;
+            share(share const&) = default;
+            share(share&&) = default;
+            share& operator=(share const&) = default;
+            share& operator=(share&&) = default;
+            ~share()                                {wipe(y.data(), y.size());}
+
+            /// Serializes the share: version, x, threshold, salt, commitment, y, then a 16-byte
+            /// Blake2b checksum of all that.
+            std::vector<uint8_t> to_bytes() const;
+
+            /// Parses a serialized share; returns false if it's malformed or its checksum is bad.
+            [[nodiscard]] bool from_bytes(input_bytes);
+        };
+
+        /// Splits `secret` into `count` shares, any `threshold` of which can recover it.
+        /// Requires 1 <= threshold <= count <= 255; otherwise throws `std::invalid_argument`.
+        static std::vector<share> split(input_bytes secret, unsigned threshold, unsigned count);
+
+        /// Reconstructs the secret from at least `threshold` shares, writing it to `secret_out`,
+        /// which must be exactly the secret's size. Returns false if there aren't enough
+        /// distinct shares, they don't belong to the same split, or the result doesn't match
+        /// the commitment.
+        [[nodiscard]]
+        static bool combine(const share shares[], size_t count, output_bytes secret_out);
+
+        [[nodiscard]]
+        static bool combine(std::vector<share> const& shares, output_bytes secret_out) {
+            return combine(shares.data(), shares.size(), secret_out);
+        }
+    };
+
+}
@@ -65,6 +65,10 @@ namespace monocypher::ext {
                           const uint8_t nonce[24],
                           const uint8_t *ad, size_t ad_size,
                           const uint8_t *cipher_text, size_t text_size);
+
+        /// The HSalsa20 function, which derives a subkey from a key and a 16-byte input.
+        /// (NaCl's `crypto_box_beforenm` applies this to an X25519 shared secret.)
+        static void hsalsa20(uint8_t out[32], const uint8_t key[32], const uint8_t in[16]);
     };
 
 }
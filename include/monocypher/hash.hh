@@ -33,10 +33,84 @@
 
 #pragma once
 #include "base.hh"
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace monocypher {
     using namespace MONOCYPHER_CPP_NAMESPACE;
 
+    namespace internal {
+        // True if a hash algorithm has a `create_many_fn`, i.e. a multi-buffer implementation.
+        template <class Alg, class = void>
+        struct has_create_many : std::false_type { };
+        template <class Alg>
+        struct has_create_many<Alg, std::void_t<decltype(Alg::create_many_fn)>> : std::true_type { };
+
+        // Little-endian encoding of hash-builder state, for checkpoints.
+        struct state_writer {
+            std::vector<uint8_t> &out;
+
+            void u8(uint8_t b)                  {out.push_back(b);}
+            void u32(uint32_t w)                {for (int i = 0; i < 4; ++i) out.push_back(uint8_t(w >> (8 * i)));}
+            void u64(uint64_t w)                {for (int i = 0; i < 8; ++i) out.push_back(uint8_t(w >> (8 * i)));}
+            void bytes(const void *p, size_t n) {auto b = static_cast<const uint8_t*>(p);
+                                                 out.insert(out.end(), b, b + n);}
+        };
+
+        // Decodes what a `state_writer` wrote; throws `std::invalid_argument` if it runs out.
+        struct state_reader {
+            const uint8_t *pos, *end;
+
+            const uint8_t* take(size_t n) {
+                if (n > size_t(end - pos))
+                    throw std::invalid_argument("truncated hash checkpoint");
+                auto p = pos;
+                pos += n;
+                return p;
+            }
+            uint8_t u8()                        {return *take(1);}
+            uint32_t u32()                      {auto p = take(4); uint32_t w = 0;
+                                                 for (int i = 3; i >= 0; --i) w = (w << 8) | p[i];
+                                                 return w;}
+            uint64_t u64()                      {auto p = take(8); uint64_t w = 0;
+                                                 for (int i = 7; i >= 0; --i) w = (w << 8) | p[i];
+                                                 return w;}
+            void bytes(void *dst, size_t n)     {::memcpy(dst, take(n), n);}
+            void check(bool ok) const {
+                if (!ok)
+                    throw std::invalid_argument("invalid hash checkpoint");
+            }
+            void finish() const                 {check(pos == end);}
+        };
+    }
+
+    /// Wraps a hash builder's serialized state in a checkpoint: a versioned header, then either
+    /// the state plus a checksum or, if `key` is non-null, the state encrypted with
+    /// XChaCha20-Poly1305. Used by `hash::builder::checkpoint` and `hash::mac_builder::checkpoint`.
+    std::vector<uint8_t> seal_hash_checkpoint(uint8_t algorithm_id, size_t hash_size,
+                                              const std::vector<uint8_t> &state,
+                                              const uint8_t *key);
+
+    /// Verifies (and if `key` is non-null, decrypts) a checkpoint made by `seal_hash_checkpoint`,
+    /// returning the serialized state. Throws `std::invalid_argument` if the checkpoint is
+    /// corrupt, was made by a different algorithm or hash size, or the key is wrong.
+    std::vector<uint8_t> open_hash_checkpoint(uint8_t algorithm_id, size_t hash_size,
+                                              input_bytes checkpoint,
+                                              const uint8_t *key);
+
+    /// The scheduler behind `hash::create_batch`. Orders the messages largest first, groups the
+    /// small ones into jobs of up to `hash_batch_group` similar-size messages, and runs the jobs
+    /// on `threads` threads (0 means one per CPU core) -- fewer if there's too little data to be
+    /// worth it. Each job calls `fn(indices, messages, n)`, where `messages[i]` is the caller's
+    /// `messages[indices[i]]`.
+    using hash_batch_fn = std::function<void(const size_t indices[], const input_bytes messages[],
+                                             size_t n)>;
+    void schedule_hash_batch(const input_bytes messages[], size_t count, unsigned threads,
+                             hash_batch_fn const& fn);
+    static constexpr size_t hash_batch_group = 64;
+
     /// Cryptographic hash class, templated by algorithm and size.
     /// The `Size` is in bytes and must be between 1 and 64.
     ///
@@ -82,6 +156,56 @@ namespace monocypher {
             return createMAC(message.data, message.size, key);
         }
 
+        /// Hashes `count` independent messages, storing the hash of `messages[i]` in `out[i]`.
+        /// The results are identical to calling `create` on each message, but algorithms with a
+        /// multi-buffer implementation (currently Blake2b) hash several messages at once in
+        /// parallel SIMD lanes, which is much faster for large numbers of small messages.
+        static void create_many(const input_bytes messages[], size_t count, hash out[]) noexcept {
+            if constexpr (internal::has_create_many<HashAlgorithm>::value) {
+                static_assert(sizeof(hash) == Size);
+                HashAlgorithm::create_many_fn(out[0].data(), messages, count);
+            } else {
+                for (size_t i = 0; i < count; ++i)
+                    out[i] = create(messages[i]);
+            }
+        }
+
+        /// Computes the MACs of `count` independent messages with the same key, storing the MAC
+        /// of `messages[i]` in `out[i]`. Equivalent to calling `createMAC` on each message, but
+        /// faster for algorithms with a multi-buffer implementation, as with `create_many`.
+        template <size_t KeySize>
+        static void createMAC_many(const input_bytes messages[], size_t count,
+                                   const byte_array<KeySize> &key, hash out[]) noexcept {
+            if constexpr (internal::has_create_many<typename HashAlgorithm::mac>::value) {
+                static_assert(sizeof(hash) == Size);
+                HashAlgorithm::mac::create_many_fn(out[0].data(), key.data(), key.size(),
+                                                   messages, count);
+            } else {
+                for (size_t i = 0; i < count; ++i)
+                    out[i] = createMAC(messages[i], key);
+            }
+        }
+
+        /// Hashes `count` independent messages on multiple threads, storing the hash of
+        /// `messages[i]` in `out[i]`. Meant for many inputs of very different sizes, like the
+        /// files in a directory tree: the largest are started first so no thread is left
+        /// finishing a big one at the end, while small ones are hashed in groups (with
+        /// `create_many`.) `threads` is the maximum thread count; 0 means one per CPU core.
+        static void create_batch(const input_bytes messages[], size_t count, hash out[],
+                                 unsigned threads = 0) {
+            schedule_hash_batch(messages, count, threads,
+                                [&](const size_t indices[], const input_bytes group[], size_t n) {
+                if (n == 1) {
+                    out[indices[0]] = create(group[0]);
+                } else {
+                    hash results[hash_batch_group];
+                    create_many(group, n, results);
+                    for (size_t i = 0; i < n; ++i)
+                        out[indices[i]] = results[i];
+                }
+            });
+        }
+
 
         template <class BuilderAlg>
         class _builder {
@@ -117,6 +241,30 @@ namespace monocypher {
             builder() {
                 HashAlgorithm::init_fn(&this->_ctx);
             }
+
+            /// Returns a snapshot of the builder's state, so a long-running hash can be resumed
+            /// later with `restore` -- in another process, or on another machine -- after
+            /// feeding it the rest of the data from where this left off. The format is versioned,
+            /// portable and checksummed.
+            /// Supported by Blake2b, SHA-256, SHA-512 and BLAKE3.
+            std::vector<uint8_t> checkpoint() const {
+                std::vector<uint8_t> state;
+                HashAlgorithm::save_fn(&this->_ctx, state);
+                auto result = seal_hash_checkpoint(HashAlgorithm::checkpoint_id, Size, state, nullptr);
+                wipe(state.data(), state.size());
+                return result;
+            }
+
+            /// Recreates a builder from a `checkpoint`.
+            /// Throws `std::invalid_argument` if the checkpoint is corrupt, or was made by a
+            /// different algorithm, hash size, or by a `mac_builder`.
+            static builder restore(input_bytes checkpoint) {
+                auto state = open_hash_checkpoint(HashAlgorithm::checkpoint_id, Size, checkpoint,
+                                                  nullptr);
+                builder b;
+                HashAlgorithm::restore_fn(&b._ctx, state.data(), state.size());
+                return b;
+            }
         };
 
         /// Incrementally constructs a MAC.
@@ -129,10 +277,66 @@ namespace monocypher {
             mac_builder(const byte_array<KeySize> &key) {
                 HashAlgorithm::mac::init_fn(&this->_ctx, key.data(), key.size());
             }
+
+            /// Returns a snapshot of the builder's state, like `builder::checkpoint`. Since a MAC
+            /// builder's state is as sensitive as its key, the snapshot is encrypted (with
+            /// XChaCha20-Poly1305) using `checkpoint_key`, which can be a `session::key`.
+            std::vector<uint8_t> checkpoint(const secret_byte_array<32> &checkpoint_key) const {
+                std::vector<uint8_t> state;
+                HashAlgorithm::mac::save_fn(&this->_ctx, state);
+                auto result = seal_hash_checkpoint(HashAlgorithm::checkpoint_id, Size, state,
+                                                   checkpoint_key.data());
+                wipe(state.data(), state.size());
+                return result;
+            }
+
+            /// Recreates a MAC builder from an encrypted `checkpoint`.
+            /// Throws `std::invalid_argument` if the checkpoint is corrupt, was made by a
+            /// different algorithm or hash size, or `checkpoint_key` is wrong.
+            static mac_builder restore(input_bytes checkpoint,
+                                       const secret_byte_array<32> &checkpoint_key) {
+                auto state = open_hash_checkpoint(HashAlgorithm::checkpoint_id, Size, checkpoint,
+                                                  checkpoint_key.data());
+                mac_builder b;
+                try {
+                    HashAlgorithm::mac::restore_fn(&b._ctx, state.data(), state.size());
+                } catch (...) {
+                    wipe(state.data(), state.size());
+                    throw;
+                }
+                wipe(state.data(), state.size());
+                return b;
+            }
+
+        private:
+            mac_builder() = default;
         };
     };
 
 
+    /// Multi-buffer Blake2b, the implementation of `hash<Blake2b<N>>::create_many`: hashes
+    /// `count` messages, optionally with a key, writing the `hash_size`-byte results
+    /// consecutively to `hashes`. Uses 8 lanes with AVX-512, 4 with AVX2.
+    void blake2b_many(uint8_t *hashes, size_t hash_size, const uint8_t *key, size_t key_size,
+                      const input_bytes *messages, size_t count);
+
+    /// Limits the number of SIMD lanes `blake2b_many` uses to `max_lanes` (8, 4 or 1), for
+    /// testing and benchmarking. Returns the number actually used, which also depends on the CPU.
+    unsigned blake2b_many_set_lanes(unsigned max_lanes);
+
+    /// Blake2b of a message of at most 128 bytes, optionally keyed: one or two fully unrolled
+    /// compressions, with none of the incremental API's buffering. `param0` is the first word of
+    /// the initial state: the IV XORed with the parameter block's first word.
+    void blake2b_short(uint8_t *hash, size_t hash_size, uint64_t param0,
+                       const uint8_t *key, size_t key_size,
+                       const uint8_t *message, size_t message_size);
+
+
+    /// Serializes / deserializes a Blake2b context (keyed or not) for checkpoints.
+    void blake2b_save_state(const c::crypto_blake2b_ctx*, std::vector<uint8_t>&);
+    void blake2b_restore_state(c::crypto_blake2b_ctx*, const uint8_t *state, size_t size);
+
+
     /// Blake2b algorithm; use as `<HashAlgorithm>` in the `hash` template.
     template <size_t Size>
     struct Blake2b {
@@ -141,8 +345,17 @@ namespace monocypher {
 
         using context = c::crypto_blake2b_ctx;
 
+        /// Initial state word 0: the IV XORed with digest size, key size 0, fanout 1, depth 1.
+        static constexpr uint64_t param0 = 0x6a09e667f3bcc908 ^ 0x01010000 ^ Size;
+
+        /// Largest message handled by `blake2b_short`.
+        static constexpr size_t short_size = 128;
+
         static void create_fn(uint8_t *hash, const uint8_t *message, size_t message_size) {
-            c::crypto_blake2b(hash, hash_size, message, message_size);
+            if (message_size <= short_size)
+                blake2b_short(hash, hash_size, param0, nullptr, 0, message, message_size);
+            else
+                c::crypto_blake2b(hash, hash_size, message, message_size);
         }
         static void init_fn(context *ctx) {
             c::crypto_blake2b_init(ctx, hash_size);
@@ -150,19 +363,40 @@ namespace monocypher {
         static constexpr auto update_fn     = c::crypto_blake2b_update;
         static constexpr auto final_fn      = c::crypto_blake2b_final;
 
+        static void create_many_fn(uint8_t *hashes, const input_bytes *messages, size_t count) {
+            blake2b_many(hashes, hash_size, nullptr, 0, messages, count);
+        }
+
+        static constexpr uint8_t checkpoint_id  = 1;
+        static constexpr auto save_fn           = blake2b_save_state;
+        static constexpr auto restore_fn        = blake2b_restore_state;
+
         struct mac {
             using context = c::crypto_blake2b_ctx;
 
             static void create_fn(uint8_t *hash, const uint8_t *key, size_t key_size,
                                   const uint8_t *message, size_t message_size)
             {
-                c::crypto_blake2b_keyed(hash, hash_size, key, key_size, message, message_size);
+                if (message_size <= short_size && key_size <= 64)
+                    blake2b_short(hash, hash_size, param0 ^ (key_size << 8),
+                                  key, key_size, message, message_size);
+                else
+                    c::crypto_blake2b_keyed(hash, hash_size, key, key_size, message, message_size);
             }
             static void init_fn(context *ctx, const uint8_t *key, size_t key_size) {
                 c::crypto_blake2b_keyed_init(ctx, hash_size, key, key_size);
             }
             static constexpr auto update_fn     = c::crypto_blake2b_update;
             static constexpr auto final_fn      = c::crypto_blake2b_final;
+
+            static void create_many_fn(uint8_t *hashes, const uint8_t *key, size_t key_size,
+                                       const input_bytes *messages, size_t count)
+            {
+                blake2b_many(hashes, hash_size, key, key_size, messages, count);
+            }
+
+            static constexpr auto save_fn       = blake2b_save_state;
+            static constexpr auto restore_fn    = blake2b_restore_state;
         };
     };
 
@@ -33,6 +33,7 @@
 
 #pragma once
 #include "base.hh"
+#include "hash.hh"
 #include "key_exchange.hh"
 
 namespace monocypher {
@@ -41,6 +42,46 @@ namespace monocypher {
     struct EdDSA;
 
 
+    /// Rules for deciding which signatures are valid; an optional parameter to `public_key::check`.
+    /// All of these accept every signature made by an honest signer. They only disagree on
+    /// maliciously crafted edge cases (small-order or mixed-order points, non-canonical encodings),
+    /// which matters when several independent verifiers have to reach the same verdict, as in a
+    /// consensus protocol.
+    enum class signature_rules {
+        /// Whatever `crypto_eddsa_check` / `crypto_ed25519_check` does. The default.
+        monocypher,
+        /// RFC 8032 with every optional check turned on: S must be less than L, A and R must be
+        /// canonically encoded and not of small order, and the cofactorless equation
+        /// `[S]B = R + [k]A` must hold.
+        strict,
+        /// ZIP-215: S must be less than L, but A and R may be any encoding of a curve point,
+        /// and the cofactored equation `[8][S]B = [8]R + [8][k]A` is used. These are the only
+        /// rules under which single and batch verification always agree (see `ext::signature_batch`.)
+        zip215,
+    };
+
+    /// Checks a signature `sig` by public key `A` against the challenge `k = H(R || A || M) mod L`,
+    /// according to `rules` (which must not be `monocypher`.) Used by `public_key::check`.
+    [[nodiscard]]
+    bool check_signature_equation(signature_rules rules,
+                                  const uint8_t sig[64], const uint8_t A[32], const uint8_t k[32]);
+
+    /// Converts `count` consecutive 32-byte EdDSA/Ed25519 public keys to X25519 public keys, with
+    /// the same results as `crypto_eddsa_to_x25519`, sharing one field inversion across each
+    /// group of keys (Montgomery's trick) and spreading the groups across `threads` threads (0
+    /// means one per CPU core.) Used by `public_key::for_key_exchange_many`.
+    void eddsa_to_x25519_many(uint8_t *x25519, const uint8_t *eddsa, size_t count,
+                              unsigned threads);
+
+    /// The same as Monocypher's `crypto_eddsa_key_pair` and `crypto_eddsa_sign` -- which they
+    /// call, unless the library is built with the CMake option `MONOCYPHER_WIDE_COMB`. Then they
+    /// do their fixed-base scalar multiplication with a larger table generated at build time,
+    /// trading 30KB of read-only data for speed. The results are identical either way.
+    void eddsa_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]);
+    void eddsa_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                    const uint8_t *message, size_t message_size);
+
+
     /// A digital signature. (For <Algorithm> use <EdDSA> or <Ed25519>.)
     template <class Algorithm = EdDSA>
     struct signature : public byte_array<64> {
@@ -69,6 +110,16 @@ namespace monocypher {
             return check(sig, msg.data, msg.size);
         }
 
+        /// Verifies a signature according to an explicit set of rules.
+        [[nodiscard]]
+        bool check(const signature<Algorithm> &sig, input_bytes msg, signature_rules rules) const {
+            if (rules == signature_rules::monocypher)
+                return check(sig, msg);
+            uint8_t k[32];
+            Algorithm::challenge_fn(k, sig.data(), this->data(), msg.data, msg.size);
+            return check_signature_equation(rules, sig.data(), this->data(), k);
+        }
+
         /// Converts a public signature-verification key to a Curve25519 public key,
         /// for key exchange or encryption.
         /// @warning "It is generally considered poor form to reuse the same key for different
@@ -81,6 +132,20 @@ namespace monocypher {
             Algorithm::public_to_kx_fn(pk.data(), this->data());
             return pk;
         }
+
+        /// Converts `count` public keys at once, storing the result for `keys[i]` in `out[i]`.
+        /// Equivalent to calling `for_key_exchange` on each, but several times faster for
+        /// large batches: the costly field inversions are shared across the batch, and the
+        /// work is spread across `threads` threads (0 means one per CPU core.)
+        template <class KXAlg>
+        static void for_key_exchange_many(const public_key keys[], size_t count,
+                                          typename key_exchange<KXAlg>::public_key out[],
+                                          unsigned threads = 0) {
+            static_assert(sizeof(keys[0]) == 32 && sizeof(out[0]) == 32);
+            Algorithm::public_to_kx_many_fn(reinterpret_cast<uint8_t*>(out),
+                                            reinterpret_cast<const uint8_t*>(keys),
+                                            count, threads);
+        }
     };
 
 
@@ -214,18 +279,32 @@ namespace monocypher {
     ///        An `Ed25519` struct is declared in `Monocypher-ed25519.hh`.
     struct EdDSA {
         static constexpr const char* name      = "EdDSA";
-        static constexpr auto generate_fn      = c::crypto_eddsa_key_pair;
+        static constexpr auto generate_fn      = eddsa_key_pair;
         static constexpr auto check_fn         = c::crypto_eddsa_check;
-        static constexpr auto sign_fn          = c::crypto_eddsa_sign;
+        static constexpr auto sign_fn          = eddsa_sign;
         static constexpr auto public_to_kx_fn  = c::crypto_eddsa_to_x25519;
+        static constexpr auto public_to_kx_many_fn = eddsa_to_x25519_many;
 
         static void private_to_kx_fn(uint8_t x25519[32], const uint8_t eddsa[32]) {
             // Adapted from Monocypher 3's crypto_from_eddsa_private()
             secret_byte_array<64> a;
-            c::crypto_blake2b(a.data(), 64, eddsa, 32);
+            Blake2b<64>::create_fn(a.data(), eddsa, 32);
             ::memcpy(x25519, a.data(), 32);
         }
 
+        /// Computes the verification challenge `k = Blake2b(R || A || M) mod L`.
+        static void challenge_fn(uint8_t k[32], const uint8_t R[32], const uint8_t A[32],
+                                 const uint8_t *msg, size_t msg_size) {
+            c::crypto_blake2b_ctx ctx;
+            uint8_t h[64];
+            c::crypto_blake2b_init(&ctx, 64);
+            c::crypto_blake2b_update(&ctx, R, 32);
+            c::crypto_blake2b_update(&ctx, A, 32);
+            c::crypto_blake2b_update(&ctx, msg, msg_size);
+            c::crypto_blake2b_final(&ctx, h);
+            c::crypto_eddsa_reduce(k, h);
+        }
+
         // Convenient type aliases for those who don't like angle brackets
         using signature   = monocypher::signature<EdDSA>;
         using public_key  = monocypher::public_key<EdDSA>;
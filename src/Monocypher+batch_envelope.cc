@@ -0,0 +1,201 @@
+//
+//  monocypher/Monocypher+batch_envelope.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/batch_envelope.hh"
+#include <stdexcept>
+
+namespace monocypher::ext {
+    using namespace std;
+
+    static constexpr size_t kHeaderSize = sizeof(session::nonce) + sizeof(session::mac);
+
+
+    static size_t varint_size(size_t n) {
+        size_t size = 1;
+        for (; n >= 0x80; n >>= 7)
+            ++size;
+        return size;
+    }
+
+    static void append_varint(vector<uint8_t> &out, size_t n) {
+        for (; n >= 0x80; n >>= 7)
+            out.push_back(uint8_t(n | 0x80));
+        out.push_back(uint8_t(n));
+    }
+
+    // Reads a varint of at most 4 bytes (28 bits); returns false if it's malformed.
+    static bool read_varint(const uint8_t* &in, const uint8_t *end, size_t &n) {
+        n = 0;
+        for (unsigned shift = 0; in < end && shift < 28; shift += 7) {
+            uint8_t b = *in++;
+            n |= size_t(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+
+    //======== WRITER
+
+
+    batch_envelope::writer::writer(key const& k, flush_fn fn)
+    :writer(k, options{}, move(fn))
+    { }
+
+
+    batch_envelope::writer::writer(key const& k, options const& opts, flush_fn fn)
+    :_key(k)
+    ,_options(opts)
+    ,_flush(move(fn))
+    {
+        if (_options.max_size <= overhead || _options.max_size > (1u << 28) || _options.max_records == 0)
+            throw invalid_argument("invalid batch_envelope options");
+        _buffer.reserve(_options.max_size);
+        _buffer.resize(kHeaderSize);
+    }
+
+
+    batch_envelope::writer::~writer() {
+        c::crypto_wipe(_buffer.data(), _buffer.size());
+    }
+
+
+    void batch_envelope::writer::add(input_bytes record) {
+        size_t added = record.size + varint_size(record.size);
+        if (overhead + added > _options.max_size)
+            throw invalid_argument("record too large for batch_envelope");
+        if (pending_size() + added > _options.max_size || _count >= _options.max_records)
+            flush();
+        if (_count == 0)
+            _first_time = clock::now();
+        _buffer.insert(_buffer.end(), record.data, record.data + record.size);
+        append_varint(_index, record.size);
+        ++_count;
+        flush_if_due();
+    }
+
+
+    bool batch_envelope::writer::flush_if_due(clock::time_point now) {
+        if (_count == 0 || now - _first_time < _options.max_delay)
+            return false;
+        flush();
+        return true;
+    }
+
+
+    void batch_envelope::writer::flush() {
+        if (_count == 0)
+            return;
+        // Append the index and its size, then encrypt everything after the header in place:
+        size_t index_size = _index.size();
+        _buffer.insert(_buffer.end(), _index.begin(), _index.end());
+        for (int i = 0; i < 4; ++i)
+            _buffer.push_back(uint8_t(index_size >> (8 * i)));
+
+        session::nonce nonce;
+        uint8_t *text = &_buffer[kHeaderSize];
+        session::mac mac = _key.lock(nonce, {text, _buffer.size() - kHeaderSize}, text);
+        ::memcpy(&_buffer[0], nonce.data(), sizeof(nonce));
+        ::memcpy(&_buffer[sizeof(nonce)], mac.data(), sizeof(mac));
+
+        _flush(input_bytes{_buffer.data(), _buffer.size()});
+
+        _buffer.resize(kHeaderSize);
+        _index.clear();
+        _count = 0;
+    }
+
+
+    //======== READER
+
+
+    optional<batch_envelope::records> batch_envelope::open(key const& k, output_bytes envelope) {
+        if (envelope.size < overhead)
+            return nullopt;
+        auto data = u8(envelope.data);
+        session::nonce nonce(*reinterpret_cast<const array<uint8_t,24>*>(data));
+        session::mac mac;
+        mac.fillWith(data + sizeof(nonce), sizeof(mac));
+        uint8_t *text = data + kHeaderSize;
+        size_t text_size = envelope.size - kHeaderSize;
+        if (!k.unlock(nonce, mac, {text, text_size}, text))
+            return nullopt;
+
+        // Validate the index, so that iteration can trust it:
+        const uint8_t *text_end = text + text_size - 4;
+        size_t index_size = text_end[0] | (text_end[1] << 8) | (size_t(text_end[2]) << 16)
+                          | (size_t(text_end[3]) << 24);
+        if (index_size > text_size - 4)
+            return nullopt;
+        const uint8_t *index = text_end - index_size, *in = index;
+        size_t total = 0, count = 0;
+        while (in < text_end) {
+            size_t len;
+            if (!read_varint(in, text_end, len))
+                return nullopt;
+            total += len;
+            ++count;
+        }
+        if (total != size_t(index - text))
+            return nullopt;
+        return records(text, index, text_end, count);
+    }
+
+
+    batch_envelope::records::iterator::iterator(const uint8_t *record,
+                                                const uint8_t *index, const uint8_t *index_end)
+    :_record(record)
+    ,_index(index)
+    ,_index_end(index_end)
+    {
+        read_entry();
+    }
+
+
+    void batch_envelope::records::iterator::read_entry() {
+        if (_index < _index_end) {
+            _next = _index;
+            read_varint(_next, _index_end, _size);
+        }
+    }
+
+
+    batch_envelope::records::iterator& batch_envelope::records::iterator::operator++ () {
+        _record += _size;
+        _index = _next;
+        read_entry();
+        return *this;
+    }
+
+}
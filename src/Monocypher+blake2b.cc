@@ -0,0 +1,498 @@
+//
+//  Monocypher+blake2b.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/hash.hh"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#   define BLAKE2B_X86 1
+#   include <immintrin.h>
+#endif
+
+// Multi-buffer Blake2b: hashes up to 8 independent messages at once, one per 64-bit SIMD lane.
+// This is the same compression function as Monocypher's, just applied "vertically": vector
+// element `l` of every state word belongs to message `l`.
+
+namespace monocypher {
+    using namespace std;
+
+
+    //======== BLAKE2B CONSTANTS & SCALAR COMPRESSION
+
+
+    static constexpr uint64_t kIV[8] = {
+        0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+        0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+
+    static constexpr uint8_t kSigma[12][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},
+        {14,10, 4, 8, 9,15,13, 6, 1,12, 0, 2,11, 7, 5, 3},
+        {11, 8,12, 0, 5, 2,15,13,10,14, 3, 6, 7, 1, 9, 4},
+        { 7, 9, 3, 1,13,12,11,14, 2, 6, 5,10, 4, 0,15, 8},
+        { 9, 0, 5, 7, 2, 4,10,15,14, 1,11,12, 6, 8, 3,13},
+        { 2,12, 6,10, 0,11, 8, 3, 4,13, 7, 5,15,14, 1, 9},
+        {12, 5, 1,15,14,13, 4,10, 0, 7, 6, 3, 9, 2, 8,11},
+        {13,11, 7,14,12, 1, 3, 9, 5, 0,15, 4, 8, 6, 2,10},
+        { 6,15,14, 9,11, 3, 0, 8,12, 2,13, 7, 1, 4,10, 5},
+        {10, 2, 8, 4, 7, 6, 1, 5,15,11, 9,14, 3,12,13, 0},
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},
+        {14,10, 4, 8, 9,15,13, 6, 1,12, 0, 2,11, 7, 5, 3}};
+
+    static constexpr size_t kBlockSize = 128;
+    static constexpr unsigned kMaxLanes = 8;
+
+    static inline uint64_t load64_le(const uint8_t *p) {
+        uint64_t w = 0;
+        for (int i = 7; i >= 0; --i)
+            w = (w << 8) | p[i];
+        return w;
+    }
+
+    static inline void store64_le(uint8_t *p, uint64_t w) {
+        for (int i = 0; i < 8; ++i)
+            p[i] = uint8_t(w >> (8 * i));
+    }
+
+    static inline uint64_t ror64(uint64_t x, int n)  {return (x >> n) | (x << (64 - n));}
+
+
+    // The states of up to 8 Blake2b computations, laid out so that word `i` of all lanes is
+    // contiguous and can be loaded as one vector.
+    struct alignas(64) blake2b_lanes {
+        uint64_t h[8][kMaxLanes];       // chaining values
+        uint64_t m[16][kMaxLanes];      // the current message block
+        uint64_t t[kMaxLanes];          // byte counter, including the current block
+        uint64_t f[kMaxLanes];          // ~0 if the current block is the last one
+    };
+
+
+    // One round of the compression function. The round number is a template parameter so that
+    // the message schedule is resolved at compile time and the message words can stay in
+    // registers.
+    template <size_t R>
+    static inline void blake2b_round(uint64_t v[16], const uint64_t m[16]) {
+        constexpr const uint8_t *sg = kSigma[R];
+#define G(a, b, c, d, x, y) \
+        v[a] += v[b] + (x);  v[d] = ror64(v[d] ^ v[a], 32); \
+        v[c] += v[d];        v[b] = ror64(v[b] ^ v[c], 24); \
+        v[a] += v[b] + (y);  v[d] = ror64(v[d] ^ v[a], 16); \
+        v[c] += v[d];        v[b] = ror64(v[b] ^ v[c], 63);
+        G(0, 4,  8, 12, m[sg[ 0]], m[sg[ 1]]);
+        G(1, 5,  9, 13, m[sg[ 2]], m[sg[ 3]]);
+        G(2, 6, 10, 14, m[sg[ 4]], m[sg[ 5]]);
+        G(3, 7, 11, 15, m[sg[ 6]], m[sg[ 7]]);
+        G(0, 5, 10, 15, m[sg[ 8]], m[sg[ 9]]);
+        G(1, 6, 11, 12, m[sg[10]], m[sg[11]]);
+        G(2, 7,  8, 13, m[sg[12]], m[sg[13]]);
+        G(3, 4,  9, 14, m[sg[14]], m[sg[15]]);
+#undef G
+    }
+
+    template <size_t... R>
+    static inline void blake2b_rounds(uint64_t v[16], const uint64_t m[16], index_sequence<R...>) {
+        (blake2b_round<R>(v, m), ...);
+    }
+
+    // The fully unrolled compression function.
+    static inline void blake2b_compress(uint64_t h[8], const uint64_t m[16], uint64_t t, bool last) {
+        uint64_t v[16];
+        for (int i = 0; i < 8; ++i) {
+            v[i] = h[i];
+            v[i + 8] = kIV[i];
+        }
+        v[12] ^= t;
+        if (last)
+            v[14] = ~v[14];
+        blake2b_rounds(v, m, make_index_sequence<12>());
+        for (int i = 0; i < 8; ++i)
+            h[i] ^= v[i] ^ v[i + 8];
+    }
+
+    // Compresses the current block of a single lane.
+    static void compress_lane(blake2b_lanes &s, unsigned l) {
+        uint64_t h[8], m[16];
+        for (int i = 0; i < 8; ++i)
+            h[i] = s.h[i][l];
+        for (int i = 0; i < 16; ++i)
+            m[i] = s.m[i][l];
+        blake2b_compress(h, m, s.t[l], s.f[l] != 0);
+        for (int i = 0; i < 8; ++i)
+            s.h[i][l] = h[i];
+    }
+
+
+    //======== SIMD COMPRESSION
+
+
+#ifdef BLAKE2B_X86
+
+    __attribute__((target("avx2")))
+    static inline __m256i ror32_avx2(__m256i x) {
+        return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i ror24_avx2(__m256i x) {
+        const __m256i rot = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                             3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+        return _mm256_shuffle_epi8(x, rot);
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i ror16_avx2(__m256i x) {
+        const __m256i rot = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                             2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+        return _mm256_shuffle_epi8(x, rot);
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i ror63_avx2(__m256i x) {
+        return _mm256_or_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+    }
+
+    // Compresses the current blocks of lanes 0-3.
+    __attribute__((target("avx2")))
+    static void compress_avx2(blake2b_lanes &s) {
+        __m256i v[16], m[16];
+        for (int i = 0; i < 8; ++i) {
+            v[i] = _mm256_load_si256((const __m256i*)s.h[i]);
+            v[i + 8] = _mm256_set1_epi64x(int64_t(kIV[i]));
+        }
+        v[12] = _mm256_xor_si256(v[12], _mm256_load_si256((const __m256i*)s.t));
+        v[14] = _mm256_xor_si256(v[14], _mm256_load_si256((const __m256i*)s.f));
+        for (int i = 0; i < 16; ++i)
+            m[i] = _mm256_load_si256((const __m256i*)s.m[i]);
+#define G(a, b, c, d, x, y) \
+            v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), x); \
+            v[d] = ror32_avx2(_mm256_xor_si256(v[d], v[a])); \
+            v[c] = _mm256_add_epi64(v[c], v[d]); \
+            v[b] = ror24_avx2(_mm256_xor_si256(v[b], v[c])); \
+            v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), y); \
+            v[d] = ror16_avx2(_mm256_xor_si256(v[d], v[a])); \
+            v[c] = _mm256_add_epi64(v[c], v[d]); \
+            v[b] = ror63_avx2(_mm256_xor_si256(v[b], v[c]));
+        for (int r = 0; r < 12; ++r) {
+            const uint8_t *sg = kSigma[r];
+            G(0, 4,  8, 12, m[sg[ 0]], m[sg[ 1]]);
+            G(1, 5,  9, 13, m[sg[ 2]], m[sg[ 3]]);
+            G(2, 6, 10, 14, m[sg[ 4]], m[sg[ 5]]);
+            G(3, 7, 11, 15, m[sg[ 6]], m[sg[ 7]]);
+            G(0, 5, 10, 15, m[sg[ 8]], m[sg[ 9]]);
+            G(1, 6, 11, 12, m[sg[10]], m[sg[11]]);
+            G(2, 7,  8, 13, m[sg[12]], m[sg[13]]);
+            G(3, 4,  9, 14, m[sg[14]], m[sg[15]]);
+        }
+#undef G
+        for (int i = 0; i < 8; ++i) {
+            __m256i h = _mm256_load_si256((const __m256i*)s.h[i]);
+            h = _mm256_xor_si256(h, _mm256_xor_si256(v[i], v[i + 8]));
+            _mm256_store_si256((__m256i*)s.h[i], h);
+        }
+    }
+
+    // (Using the masked form because GCC 12's `_mm512_ror_epi64` trips -Wuninitialized.)
+    template <int N>
+    __attribute__((target("avx512f")))
+    static inline __m512i ror_avx512(__m512i x) {
+        return _mm512_mask_ror_epi64(x, 0xFF, x, N);
+    }
+
+    // Compresses the current blocks of lanes 0-7.
+    __attribute__((target("avx512f")))
+    static void compress_avx512(blake2b_lanes &s) {
+        __m512i v[16], m[16];
+        for (int i = 0; i < 8; ++i) {
+            v[i] = _mm512_load_si512(s.h[i]);
+            v[i + 8] = _mm512_set1_epi64(int64_t(kIV[i]));
+        }
+        v[12] = _mm512_xor_si512(v[12], _mm512_load_si512(s.t));
+        v[14] = _mm512_xor_si512(v[14], _mm512_load_si512(s.f));
+        for (int i = 0; i < 16; ++i)
+            m[i] = _mm512_load_si512(s.m[i]);
+#define G(a, b, c, d, x, y) \
+            v[a] = _mm512_add_epi64(_mm512_add_epi64(v[a], v[b]), x); \
+            v[d] = ror_avx512<32>(_mm512_xor_si512(v[d], v[a])); \
+            v[c] = _mm512_add_epi64(v[c], v[d]); \
+            v[b] = ror_avx512<24>(_mm512_xor_si512(v[b], v[c])); \
+            v[a] = _mm512_add_epi64(_mm512_add_epi64(v[a], v[b]), y); \
+            v[d] = ror_avx512<16>(_mm512_xor_si512(v[d], v[a])); \
+            v[c] = _mm512_add_epi64(v[c], v[d]); \
+            v[b] = ror_avx512<63>(_mm512_xor_si512(v[b], v[c]));
+        for (int r = 0; r < 12; ++r) {
+            const uint8_t *sg = kSigma[r];
+            G(0, 4,  8, 12, m[sg[ 0]], m[sg[ 1]]);
+            G(1, 5,  9, 13, m[sg[ 2]], m[sg[ 3]]);
+            G(2, 6, 10, 14, m[sg[ 4]], m[sg[ 5]]);
+            G(3, 7, 11, 15, m[sg[ 6]], m[sg[ 7]]);
+            G(0, 5, 10, 15, m[sg[ 8]], m[sg[ 9]]);
+            G(1, 6, 11, 12, m[sg[10]], m[sg[11]]);
+            G(2, 7,  8, 13, m[sg[12]], m[sg[13]]);
+            G(3, 4,  9, 14, m[sg[14]], m[sg[15]]);
+        }
+#undef G
+        for (int i = 0; i < 8; ++i) {
+            __m512i h = _mm512_load_si512(s.h[i]);
+            _mm512_store_si512(s.h[i], _mm512_xor_si512(h, _mm512_xor_si512(v[i], v[i + 8])));
+        }
+    }
+
+    static unsigned cpu_lanes() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return 8;
+        else if (__builtin_cpu_supports("avx2"))
+            return 4;
+        else
+            return 1;
+    }
+
+#else
+    static unsigned cpu_lanes()                     {return 1;}
+#endif // BLAKE2B_X86
+
+    static atomic<unsigned> sLanes {cpu_lanes()};
+
+    unsigned blake2b_many_set_lanes(unsigned max_lanes) {
+        unsigned lanes = cpu_lanes();
+        while (lanes > 1 && lanes > max_lanes)
+            lanes /= 2;
+        if (lanes == 2)
+            lanes = 1;
+        sLanes = lanes;
+        return lanes;
+    }
+
+
+    //======== SHORT MESSAGES
+
+
+    // Loads a (partial) block, zero-padded, without an intermediate buffer that'd need wiping.
+    static inline void load_block(uint64_t m[16], const uint8_t *data, size_t size) {
+        ::memset(m, 0, kBlockSize);
+        if (size > 0)
+            ::memcpy(m, data, size);
+        for (int w = 0; w < 16; ++w)
+            m[w] = load64_le(reinterpret_cast<const uint8_t*>(&m[w]));    // no-op on little-endian
+    }
+
+    void blake2b_short(uint8_t *hash, size_t hash_size, uint64_t param0,
+                       const uint8_t *key, size_t key_size,
+                       const uint8_t *message, size_t message_size)
+    {
+        assert(message_size <= kBlockSize);
+        uint64_t h[8], m[16];
+        h[0] = param0;
+        for (int i = 1; i < 8; ++i)
+            h[i] = kIV[i];
+        if (key_size > 0) {
+            load_block(m, key, key_size);
+            blake2b_compress(h, m, kBlockSize, message_size == 0);
+            if (message_size > 0) {
+                load_block(m, message, message_size);
+                blake2b_compress(h, m, kBlockSize + message_size, true);
+            }
+        } else {
+            load_block(m, message, message_size);
+            blake2b_compress(h, m, message_size, true);
+        }
+        for (size_t i = 0; i < hash_size; ++i)
+            hash[i] = uint8_t(h[i / 8] >> (8 * (i % 8)));
+        // Like `crypto_blake2b`, wipe the state: it holds the whole digest (which may be a
+        // derived secret, such as an X25519 key) and, with a key, the keyed chaining value.
+        // The message may be secret too (e.g. a seed being expanded), so wipe it either way.
+        wipe(h, sizeof(h));
+        wipe(m, sizeof(m));
+    }
+
+
+    //======== MULTI-BUFFER DRIVER
+
+
+    namespace {
+        // Feeds messages through the lanes. Each lane hashes the stream
+        // `[key block] || message`; when a lane's message ends, it's given the next one.
+        class blake2b_multi {
+        public:
+            blake2b_multi(size_t hash_size, const uint8_t *key, size_t key_size,
+                          const input_bytes *messages, size_t count, uint8_t *hashes)
+            :_hashSize(hash_size), _keySize(key_size), _messages(messages), _count(count)
+            ,_hashes(hashes)
+            {
+                ::memset(&_s, 0, sizeof(_s));
+                ::memset(_keyBlock, 0, sizeof(_keyBlock));
+                if (key_size > 0)
+                    ::memcpy(_keyBlock, key, key_size);
+            }
+
+            ~blake2b_multi() {
+                wipe(&_s, sizeof(_s));
+                wipe(_keyBlock, sizeof(_keyBlock));
+            }
+
+            void run(unsigned lanes) {
+                unsigned active = 0;
+                for (unsigned l = 0; l < lanes; ++l)
+                    active += start(l);
+                while (active > 0) {
+                    if (active == 1 && _next == _count) {
+                        // Only one message left; finish it without wasting the other lanes.
+                        for (unsigned l = 0; l < lanes; ++l) {
+                            while (_lane[l].active)
+                                step(l);
+                        }
+                        break;
+                    }
+                    for (unsigned l = 0; l < lanes; ++l) {
+                        if (_lane[l].active)
+                            load_block(l);
+                    }
+                    compress(lanes);
+                    for (unsigned l = 0; l < lanes; ++l) {
+                        if (_lane[l].active && !advance(l))
+                            active -= !start(l);
+                    }
+                }
+            }
+
+        private:
+            struct lane {
+                size_t   message;       // index of the message being hashed
+                uint64_t total;         // length of the stream, including any key block
+                uint64_t pos;           // stream offset of the current block
+                bool     active;
+            };
+
+            // Assigns the next message to lane `l`. Returns false if there are none left.
+            bool start(unsigned l) {
+                lane &ln = _lane[l];
+                ln.active = (_next < _count);
+                if (!ln.active)
+                    return false;
+                ln.message = _next++;
+                ln.total = (_keySize ? kBlockSize : 0) + _messages[ln.message].size;
+                ln.pos = 0;
+                for (int i = 0; i < 8; ++i)
+                    _s.h[i][l] = kIV[i];
+                _s.h[0][l] ^= 0x01010000 ^ (_keySize << 8) ^ _hashSize;
+                return true;
+            }
+
+            // Copies lane `l`'s current block into the state, with its counter and final flag.
+            void load_block(unsigned l) {
+                lane &ln = _lane[l];
+                const uint8_t *src;
+                uint8_t buf[kBlockSize];
+                if (_keySize > 0 && ln.pos == 0) {
+                    src = _keyBlock;
+                } else {
+                    uint64_t offset = ln.pos - (_keySize ? kBlockSize : 0);
+                    input_bytes msg = _messages[ln.message];
+                    size_t n = size_t(min<uint64_t>(kBlockSize, msg.size - offset));
+                    src = msg.data + offset;
+                    if (n < kBlockSize) {
+                        if (n > 0)
+                            ::memcpy(buf, src, n);
+                        ::memset(buf + n, 0, kBlockSize - n);
+                        src = buf;
+                    }
+                }
+                for (int w = 0; w < 16; ++w)
+                    _s.m[w][l] = load64_le(src + 8 * w);
+                bool last = (ln.pos + kBlockSize >= ln.total);
+                _s.t[l] = last ? ln.total : ln.pos + kBlockSize;
+                _s.f[l] = last ? ~uint64_t(0) : 0;
+            }
+
+            // Moves lane `l` past the block just compressed. If that was the last one, writes
+            // the hash and returns false.
+            bool advance(unsigned l) {
+                lane &ln = _lane[l];
+                if (_s.f[l] == 0) {
+                    ln.pos += kBlockSize;
+                    return true;
+                }
+                uint8_t out[64];
+                for (int i = 0; i < 8; ++i)
+                    store64_le(&out[8 * i], _s.h[i][l]);
+                ::memcpy(_hashes + ln.message * _hashSize, out, _hashSize);
+                ln.active = false;
+                return false;
+            }
+
+            // Processes one block of lane `l` alone, starting the next message if it finishes.
+            void step(unsigned l) {
+                load_block(l);
+                compress_lane(_s, l);
+                if (!advance(l))
+                    start(l);
+            }
+
+            void compress(unsigned lanes) {
+#ifdef BLAKE2B_X86
+                if (lanes == 8)
+                    return compress_avx512(_s);
+                if (lanes == 4)
+                    return compress_avx2(_s);
+#endif
+                for (unsigned l = 0; l < lanes; ++l)
+                    compress_lane(_s, l);
+            }
+
+            blake2b_lanes   _s;
+            lane            _lane[kMaxLanes] = {};
+            uint8_t         _keyBlock[kBlockSize];
+            size_t const    _hashSize, _keySize;
+            const input_bytes* const _messages;
+            size_t const    _count;
+            uint8_t* const  _hashes;
+            size_t          _next = 0;
+        };
+    }
+
+
+    void blake2b_many(uint8_t *hashes, size_t hash_size, const uint8_t *key, size_t key_size,
+                      const input_bytes *messages, size_t count)
+    {
+        unsigned lanes = sLanes.load(memory_order_relaxed);
+        if (lanes <= 1 || count < 2) {
+            for (size_t i = 0; i < count; ++i)
+                c::crypto_blake2b_keyed(hashes + i * hash_size, hash_size, key, key_size,
+                                        messages[i].data, messages[i].size);
+            return;
+        }
+        blake2b_multi(hash_size, key, key_size, messages, count, hashes).run(lanes);
+    }
+
+}
@@ -57,6 +57,40 @@ namespace monocypher::ext {
         blake3_hasher_finalize(hasher(ctx), hash, hash_size);
     }
 
+    // Only the used part of the chaining-value stack is saved.
+    void Blake3Base::save_fn(const context *ctx, vector<uint8_t> &out) {
+        auto h = reinterpret_cast<const blake3_hasher*>(ctx);
+        internal::state_writer w{out};
+        for (uint32_t k : h->key)       w.u32(k);
+        for (uint32_t v : h->chunk.cv)  w.u32(v);
+        w.u64(h->chunk.chunk_counter);
+        w.bytes(h->chunk.buf, sizeof(h->chunk.buf));
+        w.u8(h->chunk.buf_len);
+        w.u8(h->chunk.blocks_compressed);
+        w.u8(h->chunk.flags);
+        w.u8(h->cv_stack_len);
+        w.bytes(h->cv_stack, h->cv_stack_len * BLAKE3_OUT_LEN);
+    }
+
+    void Blake3Base::restore_fn(context *ctx, const uint8_t *state, size_t size) {
+        auto h = hasher(ctx);
+        ::memset(h, 0, sizeof(*h));
+        internal::state_reader r{state, state + size};
+        for (uint32_t &k : h->key)      k = r.u32();
+        for (uint32_t &v : h->chunk.cv) v = r.u32();
+        h->chunk.chunk_counter = r.u64();
+        r.bytes(h->chunk.buf, sizeof(h->chunk.buf));
+        h->chunk.buf_len = r.u8();
+        h->chunk.blocks_compressed = r.u8();
+        h->chunk.flags = r.u8();
+        h->cv_stack_len = r.u8();
+        r.check(h->chunk.buf_len <= BLAKE3_BLOCK_LEN
+                && h->chunk.blocks_compressed <= BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN
+                && h->cv_stack_len <= BLAKE3_MAX_DEPTH + 1);
+        r.bytes(h->cv_stack, h->cv_stack_len * BLAKE3_OUT_LEN);
+        r.finish();
+    }
+
     void Blake3Base::create_fn(uint8_t* hash, size_t hash_size, const uint8_t *message, size_t message_size) {
         blake3_hasher ctx;
         blake3_hasher_init(&ctx);
@@ -0,0 +1,331 @@
+//
+//  Monocypher+chacha20_stream.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/chacha20_stream.hh"
+#include <algorithm>
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#   define CHACHA20_X86 1
+#   include <immintrin.h>
+#endif
+
+// Random-access ChaCha20. Partial blocks go through Monocypher's `crypto_chacha20_djb`; runs of
+// whole blocks are computed 8 or 16 at a time, one block per 32-bit SIMD lane, then transposed
+// back into byte order.
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    //======== SIMD BLOCKS
+
+
+#ifdef CHACHA20_X86
+
+    static void load_state(uint32_t s[16], const uint8_t key[32], const uint8_t nonce[8]) {
+        static constexpr uint32_t kSigma[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+        auto load32 = [](const uint8_t *p) {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16
+                 | uint32_t(p[3]) << 24;
+        };
+        for (int i = 0; i < 4; ++i)
+            s[i] = kSigma[i];
+        for (int i = 0; i < 8; ++i)
+            s[4 + i] = load32(&key[4 * i]);
+        s[12] = s[13] = 0;          // (block counter; set per lane)
+        s[14] = load32(&nonce[0]);
+        s[15] = load32(&nonce[4]);
+    }
+
+#define CHACHA20_ROUNDS(QR) \
+        for (int r = 0; r < 10; ++r) { \
+            QR(0, 4,  8, 12); QR(1, 5,  9, 13); QR(2, 6, 10, 14); QR(3, 7, 11, 15); \
+            QR(0, 5, 10, 15); QR(1, 6, 11, 12); QR(2, 7,  8, 13); QR(3, 4,  9, 14); \
+        }
+
+
+    template <int N>
+    __attribute__((target("avx2")))
+    static inline __m256i rol_avx2(__m256i x) {
+        if constexpr (N == 16) {
+            return _mm256_shuffle_epi8(x, _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9,
+                                                           14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5,
+                                                           10, 11, 8, 9, 14, 15, 12, 13));
+        } else if constexpr (N == 8) {
+            return _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10,
+                                                           15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6,
+                                                           11, 8, 9, 10, 15, 12, 13, 14));
+        } else {
+            return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+        }
+    }
+
+    // Transposes an 8x8 matrix of 32-bit words: afterwards `v[b]` holds words 0-7 of block `b`.
+    __attribute__((target("avx2")))
+    static inline void transpose_avx2(__m256i v[8]) {
+        __m256i t[8], u[8];
+        for (int i = 0; i < 8; i += 2) {
+            t[i]     = _mm256_unpacklo_epi32(v[i], v[i + 1]);
+            t[i + 1] = _mm256_unpackhi_epi32(v[i], v[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4) {
+            u[i]     = _mm256_unpacklo_epi64(t[i],     t[i + 2]);
+            u[i + 1] = _mm256_unpackhi_epi64(t[i],     t[i + 2]);
+            u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int k = 0; k < 4; ++k) {
+            v[k]     = _mm256_permute2x128_si256(u[k], u[k + 4], 0x20);
+            v[k + 4] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x31);
+        }
+    }
+
+    // XORs 8 blocks (512 bytes) of keystream, starting at block `ctr`, with `in` (or with zeroes
+    // if it's null.)
+    __attribute__((target("avx2")))
+    static void blocks_avx2(uint8_t *out, const uint8_t *in, const uint32_t s[16], uint64_t ctr) {
+        __m256i x[16], v[16];
+        for (int i = 0; i < 16; ++i)
+            x[i] = _mm256_set1_epi32(int(s[i]));
+        alignas(32) uint32_t lo[8], hi[8];
+        for (int l = 0; l < 8; ++l) {
+            lo[l] = uint32_t(ctr + l);
+            hi[l] = uint32_t((ctr + l) >> 32);
+        }
+        x[12] = _mm256_load_si256((const __m256i*)lo);
+        x[13] = _mm256_load_si256((const __m256i*)hi);
+        for (int i = 0; i < 16; ++i)
+            v[i] = x[i];
+#define QR(a, b, c, d) \
+            v[a] = _mm256_add_epi32(v[a], v[b]); v[d] = rol_avx2<16>(_mm256_xor_si256(v[d], v[a])); \
+            v[c] = _mm256_add_epi32(v[c], v[d]); v[b] = rol_avx2<12>(_mm256_xor_si256(v[b], v[c])); \
+            v[a] = _mm256_add_epi32(v[a], v[b]); v[d] = rol_avx2<8> (_mm256_xor_si256(v[d], v[a])); \
+            v[c] = _mm256_add_epi32(v[c], v[d]); v[b] = rol_avx2<7> (_mm256_xor_si256(v[b], v[c]))
+        CHACHA20_ROUNDS(QR)
+#undef QR
+        for (int i = 0; i < 16; ++i)
+            v[i] = _mm256_add_epi32(v[i], x[i]);
+        transpose_avx2(&v[0]);
+        transpose_avx2(&v[8]);
+        for (int b = 0; b < 8; ++b) {
+            __m256i k0 = v[b], k1 = v[8 + b];
+            if (in) {
+                k0 = _mm256_xor_si256(k0, _mm256_loadu_si256((const __m256i*)&in[64 * b]));
+                k1 = _mm256_xor_si256(k1, _mm256_loadu_si256((const __m256i*)&in[64 * b + 32]));
+            }
+            _mm256_storeu_si256((__m256i*)&out[64 * b],      k0);
+            _mm256_storeu_si256((__m256i*)&out[64 * b + 32], k1);
+        }
+    }
+
+
+    // (Using masked forms throughout because GCC 12's unmasked `_mm512_rol_epi32`, unpack and
+    // shuffle intrinsics trip -Wuninitialized.)
+    template <int N>
+    __attribute__((target("avx512f")))
+    static inline __m512i rol_avx512(__m512i x) {
+        return _mm512_mask_rol_epi32(x, 0xFFFF, x, N);
+    }
+
+    __attribute__((target("avx512f")))
+    static inline __m512i unpacklo32_avx512(__m512i a, __m512i b) {
+        return _mm512_mask_unpacklo_epi32(a, 0xFFFF, a, b);
+    }
+
+    __attribute__((target("avx512f")))
+    static inline __m512i unpackhi32_avx512(__m512i a, __m512i b) {
+        return _mm512_mask_unpackhi_epi32(a, 0xFFFF, a, b);
+    }
+
+    __attribute__((target("avx512f")))
+    static inline __m512i unpacklo64_avx512(__m512i a, __m512i b) {
+        return _mm512_mask_unpacklo_epi64(a, 0xFF, a, b);
+    }
+
+    __attribute__((target("avx512f")))
+    static inline __m512i unpackhi64_avx512(__m512i a, __m512i b) {
+        return _mm512_mask_unpackhi_epi64(a, 0xFF, a, b);
+    }
+
+    // Even 128-bit lanes of `a`, then of `b` (`Odd` = 0), or the odd lanes (`Odd` = 1).
+    template <int Odd>
+    __attribute__((target("avx512f")))
+    static inline __m512i lanes128_avx512(__m512i a, __m512i b) {
+        return _mm512_mask_shuffle_i32x4(a, 0xFFFF, a, b, Odd ? 0xDD : 0x88);
+    }
+
+    // Transposes a 16x16 matrix of 32-bit words: afterwards `v[b]` holds block `b`.
+    __attribute__((target("avx512f")))
+    static inline void transpose_avx512(__m512i v[16]) {
+        __m512i t[16], u[16];
+        for (int i = 0; i < 16; i += 2) {
+            t[i]     = unpacklo32_avx512(v[i], v[i + 1]);
+            t[i + 1] = unpackhi32_avx512(v[i], v[i + 1]);
+        }
+        // Now 128-bit lane `j` of `u[4q + k]` holds words 4q...4q+3 of block 4j+k:
+        for (int i = 0; i < 16; i += 4) {
+            u[i]     = unpacklo64_avx512(t[i],     t[i + 2]);
+            u[i + 1] = unpackhi64_avx512(t[i],     t[i + 2]);
+            u[i + 2] = unpacklo64_avx512(t[i + 1], t[i + 3]);
+            u[i + 3] = unpackhi64_avx512(t[i + 1], t[i + 3]);
+        }
+        for (int k = 0; k < 4; ++k) {
+            __m512i a = lanes128_avx512<0>(u[k],     u[k + 4]);
+            __m512i b = lanes128_avx512<1>(u[k],     u[k + 4]);
+            __m512i c = lanes128_avx512<0>(u[k + 8], u[k + 12]);
+            __m512i d = lanes128_avx512<1>(u[k + 8], u[k + 12]);
+            v[k]      = lanes128_avx512<0>(a, c);
+            v[k + 4]  = lanes128_avx512<0>(b, d);
+            v[k + 8]  = lanes128_avx512<1>(a, c);
+            v[k + 12] = lanes128_avx512<1>(b, d);
+        }
+    }
+
+    // XORs 16 blocks (1024 bytes) of keystream, starting at block `ctr`, with `in` (or with
+    // zeroes if it's null.)
+    __attribute__((target("avx512f")))
+    static void blocks_avx512(uint8_t *out, const uint8_t *in, const uint32_t s[16], uint64_t ctr) {
+        __m512i x[16], v[16];
+        for (int i = 0; i < 16; ++i)
+            x[i] = _mm512_set1_epi32(int(s[i]));
+        alignas(64) uint32_t lo[16], hi[16];
+        for (int l = 0; l < 16; ++l) {
+            lo[l] = uint32_t(ctr + l);
+            hi[l] = uint32_t((ctr + l) >> 32);
+        }
+        x[12] = _mm512_load_si512(lo);
+        x[13] = _mm512_load_si512(hi);
+        for (int i = 0; i < 16; ++i)
+            v[i] = x[i];
+#define QR(a, b, c, d) \
+            v[a] = _mm512_add_epi32(v[a], v[b]); v[d] = rol_avx512<16>(_mm512_xor_si512(v[d], v[a])); \
+            v[c] = _mm512_add_epi32(v[c], v[d]); v[b] = rol_avx512<12>(_mm512_xor_si512(v[b], v[c])); \
+            v[a] = _mm512_add_epi32(v[a], v[b]); v[d] = rol_avx512<8> (_mm512_xor_si512(v[d], v[a])); \
+            v[c] = _mm512_add_epi32(v[c], v[d]); v[b] = rol_avx512<7> (_mm512_xor_si512(v[b], v[c]))
+        CHACHA20_ROUNDS(QR)
+#undef QR
+        for (int i = 0; i < 16; ++i)
+            v[i] = _mm512_add_epi32(v[i], x[i]);
+        transpose_avx512(v);
+        for (int b = 0; b < 16; ++b) {
+            __m512i k = v[b];
+            if (in)
+                k = _mm512_xor_si512(k, _mm512_loadu_si512(&in[64 * b]));
+            _mm512_storeu_si512(&out[64 * b], k);
+        }
+    }
+
+#undef CHACHA20_ROUNDS
+
+    static unsigned cpu_lanes() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return 16;
+        else if (__builtin_cpu_supports("avx2"))
+            return 8;
+        else
+            return 1;
+    }
+
+#else
+    static unsigned cpu_lanes()                     {return 1;}
+#endif // CHACHA20_X86
+
+    static atomic<unsigned> sLanes {cpu_lanes()};
+
+    unsigned chacha20_stream::set_lanes(unsigned max_lanes) {
+        unsigned lanes = cpu_lanes();
+        while (lanes > 1 && lanes > max_lanes)
+            lanes /= 2;
+        if (lanes < 8)
+            lanes = 1;
+        sLanes = lanes;
+        return lanes;
+    }
+
+
+    //======== STREAMS
+
+
+    void chacha20_stream::apply_at(uint64_t offset, input_bytes in_bytes, void *out_) const {
+        const uint8_t *in = in_bytes.data;
+        uint8_t *out = u8(out_);
+        size_t size = in_bytes.size;
+        uint64_t ctr = offset / 64;
+
+        // Leading partial block:
+        if (size_t skip = offset % 64; skip != 0 && size > 0) {
+            uint8_t block[64];
+            c::crypto_chacha20_djb(block, nullptr, 64, _key.data(), _nonce.data(), ctr++);
+            size_t n = min(size, 64 - skip);
+            for (size_t i = 0; i < n; ++i)
+                out[i] = uint8_t((in ? in[i] : 0) ^ block[skip + i]);
+            wipe(block, sizeof(block));
+            if (in) in += n;
+            out += n;
+            size -= n;
+        }
+
+        // Whole blocks, several at a time:
+#ifdef CHACHA20_X86
+        if (unsigned lanes = sLanes; lanes > 1 && size >= 64 * lanes) {
+            uint32_t s[16];
+            load_state(s, _key.data(), _nonce.data());
+            auto blocks = (lanes == 16) ? blocks_avx512 : blocks_avx2;
+            do {
+                blocks(out, in, s, ctr);
+                ctr += lanes;
+                if (in) in += 64 * lanes;
+                out += 64 * lanes;
+                size -= 64 * lanes;
+            } while (size >= 64 * lanes);
+            wipe(s, sizeof(s));
+        }
+#endif
+
+        // The rest:
+        if (size > 0)
+            c::crypto_chacha20_djb(out, in, size, _key.data(), _nonce.data(), ctr);
+    }
+
+
+    xchacha20_stream::xchacha20_stream(byte_array<32> const& key, byte_array<24> const& nonce,
+                                       uint64_t offset)
+    :chacha20_stream(offset)
+    {
+        c::crypto_chacha20_h(_key.data(), key.data(), nonce.data());
+        ::memcpy(_nonce.data(), &nonce[16], 8);
+    }
+
+}
@@ -0,0 +1,190 @@
+//
+//  Monocypher+checkpoint.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/hash.hh"
+#include "monocypher/ext/sha512.hh"
+#include <stdexcept>
+
+// Checkpoint framing for `hash::builder` and `hash::mac_builder`, and the state encodings of
+// Monocypher's own hash contexts. (SHA-256 and BLAKE3 encode theirs in their own source files.)
+
+namespace monocypher {
+    using namespace std;
+    using internal::state_writer;
+    using internal::state_reader;
+
+
+    //======== CHECKPOINT FRAMING
+
+
+    // Checkpoint header:
+    //   magic "MCHK" | format version | algorithm id | flags | hash size
+    // followed by either
+    //   state | Blake2b-128(header || state)                   (unkeyed)
+    //   nonce[24] | mac[16] | XChaCha20(state), header as AD    (keyed; flag bit 0 set)
+    static constexpr uint8_t kMagic[4] = {'M', 'C', 'H', 'K'};
+    static constexpr uint8_t kVersion = 1;
+    static constexpr uint8_t kEncryptedFlag = 0x01;
+    static constexpr size_t  kHeaderSize = 8, kChecksumSize = 16, kNonceSize = 24, kMACSize = 16;
+
+
+    static void write_header(vector<uint8_t> &out, uint8_t algorithm_id, size_t hash_size,
+                             uint8_t flags) {
+        out.assign(kMagic, kMagic + 4);
+        out.push_back(kVersion);
+        out.push_back(algorithm_id);
+        out.push_back(flags);
+        out.push_back(uint8_t(hash_size));
+    }
+
+
+    vector<uint8_t> seal_hash_checkpoint(uint8_t algorithm_id, size_t hash_size,
+                                         const vector<uint8_t> &state, const uint8_t *key)
+    {
+        vector<uint8_t> out;
+        if (key) {
+            write_header(out, algorithm_id, hash_size, kEncryptedFlag);
+            out.resize(kHeaderSize + kNonceSize + kMACSize + state.size());
+            uint8_t *nonce = &out[kHeaderSize], *mac = nonce + kNonceSize;
+            randomize(nonce, kNonceSize);
+            c::crypto_aead_lock(mac + kMACSize, mac, key, nonce,
+                                out.data(), kHeaderSize, state.data(), state.size());
+        } else {
+            write_header(out, algorithm_id, hash_size, 0);
+            out.insert(out.end(), state.begin(), state.end());
+            uint8_t checksum[kChecksumSize];
+            c::crypto_blake2b(checksum, kChecksumSize, out.data(), out.size());
+            out.insert(out.end(), checksum, checksum + kChecksumSize);
+        }
+        return out;
+    }
+
+
+    vector<uint8_t> open_hash_checkpoint(uint8_t algorithm_id, size_t hash_size,
+                                         input_bytes checkpoint, const uint8_t *key)
+    {
+        const uint8_t *data = checkpoint.data;
+        size_t size = checkpoint.size;
+        if (size < kHeaderSize + kChecksumSize || ::memcmp(data, kMagic, 4) != 0)
+            throw invalid_argument("not a hash checkpoint");
+        if (data[4] != kVersion)
+            throw invalid_argument("unsupported hash checkpoint version");
+        if (data[5] != algorithm_id || data[7] != hash_size)
+            throw invalid_argument("hash checkpoint is from a different algorithm");
+        if (bool(data[6] & kEncryptedFlag) != (key != nullptr))
+            throw invalid_argument(key ? "hash checkpoint is not from a MAC builder"
+                                       : "hash checkpoint is from a MAC builder");
+        vector<uint8_t> state;
+        if (key) {
+            if (size < kHeaderSize + kNonceSize + kMACSize)
+                throw invalid_argument("truncated hash checkpoint");
+            const uint8_t *nonce = &data[kHeaderSize], *mac = nonce + kNonceSize;
+            state.resize(size - (kHeaderSize + kNonceSize + kMACSize));
+            if (0 != c::crypto_aead_unlock(state.data(), mac, key, nonce, data, kHeaderSize,
+                                           mac + kMACSize, state.size()))
+                throw invalid_argument("hash checkpoint is corrupt or the key is wrong");
+        } else {
+            uint8_t checksum[kChecksumSize];
+            c::crypto_blake2b(checksum, kChecksumSize, data, size - kChecksumSize);
+            if (!constant_time_compare(checksum, &data[size - kChecksumSize], kChecksumSize))
+                throw invalid_argument("hash checkpoint is corrupt");
+            state.assign(&data[kHeaderSize], &data[size - kChecksumSize]);
+        }
+        return state;
+    }
+
+
+    //======== BLAKE2B
+
+
+    void blake2b_save_state(const c::crypto_blake2b_ctx *ctx, vector<uint8_t> &out) {
+        state_writer w{out};
+        for (uint64_t h : ctx->hash)            w.u64(h);
+        for (uint64_t n : ctx->input_offset)    w.u64(n);
+        for (uint64_t m : ctx->input)           w.u64(m);
+        w.u64(ctx->input_idx);
+        w.u64(ctx->hash_size);
+    }
+
+    void blake2b_restore_state(c::crypto_blake2b_ctx *ctx, const uint8_t *state, size_t size) {
+        state_reader r{state, state + size};
+        for (uint64_t &h : ctx->hash)           h = r.u64();
+        for (uint64_t &n : ctx->input_offset)   n = r.u64();
+        for (uint64_t &m : ctx->input)          m = r.u64();
+        uint64_t idx = r.u64(), hash_size = r.u64();
+        r.check(idx <= 128 && hash_size >= 1 && hash_size <= 64);
+        r.finish();
+        ctx->input_idx = size_t(idx);
+        ctx->hash_size = size_t(hash_size);
+    }
+
+
+    //======== SHA-512
+
+
+    void SHA512::save_fn(const context *ctx, vector<uint8_t> &out) {
+        state_writer w{out};
+        for (uint64_t h : ctx->hash)            w.u64(h);
+        for (uint64_t m : ctx->input)           w.u64(m);
+        for (uint64_t n : ctx->input_size)      w.u64(n);
+        w.u64(ctx->input_idx);
+    }
+
+    static void restore_sha512(c::crypto_sha512_ctx *ctx, state_reader &r) {
+        for (uint64_t &h : ctx->hash)           h = r.u64();
+        for (uint64_t &m : ctx->input)          m = r.u64();
+        for (uint64_t &n : ctx->input_size)     n = r.u64();
+        uint64_t idx = r.u64();
+        r.check(idx <= 128);
+        ctx->input_idx = size_t(idx);
+    }
+
+    void SHA512::restore_fn(context *ctx, const uint8_t *state, size_t size) {
+        state_reader r{state, state + size};
+        restore_sha512(ctx, r);
+        r.finish();
+    }
+
+    void SHA512::mac::save_fn(const context *ctx, vector<uint8_t> &out) {
+        state_writer{out}.bytes(ctx->key, sizeof(ctx->key));
+        SHA512::save_fn(&ctx->ctx, out);
+    }
+
+    void SHA512::mac::restore_fn(context *ctx, const uint8_t *state, size_t size) {
+        state_reader r{state, state + size};
+        r.bytes(ctx->key, sizeof(ctx->key));
+        restore_sha512(&ctx->ctx, r);
+        r.finish();
+    }
+
+}
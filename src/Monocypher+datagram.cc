@@ -0,0 +1,231 @@
+//
+//  monocypher/Monocypher+datagram.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/datagram.hh"
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    static void check_seq_size(size_t seq_size) {
+        if (seq_size < 1 || seq_size > 8)
+            throw invalid_argument("datagram sequence size must be 1 to 8 bytes");
+    }
+
+
+    datagram_sender::datagram_sender(key const& k, size_t seq_size)
+    :_key(k)
+    ,_seq_size(seq_size)
+    {
+        check_seq_size(seq_size);
+    }
+
+
+    output_bytes datagram_sender::seal(input_bytes message, output_bytes packet) {
+        assert(packet.size >= message.size + overhead());
+        uint64_t seq = _next_seq++;
+        auto out = u8(packet.data);
+        for (size_t i = 0; i < _seq_size; ++i)
+            out[i] = uint8_t(seq >> (8 * i));
+        _key.box(session::nonce(seq), message, {out + _seq_size, packet.size - _seq_size});
+        return packet.shrunk_to(message.size + overhead());
+    }
+
+
+    datagram_receiver::datagram_receiver(key const& k, size_t seq_size, size_t window_size)
+    :_key(k)
+    ,_seq_size(seq_size)
+    ,_window(window_size)
+    {
+        check_seq_size(seq_size);
+    }
+
+
+    // This is the same algorithm as QUIC's packet-number decoding (RFC 9000, appendix A.3.)
+    uint64_t datagram_receiver::expand_sequence(uint64_t truncated) const {
+        if (_seq_size == 8)
+            return truncated;
+        uint64_t expected = _window.top();
+        uint64_t window = uint64_t(1) << (8 * _seq_size);
+        uint64_t half_window = window / 2;
+        uint64_t candidate = (expected & ~(window - 1)) | truncated;
+        if (candidate + half_window <= expected && candidate <= UINT64_MAX - window)
+            return candidate + window;
+        else if (candidate > expected + half_window && candidate >= window)
+            return candidate - window;
+        else
+            return candidate;
+    }
+
+
+    output_bytes datagram_receiver::open(input_bytes packet, output_bytes message) {
+        if (packet.size < overhead())
+            return {};
+        uint64_t truncated = 0;
+        for (size_t i = 0; i < _seq_size; ++i)
+            truncated |= uint64_t(packet.data[i]) << (8 * i);
+        uint64_t seq = expand_sequence(truncated);
+        packet.consume(_seq_size);
+        return _key.unbox(_window, seq, packet, message);
+    }
+
+
+#ifndef _WIN32
+
+    [[noreturn]] static void throw_errno(const char *what) {
+        throw system_error(errno, generic_category(), what);
+    }
+
+
+    datagram_batch::datagram_batch(size_t capacity, size_t max_packet_size)
+    :_capacity(capacity)
+    ,_max_packet_size(max_packet_size)
+    ,_buffer(make_unique<uint8_t[]>(capacity * max_packet_size))
+    ,_sizes(capacity)
+    {
+        if (capacity == 0 || max_packet_size == 0)
+            throw invalid_argument("invalid datagram_batch size");
+        _messages.reserve(capacity);
+    }
+
+
+    bool datagram_batch::add(datagram_sender &sender, input_bytes message) {
+        if (full())
+            return false;
+        if (message.size + sender.overhead() > _max_packet_size)
+            throw invalid_argument("message too large for datagram_batch");
+        _sizes[_count] = sender.seal(message, {slot(_count), _max_packet_size}).size;
+        ++_count;
+        return true;
+    }
+
+
+    size_t datagram_batch::send(int fd) {
+        size_t sent = 0;
+#ifdef __linux__
+        vector<iovec> iov(_count);
+        vector<mmsghdr> msgs(_count);
+        for (size_t i = 0; i < _count; ++i) {
+            iov[i] = {slot(i), _sizes[i]};
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        while (sent < _count) {
+            int n = ::sendmmsg(fd, &msgs[sent], unsigned(_count - sent), 0);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw_errno("datagram_batch send");
+            }
+            sent += size_t(n);
+        }
+#else
+        while (sent < _count) {
+            if (::send(fd, slot(sent), _sizes[sent], 0) < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw_errno("datagram_batch send");
+            }
+            ++sent;
+        }
+#endif
+        clear();
+        return sent;
+    }
+
+
+    size_t datagram_batch::receive(int fd, datagram_receiver &receiver) {
+        size_t overhead = receiver.overhead();
+        if (_max_packet_size < overhead)
+            throw invalid_argument("datagram_batch max packet size is smaller than the overhead");
+        clear();
+#ifdef __linux__
+        vector<iovec> iov(_capacity);
+        vector<mmsghdr> msgs(_capacity);
+        for (size_t i = 0; i < _capacity; ++i) {
+            iov[i] = {slot(i), _max_packet_size};
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int n;
+        while ((n = ::recvmmsg(fd, msgs.data(), unsigned(_capacity), MSG_WAITFORONE, nullptr)) < 0) {
+            if (errno != EINTR)
+                throw_errno("datagram_batch receive");
+        }
+        _count = size_t(n);
+        for (size_t i = 0; i < _count; ++i)
+            _sizes[i] = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : msgs[i].msg_len;
+#else
+        while (_count < _capacity) {
+            iovec iov = {slot(_count), _max_packet_size};
+            msghdr msg = {};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            ssize_t n = ::recvmsg(fd, &msg, (_count == 0) ? 0 : MSG_DONTWAIT);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                else if (_count > 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    break;
+                throw_errno("datagram_batch receive");
+            }
+            _sizes[_count++] = (msg.msg_flags & MSG_TRUNC) ? 0 : size_t(n);
+        }
+#endif
+        // Decrypt each packet in place; a truncated packet has size 0 and will be rejected.
+        for (size_t i = 0; i < _count; ++i) {
+            uint8_t *packet = slot(i);
+            output_bytes message = receiver.open({packet, _sizes[i]},
+                                                 {packet + overhead, _max_packet_size - overhead});
+            if (message)
+                _messages.emplace_back(message.data, message.size);
+            else
+                ++_rejected;
+        }
+        return _messages.size();
+    }
+
+#endif // _WIN32
+
+}
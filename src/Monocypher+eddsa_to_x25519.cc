@@ -0,0 +1,91 @@
+//
+//  Monocypher+eddsa_to_x25519.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/signatures.hh"
+#include "edwards25519.hh"
+#include <algorithm>
+
+// Batch conversion of Edwards public keys to Montgomery (X25519) ones: u = (1 + y) / (1 - y).
+// Only the y coordinate is needed, so there's no point decompression; the cost is all in the
+// division, and Montgomery's trick turns n inversions into one inversion and 3(n-1)
+// multiplications.
+
+namespace monocypher {
+    using namespace std;
+    using namespace edwards25519;
+
+    // Keys per shared inversion. Larger groups save little more and need more scratch space.
+    static constexpr size_t kGroupSize = 256;
+
+    // Each thread gets at least this many keys to convert.
+    static constexpr size_t kMinKeysPerThread = 2048;
+
+
+    static void convert_group(uint8_t *x25519, const uint8_t *eddsa, size_t n) {
+        fe num[kGroupSize], den[kGroupSize], prefix[kGroupSize];
+        for (size_t i = 0; i < n; ++i) {
+            fe y = fe_frombytes(&eddsa[32 * i]);
+            num[i] = fe_add(fe_int(1), y);
+            den[i] = fe_sub(fe_int(1), y);
+            if (fe_iszero(den[i])) {
+                // y = 1: Monocypher's inversion maps 0 to 0, so u = 0. Substitute 1 for the
+                // denominator so it doesn't zero out the whole batch's product.
+                num[i] = fe_int(0);
+                den[i] = fe_int(1);
+            }
+            prefix[i] = (i == 0) ? den[0] : fe_mul(prefix[i - 1], den[i]);
+        }
+        // inv = 1 / (den[0] * ... * den[i]), walking i downward:
+        fe inv = fe_invert(prefix[n - 1]);
+        for (size_t i = n; i-- > 0; ) {
+            fe inv_den = (i == 0) ? inv : fe_mul(inv, prefix[i - 1]);
+            if (i > 0)
+                inv = fe_mul(inv, den[i]);
+            fe_tobytes(&x25519[32 * i], fe_mul(num[i], inv_den));
+        }
+    }
+
+
+    void eddsa_to_x25519_many(uint8_t *x25519, const uint8_t *eddsa, size_t count,
+                              unsigned threads)
+    {
+        // One job per group, so every group shares its inversion fully:
+        size_t groups = (count + kGroupSize - 1) / kGroupSize;
+        size_t max_threads = (count + kMinKeysPerThread - 1) / kMinKeysPerThread;
+        internal::parallel_for(groups, threads, max_threads, [&](size_t group) {
+            size_t i = group * kGroupSize;
+            convert_group(&x25519[32 * i], &eddsa[32 * i], min(kGroupSize, count - i));
+        });
+    }
+
+}
@@ -0,0 +1,283 @@
+//
+//  Monocypher+fixed_base.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/key_exchange.hh"
+#include "monocypher/signatures.hh"
+#include "monocypher/ext/ed25519.hh"
+
+// Fixed-base scalar multiplication for key generation and signing. By default these simply call
+// Monocypher, whose comb table is small. With the CMake option `MONOCYPHER_WIDE_COMB` the build
+// generates a 30KB table of multiples of the base point (tools/monocypher-gen-comb.cc), which
+// this file compiles in as constant data; a multiplication then takes 64 table lookups and
+// mixed additions plus 4 doublings.
+
+#ifdef MONOCYPHER_WIDE_COMB
+#include "edwards25519.hh"
+#include "ed25519_comb_table.inc"
+#endif
+
+namespace monocypher {
+    using namespace std;
+
+#ifdef MONOCYPHER_WIDE_COMB
+    using namespace edwards25519;
+
+
+    //======== CONSTANT-TIME COMB
+
+
+    // An affine point prepared for mixed addition: (y+x, y-x, 2dxy).
+    struct ge_precomp {
+        fe ypx, ymx, t2d;
+    };
+
+
+    // Sets `f` to `g` if `b` is 1; leaves it alone if `b` is 0. No branches.
+    static inline void fe_cmov(fe &f, const fe &g, int64_t b) {
+        int64_t mask = -b;
+        for (int i = 0; i < 10; ++i)
+            f.v[i] ^= (f.v[i] ^ g.v[i]) & mask;
+    }
+
+    static inline fe fe_load(const int32_t limbs[10]) {
+        fe f;
+        for (int i = 0; i < 10; ++i) f.v[i] = limbs[i];
+        return f;
+    }
+
+    // Returns b * 256^pos * B for -8 <= b <= 8. Every entry of the row is read, and the
+    // choice is made with masks, so the memory access pattern doesn't depend on `b`.
+    static ge_precomp select(int pos, int8_t b) {
+        int64_t negative = uint8_t(b) >> 7;
+        int64_t babs = b - ((-negative & b) * 2);
+        ge_precomp t = {fe_int(1), fe_int(1), fe_int(0)};
+        for (int j = 1; j <= 8; ++j) {
+            int64_t equal = uint64_t((babs ^ j) - 1) >> 63;
+            fe_cmov(t.ypx, fe_load(kCombTable[pos][j - 1][0]), equal);
+            fe_cmov(t.ymx, fe_load(kCombTable[pos][j - 1][1]), equal);
+            fe_cmov(t.t2d, fe_load(kCombTable[pos][j - 1][2]), equal);
+        }
+        // -(x,y) = (-x,y): swap y+x with y-x, and negate 2dxy.
+        ge_precomp minus = {t.ymx, t.ypx, fe_neg(t.t2d)};
+        fe_cmov(t.ypx, minus.ypx, negative);
+        fe_cmov(t.ymx, minus.ymx, negative);
+        fe_cmov(t.t2d, minus.t2d, negative);
+        return t;
+    }
+
+    // Mixed addition: like `ge_add`, but `q` has Z = 1.
+    static inline ge ge_madd(const ge &p, const ge_precomp &q) {
+        fe a = fe_mul(fe_sub(p.Y, p.X), q.ymx);
+        fe b = fe_mul(fe_add(p.Y, p.X), q.ypx);
+        fe c = fe_mul(p.T, q.t2d);
+        fe d = fe_add(p.Z, p.Z);
+        fe e = fe_sub(b, a), f = fe_sub(d, c), g = fe_add(d, c), h = fe_add(b, a);
+        return ge{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+    }
+
+    // Returns [scalar]B; the scalar must be less than 2^255.
+    static ge scalarbase(const uint8_t scalar[32]) {
+        // Recode into 64 signed radix-16 digits in [-8, 8]:
+        int8_t e[64];
+        for (int i = 0; i < 32; ++i) {
+            e[2 * i + 0] = (scalar[i] >> 0) & 15;
+            e[2 * i + 1] = (scalar[i] >> 4) & 15;
+        }
+        int8_t carry = 0;
+        for (int i = 0; i < 63; ++i) {
+            e[i] += carry;
+            carry = int8_t((e[i] + 8) >> 4);
+            e[i] -= int8_t(carry * 16);
+        }
+        e[63] += carry;
+
+        // scalar = sum(e[i] * 16^i). The odd digits are multiplied by 16 at the end:
+        ge h = ge_identity();
+        for (int i = 1; i < 64; i += 2)
+            h = ge_madd(h, select(i / 2, e[i]));
+        h = ge_double(ge_double(ge_double(ge_double(h))));
+        for (int i = 0; i < 64; i += 2)
+            h = ge_madd(h, select(i / 2, e[i]));
+        wipe(e, sizeof(e));
+        return h;
+    }
+
+    static void scalarbase_encode(uint8_t point[32], const uint8_t scalar[32]) {
+        ge p = scalarbase(scalar);
+        fe zinv = fe_invert(p.Z);
+        fe x = fe_mul(p.X, zinv);
+        fe_tobytes(point, fe_mul(p.Y, zinv));
+        point[31] ^= uint8_t(fe_isnegative(x) << 7);
+        wipe(&p, sizeof(p));
+    }
+
+
+    //======== SIGNING
+
+
+    // Monocypher's EdDSA, with `Hash` as the 64-byte hash function. (Blake2b for `EdDSA`,
+    // SHA-512 for `Ed25519`.)
+
+    struct blake2b_fns {
+        using context = c::crypto_blake2b_ctx;
+        static void init(context *x)                                {c::crypto_blake2b_init(x, 64);}
+        static void update(context *x, const uint8_t *m, size_t n)  {c::crypto_blake2b_update(x, m, n);}
+        static void final(context *x, uint8_t h[64])                {c::crypto_blake2b_final(x, h);}
+    };
+
+    struct sha512_fns {
+        using context = c::crypto_sha512_ctx;
+        static void init(context *x)                                {c::crypto_sha512_init(x);}
+        static void update(context *x, const uint8_t *m, size_t n)  {c::crypto_sha512_update(x, m, n);}
+        static void final(context *x, uint8_t h[64])                {c::crypto_sha512_final(x, h);}
+    };
+
+    template <class Hash>
+    static void hash_seed(uint8_t a[64], const uint8_t seed[32]) {
+        typename Hash::context ctx;
+        Hash::init(&ctx);
+        Hash::update(&ctx, seed, 32);
+        Hash::final(&ctx, a);
+        c::crypto_eddsa_trim_scalar(a, a);
+        wipe(&ctx, sizeof(ctx));
+    }
+
+    template <class Hash>
+    static void hash_reduce(uint8_t h[32], const uint8_t *a, size_t a_size,
+                            const uint8_t *b, size_t b_size,
+                            const uint8_t *m, size_t m_size) {
+        typename Hash::context ctx;
+        uint8_t hash[64];
+        Hash::init(&ctx);
+        Hash::update(&ctx, a, a_size);
+        Hash::update(&ctx, b, b_size);
+        Hash::update(&ctx, m, m_size);
+        Hash::final(&ctx, hash);
+        c::crypto_eddsa_reduce(h, hash);
+        wipe(hash, sizeof(hash));
+        wipe(&ctx, sizeof(ctx));
+    }
+
+    template <class Hash>
+    static void generate_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]) {
+        uint8_t a[64];
+        ::memcpy(a, seed, 32);
+        wipe(seed, 32);
+        ::memcpy(secret_key, a, 32);
+        hash_seed<Hash>(a, secret_key);
+        scalarbase_encode(secret_key + 32, a);
+        ::memcpy(public_key, secret_key + 32, 32);
+        wipe(a, sizeof(a));
+    }
+
+    template <class Hash>
+    static void sign_message(uint8_t signature[64], const uint8_t secret_key[64],
+                     const uint8_t *message, size_t message_size) {
+        uint8_t a[64];      // secret scalar and prefix
+        uint8_t r[32];      // secret deterministic nonce
+        uint8_t h[32];      // public hash of the message
+        uint8_t R[32];      // first half of the signature (allows overlapping inputs)
+        hash_seed<Hash>(a, secret_key);
+        hash_reduce<Hash>(r, a + 32, 32, message, message_size, nullptr, 0);
+        scalarbase_encode(R, r);
+        hash_reduce<Hash>(h, R, 32, secret_key + 32, 32, message, message_size);
+        ::memcpy(signature, R, 32);
+        c::crypto_eddsa_mul_add(signature + 32, h, a, r);
+        wipe(a, sizeof(a));
+        wipe(r, sizeof(r));
+    }
+
+
+    void eddsa_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]) {
+        generate_key_pair<blake2b_fns>(secret_key, public_key, seed);
+    }
+
+    void eddsa_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                    const uint8_t *message, size_t message_size) {
+        sign_message<blake2b_fns>(signature, secret_key, message, message_size);
+    }
+
+    void ed25519_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]) {
+        generate_key_pair<sha512_fns>(secret_key, public_key, seed);
+    }
+
+    void ed25519_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                      const uint8_t *message, size_t message_size) {
+        sign_message<sha512_fns>(signature, secret_key, message, message_size);
+    }
+
+
+    void x25519_public_key(uint8_t public_key[32], const uint8_t secret_key[32]) {
+        // u = (1 + y) / (1 - y) = (Z + Y) / (Z - Y)
+        uint8_t clamped[32];
+        c::crypto_eddsa_trim_scalar(clamped, secret_key);
+        ge p = scalarbase(clamped);
+        fe_tobytes(public_key, fe_mul(fe_add(p.Z, p.Y), fe_invert(fe_sub(p.Z, p.Y))));
+        wipe(clamped, sizeof(clamped));
+        wipe(&p, sizeof(p));
+    }
+
+
+#else // MONOCYPHER_WIDE_COMB
+
+
+    void eddsa_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]) {
+        c::crypto_eddsa_key_pair(secret_key, public_key, seed);
+    }
+
+    void eddsa_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                    const uint8_t *message, size_t message_size) {
+        c::crypto_eddsa_sign(signature, secret_key, message, message_size);
+    }
+
+    void ed25519_key_pair(uint8_t secret_key[64], uint8_t public_key[32], uint8_t seed[32]) {
+        c::crypto_ed25519_key_pair(secret_key, public_key, seed);
+    }
+
+    void ed25519_sign(uint8_t signature[64], const uint8_t secret_key[64],
+                      const uint8_t *message, size_t message_size) {
+        c::crypto_ed25519_sign(signature, secret_key, message, message_size);
+    }
+
+
+    void x25519_public_key(uint8_t public_key[32], const uint8_t secret_key[32]) {
+        // `crypto_x25519_dirty_fast` adds a low-order point selected by the key's 3 low bits.
+        // X25519 clamping clears those bits anyway, and with them cleared the result is clean.
+        secret_byte_array<32> clamped(secret_key, 32);
+        clamped[0] &= 248;
+        c::crypto_x25519_dirty_fast(public_key, clamped.data());
+    }
+
+#endif // MONOCYPHER_WIDE_COMB
+
+}
@@ -0,0 +1,92 @@
+//
+//  Monocypher+hash_batch.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/hash.hh"
+#include <algorithm>
+
+namespace monocypher {
+    using namespace std;
+
+    // Messages at least this big are hashed individually; smaller ones are grouped into jobs of
+    // up to this many bytes, so each job costs at least a few dozen microseconds.
+    static constexpr size_t kGroupBytes = 64 * 1024;
+
+    // Each thread gets at least this much data to hash.
+    static constexpr size_t kMinBytesPerThread = 256 * 1024;
+
+
+    void schedule_hash_batch(const input_bytes messages[], size_t count, unsigned threads,
+                             hash_batch_fn const& fn)
+    {
+        if (count == 0)
+            return;
+
+        // Longest-first order: the big messages go out first, and the small ones at the end
+        // fill in the gaps. Neighbors are then of similar size, which suits `create_many`.
+        vector<size_t> order(count);
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = i;
+            total += messages[i].size;
+        }
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return messages[a].size > messages[b].size;
+        });
+        vector<input_bytes> sorted;
+        sorted.reserve(count);
+        for (size_t i : order)
+            sorted.push_back(messages[i]);
+
+        // Each job is a range of `order`:
+        vector<size_t> jobs;        // start of each job, plus `count` at the end
+        for (size_t i = 0; i < count; ) {
+            jobs.push_back(i);
+            size_t bytes = sorted[i].size;
+            size_t end = i + 1;
+            if (bytes < kGroupBytes) {
+                while (end < count && end - i < hash_batch_group
+                                   && bytes + sorted[end].size <= kGroupBytes)
+                    bytes += sorted[end++].size;
+            }
+            i = end;
+        }
+        size_t njobs = jobs.size();
+        jobs.push_back(count);
+
+        size_t max_threads = max<size_t>(1, total / kMinBytesPerThread);
+        internal::parallel_for(njobs, threads, max_threads, [&](size_t j) {
+            fn(&order[jobs[j]], &sorted[jobs[j]], jobs[j + 1] - jobs[j]);
+        });
+    }
+
+}
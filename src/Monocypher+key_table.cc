@@ -0,0 +1,295 @@
+//
+//  monocypher/Monocypher+key_table.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/key_table.hh"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    // Allocates memory that's locked into RAM (if allowed) and excluded from core dumps.
+    static void* allocate_secure(size_t &size, bool &locked) {
+#ifndef _WIN32
+        size_t page = size_t(::sysconf(_SC_PAGESIZE));
+        size = (size + page - 1) / page * page;
+        void *mem = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (mem == MAP_FAILED)
+            throw bad_alloc();
+        locked = (::mlock(mem, size) == 0);
+#ifdef MADV_DONTDUMP
+        (void)::madvise(mem, size, MADV_DONTDUMP);
+#endif
+        return mem;
+#else
+        locked = false;
+        return ::operator new(size);
+#endif
+    }
+
+
+    static void free_secure(void *mem, size_t size, bool locked) {
+        c::crypto_wipe(mem, size);
+#ifndef _WIN32
+        if (locked)
+            ::munlock(mem, size);
+        ::munmap(mem, size);
+#else
+        ::operator delete(mem);
+#endif
+    }
+
+
+    static size_t bucket_capacity(size_t max_keys) {
+        size_t capacity = 16;
+        while (capacity < 2 * max_keys)
+            capacity *= 2;
+        return capacity;
+    }
+
+
+    session_key_table::session_key_table()
+    :session_key_table(options{})
+    { }
+
+
+    session_key_table::session_key_table(options const& opts)
+    :_options(opts)
+    {
+        if (_options.max_keys == 0 || _options.max_keys >= kDeleted / 2 || _options.max_readers == 0)
+            throw invalid_argument("invalid session_key_table options");
+        randomize(&_seed, sizeof(_seed));
+
+        // Leave headroom in the pool for retired keys awaiting reclamation:
+        _pool_size = _options.max_keys + _options.max_keys / 4 + 16;
+        _pool_bytes = _pool_size * sizeof(node);
+        _nodes = static_cast<node*>(allocate_secure(_pool_bytes, _locked));
+        _free_nodes.reserve(_pool_size);
+        for (size_t i = _pool_size; i > 0; --i)
+            _free_nodes.push_back(uint32_t(i - 1));
+
+        auto t = new table_array{bucket_capacity(_options.max_keys), nullptr};
+        t->index.reset(new atomic<uint32_t>[t->capacity]);
+        for (size_t i = 0; i < t->capacity; ++i)
+            t->index[i].store(kEmpty, memory_order_relaxed);
+        _table.store(t);
+
+        _readers.reset(new reader_slot[_options.max_readers]);
+    }
+
+
+    session_key_table::~session_key_table() {
+        // Node destructors would only wipe the keys, which `free_secure` does anyway.
+        delete _table.load();
+        free_secure(_nodes, _pool_bytes, _locked);
+    }
+
+
+    size_t session_key_table::size() const {
+        unique_lock<mutex> lock(_mutex);
+        return _count;
+    }
+
+
+    size_t session_key_table::retired_count() const {
+        unique_lock<mutex> lock(_mutex);
+        return _retired_nodes.size();
+    }
+
+
+    size_t session_key_table::find_bucket(table_array *t, uint64_t id) const {
+        size_t mask = t->capacity - 1;
+        for (size_t i = bucket(id), n = 0; n <= mask; ++i, ++n) {
+            uint32_t ni = t->index[i & mask].load(memory_order_relaxed);
+            if (ni == kEmpty)
+                break;
+            else if (ni != kDeleted && node_at(ni)->id == id)
+                return i & mask;
+        }
+        return SIZE_MAX;
+    }
+
+
+    uint32_t session_key_table::allocate_node(uint64_t id, key const& k) {
+        // If the pool is exhausted, wait for the readers to get out of the way so retired nodes
+        // can be reclaimed. (This is bounded: lookups are short and never block.)
+        while (_free_nodes.empty()) {
+            reclaim();
+            if (_free_nodes.empty())
+                this_thread::yield();
+        }
+        uint32_t ni = _free_nodes.back();
+        _free_nodes.pop_back();
+        new (node_at(ni)) node{id, k};
+        return ni;
+    }
+
+
+    void session_key_table::retire_node(uint32_t ni) {
+        _retired_nodes.emplace_back(_epoch.load(), ni);
+    }
+
+
+    bool session_key_table::insert_or_assign(uint64_t id, key const& k) {
+        unique_lock<mutex> lock(_mutex);
+        table_array *t = _table.load();
+        size_t b = find_bucket(t, id);
+        if (b == SIZE_MAX && _count >= _options.max_keys)
+            return false;
+        uint32_t ni = allocate_node(id, k);
+
+        if (b != SIZE_MAX) {
+            // Rotate: publish the new node, retire the old one.
+            retire_node(t->index[b].exchange(ni));
+        } else {
+            // Add to the first free bucket; `find_bucket` showed `id` isn't present.
+            size_t mask = t->capacity - 1;
+            for (size_t i = bucket(id); ; ++i) {
+                uint32_t old = t->index[i & mask].load(memory_order_relaxed);
+                if (old == kEmpty || old == kDeleted) {
+                    if (old == kDeleted)
+                        --_tombstones;
+                    t->index[i & mask].store(ni);
+                    break;
+                }
+            }
+            ++_count;
+            if (_count + _tombstones > t->capacity / 4 * 3)
+                rebuild_table();
+        }
+        reclaim();
+        return true;
+    }
+
+
+    bool session_key_table::erase(uint64_t id) {
+        unique_lock<mutex> lock(_mutex);
+        table_array *t = _table.load();
+        size_t b = find_bucket(t, id);
+        if (b == SIZE_MAX)
+            return false;
+        retire_node(t->index[b].exchange(kDeleted));
+        --_count;
+        ++_tombstones;
+        if (_count + _tombstones > t->capacity / 4 * 3)
+            rebuild_table();
+        reclaim();
+        return true;
+    }
+
+
+    // Copies the live entries into a new, tombstone-free array, and retires the old one.
+    void session_key_table::rebuild_table() {
+        table_array *old = _table.load();
+        auto t = new table_array{old->capacity, nullptr};
+        t->index.reset(new atomic<uint32_t>[t->capacity]);
+        size_t mask = t->capacity - 1;
+        for (size_t i = 0; i < t->capacity; ++i)
+            t->index[i].store(kEmpty, memory_order_relaxed);
+        for (size_t i = 0; i < old->capacity; ++i) {
+            uint32_t ni = old->index[i].load(memory_order_relaxed);
+            if (ni != kEmpty && ni != kDeleted) {
+                size_t j = bucket(node_at(ni)->id);
+                while (t->index[j & mask].load(memory_order_relaxed) != kEmpty)
+                    ++j;
+                t->index[j & mask].store(ni, memory_order_relaxed);
+            }
+        }
+        _table.store(t);
+        _retired_tables.emplace_back(_epoch.load(), old);
+        _tombstones = 0;
+    }
+
+
+    void session_key_table::collect() {
+        unique_lock<mutex> lock(_mutex);
+        reclaim();
+    }
+
+
+    // Starts a new epoch, then frees everything retired in an epoch that no reader is still in.
+    // A reader that enters after this point can't reach anything retired before it.
+    void session_key_table::reclaim() {
+        if (_retired_nodes.empty() && _retired_tables.empty())
+            return;
+        _epoch.fetch_add(1);
+        uint64_t oldest = UINT64_MAX;
+        for (size_t i = 0; i < _options.max_readers; ++i) {
+            if (uint64_t e = _readers[i].epoch.load(); e != 0)
+                oldest = min(oldest, e);
+        }
+
+        auto end = remove_if(_retired_nodes.begin(), _retired_nodes.end(), [&](auto &r) {
+            if (r.first >= oldest)
+                return false;
+            node_at(r.second)->id = 0;
+            node_at(r.second)->~node();             // wipes the key
+            _free_nodes.push_back(r.second);
+            return true;
+        });
+        _retired_nodes.erase(end, _retired_nodes.end());
+
+        _retired_tables.erase(remove_if(_retired_tables.begin(), _retired_tables.end(),
+                                        [&](auto &r) {return r.first < oldest;}),
+                              _retired_tables.end());
+    }
+
+
+    session_key_table::reader::reader(session_key_table &table)
+    :_table(table)
+    ,_slot(nullptr)
+    {
+        for (size_t i = 0; i < table._options.max_readers; ++i) {
+            bool expected = false;
+            if (table._readers[i].in_use.compare_exchange_strong(expected, true)) {
+                _slot = &table._readers[i];
+                return;
+            }
+        }
+        throw runtime_error("too many session_key_table readers");
+    }
+
+
+    session_key_table::reader::~reader() {
+        _slot->in_use.store(false);
+    }
+
+}
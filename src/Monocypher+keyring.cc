@@ -0,0 +1,409 @@
+//
+//  monocypher/Monocypher+keyring.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/keyring.hh"
+#include "monocypher/hash.hh"
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace monocypher::ext {
+    using namespace std;
+
+    static_assert(sizeof(keyring::key) == 32 && alignof(keyring::key) == 1);
+
+
+    // File layout. All integers are little-endian, and all sections start at multiples of 64.
+    //
+    //   header       kHeaderSize bytes (see below)
+    //   key radix    kRadixSize uint32s: radix[p] is the index of the first key whose first two
+    //                bytes (big-endian) are >= p
+    //   keys         count * 32 bytes, sorted
+    //   id radix     kRadixSize uint32s, like the key radix but over the ids
+    //   ids          count * 16 bytes: key_id, uint32 key index, 4 zero bytes; sorted by id
+    //   meta index   (count + 1) uint64s: offsets of each key's metadata in the metadata section
+    //   metadata     meta_size bytes
+
+    static constexpr char     kMagic[8] = {'M','C','K','E','Y','R','N','G'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t   kHeaderSize = 128;
+    static constexpr size_t   kIDRecordSize = 16;
+
+    namespace {
+        struct header {                         // (in host byte order)
+            uint32_t version, count;
+            uint64_t key_radix, keys, id_radix, ids, meta_index, meta, meta_size, file_size;
+        };
+    }
+
+    static uint32_t load32(const uint8_t *p) {
+        return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+    }
+
+    static uint64_t load64(const uint8_t *p) {
+        return load32(p) | uint64_t(load32(p + 4)) << 32;
+    }
+
+    static void store32(uint8_t *p, uint32_t n) {
+        for (int i = 0; i < 4; ++i)
+            p[i] = uint8_t(n >> (8 * i));
+    }
+
+    static void store64(uint8_t *p, uint64_t n) {
+        store32(p, uint32_t(n));
+        store32(p + 4, uint32_t(n >> 32));
+    }
+
+    static uint64_t align64(uint64_t n) {
+        return (n + 63) & ~uint64_t(63);
+    }
+
+    [[noreturn]] static void fail(const char *what) {
+        throw system_error(errno, generic_category(), what);
+    }
+
+    [[noreturn]] static void invalid() {
+        throw runtime_error("invalid keyring file");
+    }
+
+
+    keyring::key_id keyring::id_of(key const& k) {
+        return monocypher::hash<Blake2b<8>>::create(k);
+    }
+
+
+    //======== KEYRING
+
+
+    keyring::keyring(const char *path) {
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            fail("open");
+        struct stat st;
+        if (::fstat(fd, &st) < 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            fail("fstat");
+        }
+        if (st.st_size < off_t(kHeaderSize)) {
+            ::close(fd);
+            invalid();
+        }
+        _map_size = size_t(st.st_size);
+        void *mem = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, fd, 0);
+        int err = errno;
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            errno = err;
+            fail("mmap");
+        }
+        _map = static_cast<const uint8_t*>(mem);
+        // Lookups touch a few scattered pages; readahead would just waste I/O and memory.
+        ::madvise(mem, _map_size, MADV_RANDOM);
+
+        // Parse and validate the header:
+        header h;
+        h.version    = load32(_map + 8);
+        h.count      = load32(_map + 12);
+        h.key_radix  = load64(_map + 16);
+        h.keys       = load64(_map + 24);
+        h.id_radix   = load64(_map + 32);
+        h.ids        = load64(_map + 40);
+        h.meta_index = load64(_map + 48);
+        h.meta       = load64(_map + 56);
+        h.meta_size  = load64(_map + 64);
+        h.file_size  = load64(_map + 72);
+
+        uint64_t const count = h.count;
+        auto in_bounds = [&](uint64_t start, uint64_t size) {
+            return start >= kHeaderSize && start <= _map_size && size <= _map_size - start;
+        };
+        if (::memcmp(_map, kMagic, 8) != 0 || h.version != kVersion || h.file_size != _map_size
+                || !in_bounds(h.key_radix, kRadixSize * 4)
+                || !in_bounds(h.keys, count * 32)
+                || !in_bounds(h.id_radix, kRadixSize * 4)
+                || !in_bounds(h.ids, count * kIDRecordSize)
+                || !in_bounds(h.meta_index, (count + 1) * 8)
+                || !in_bounds(h.meta, h.meta_size)) {
+            ::munmap(mem, _map_size);
+            invalid();
+        }
+        _count      = h.count;
+        _key_radix  = _map + h.key_radix;
+        _keys       = reinterpret_cast<const key*>(_map + h.keys);
+        _id_radix   = _map + h.id_radix;
+        _ids        = _map + h.ids;
+        _meta_index = _map + h.meta_index;
+        _meta       = _map + h.meta;
+        _meta_size  = h.meta_size;
+    }
+
+
+    keyring::~keyring() {
+        if (_map)
+            ::munmap(const_cast<uint8_t*>(_map), _map_size);
+    }
+
+
+    keyring::entry keyring::operator[] (size_t i) const {
+        assert(i < _count);
+        input_bytes metadata {nullptr, 0};
+        uint64_t start = load64(_meta_index + 8 * i), end = load64(_meta_index + 8 * (i + 1));
+        if (start <= end && end <= _meta_size)
+            metadata = {_meta + start, size_t(end - start)};
+        return entry{i, &_keys[i], metadata};
+    }
+
+
+    // Returns the range of indexes in the bucket for the 2-byte prefix.
+    pair<size_t,size_t> keyring::bucket(const uint8_t *radix, const uint8_t *prefix) const {
+        size_t p = size_t(prefix[0]) << 8 | prefix[1];
+        size_t lo = load32(radix + 4 * p), hi = load32(radix + 4 * (p + 1));
+        if (lo > hi || hi > _count)
+            return {0, 0};                      // corrupt index
+        return {lo, hi};
+    }
+
+
+    optional<keyring::entry> keyring::find(key const& k) const {
+        auto [lo, hi] = bucket(_key_radix, k.data());
+        // Binary search in the bucket; with uniformly distributed keys it averages n/65536 keys.
+        // Then finish with a linear scan, which touches memory that's already in cache.
+        while (hi - lo > 8) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (::memcmp(_keys[mid].data(), k.data(), 32) < 0)
+                lo = mid + 1;
+            else
+                hi = mid + 1;
+        }
+        for (; lo < hi; ++lo) {
+            int cmp = ::memcmp(_keys[lo].data(), k.data(), 32);
+            if (cmp == 0)
+                return (*this)[lo];
+            else if (cmp > 0)
+                break;
+        }
+        return nullopt;
+    }
+
+
+    // Returns the index in `_ids` of the first record whose id is >= `id`.
+    size_t keyring::lower_bound_id(key_id const& id) const {
+        auto [lo, hi] = bucket(_id_radix, id.data());
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (::memcmp(_ids + mid * kIDRecordSize, id.data(), 8) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+
+    optional<keyring::entry> keyring::find(key_id const& id) const {
+        auto all = find_all(id);
+        if (all.empty())
+            return nullopt;
+        return all.front();
+    }
+
+
+    vector<keyring::entry> keyring::find_all(key_id const& id) const {
+        vector<entry> result;
+        for (size_t i = lower_bound_id(id); i < _count; ++i) {
+            const uint8_t *record = _ids + i * kIDRecordSize;
+            if (::memcmp(record, id.data(), 8) != 0)
+                break;
+            uint32_t index = load32(record + 8);
+            if (index < _count)
+                result.push_back((*this)[index]);
+        }
+        return result;
+    }
+
+
+    //======== BUILDER
+
+
+    void keyring::builder::add(key const& k, input_bytes metadata) {
+        if (metadata.size > UINT32_MAX)
+            throw invalid_argument("keyring metadata too large");
+        if (_keys.size() >= UINT32_MAX)
+            throw invalid_argument("too many keys for a keyring");
+        _keys.push_back({k, _metadata.size(), uint32_t(metadata.size)});
+        _metadata.insert(_metadata.end(), metadata.data, metadata.data + metadata.size);
+    }
+
+
+    void keyring::builder::write(const char *path) const {
+        // Sort the keys, checking for duplicates:
+        size_t const count = _keys.size();
+        vector<uint32_t> order(count);
+        for (size_t i = 0; i < count; ++i)
+            order[i] = uint32_t(i);
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return ::memcmp(_keys[a].k.data(), _keys[b].k.data(), 32) < 0;
+        });
+        for (size_t i = 1; i < count; ++i) {
+            if (_keys[order[i-1]].k == _keys[order[i]].k)
+                throw invalid_argument("duplicate key in keyring");
+        }
+
+        // The id records, sorted by id:
+        vector<uint8_t> ids(count * kIDRecordSize, 0);
+        for (size_t i = 0; i < count; ++i) {
+            auto id = id_of(_keys[order[i]].k);
+            ::memcpy(&ids[i * kIDRecordSize], id.data(), 8);
+            store32(&ids[i * kIDRecordSize + 8], uint32_t(i));
+        }
+        {
+            vector<uint32_t> id_order(count);
+            for (size_t i = 0; i < count; ++i)
+                id_order[i] = uint32_t(i);
+            sort(id_order.begin(), id_order.end(), [&](uint32_t a, uint32_t b) {
+                return ::memcmp(&ids[a * kIDRecordSize], &ids[b * kIDRecordSize], 12) < 0;
+            });
+            vector<uint8_t> sorted(ids.size());
+            for (size_t i = 0; i < count; ++i)
+                ::memcpy(&sorted[i * kIDRecordSize], &ids[id_order[i] * kIDRecordSize],
+                         kIDRecordSize);
+            ids.swap(sorted);
+        }
+
+        auto make_radix = [&](auto prefix_of) {
+            vector<uint8_t> radix(kRadixSize * 4);
+            size_t i = 0;
+            for (size_t p = 0; p < kRadixSize; ++p) {
+                while (i < count && prefix_of(i) < p)
+                    ++i;
+                store32(&radix[4 * p], uint32_t(i));
+            }
+            return radix;
+        };
+        auto key_radix = make_radix([&](size_t i) {
+            auto k = _keys[order[i]].k.data();
+            return size_t(k[0]) << 8 | k[1];
+        });
+        auto id_radix = make_radix([&](size_t i) {
+            auto id = &ids[i * kIDRecordSize];
+            return size_t(id[0]) << 8 | id[1];
+        });
+
+        // Lay out the sections:
+        header h;
+        h.version    = kVersion;
+        h.count      = uint32_t(count);
+        h.key_radix  = kHeaderSize;
+        h.keys       = align64(h.key_radix + kRadixSize * 4);
+        h.id_radix   = align64(h.keys + count * 32);
+        h.ids        = align64(h.id_radix + kRadixSize * 4);
+        h.meta_index = align64(h.ids + count * kIDRecordSize);
+        h.meta       = align64(h.meta_index + (count + 1) * 8);
+        h.meta_size  = _metadata.size();
+        h.file_size  = h.meta + h.meta_size;
+
+        uint8_t hdr[kHeaderSize] = {};
+        ::memcpy(hdr, kMagic, 8);
+        store32(hdr + 8, h.version);
+        store32(hdr + 12, h.count);
+        store64(hdr + 16, h.key_radix);
+        store64(hdr + 24, h.keys);
+        store64(hdr + 32, h.id_radix);
+        store64(hdr + 40, h.ids);
+        store64(hdr + 48, h.meta_index);
+        store64(hdr + 56, h.meta);
+        store64(hdr + 64, h.meta_size);
+        store64(hdr + 72, h.file_size);
+
+        // Write to a temporary file, then rename it into place:
+        string tmp_path = string(path) + ".tmp";
+        FILE *out = ::fopen(tmp_path.c_str(), "wb");
+        if (!out)
+            fail("fopen");
+        uint64_t pos = 0;
+        bool ok = true;
+        auto put = [&](uint64_t offset, const void *data, size_t size) {
+            static constexpr uint8_t kZeros[64] = {};
+            assert(offset >= pos && offset - pos < 64);
+            ok = ok && ::fwrite(kZeros, 1, offset - pos, out) == offset - pos;
+            ok = ok && (size == 0 || ::fwrite(data, 1, size, out) == size);
+            pos = offset + size;
+        };
+        put(0, hdr, sizeof(hdr));
+        put(h.key_radix, key_radix.data(), key_radix.size());
+        {
+            vector<uint8_t> keys(count * 32);
+            for (size_t i = 0; i < count; ++i)
+                ::memcpy(&keys[32 * i], _keys[order[i]].k.data(), 32);
+            put(h.keys, keys.data(), keys.size());
+        }
+        put(h.id_radix, id_radix.data(), id_radix.size());
+        put(h.ids, ids.data(), ids.size());
+        {
+            // The metadata is written in sorted key order too, so it's contiguous:
+            vector<uint8_t> index((count + 1) * 8);
+            uint64_t offset = 0;
+            for (size_t i = 0; i < count; ++i) {
+                store64(&index[8 * i], offset);
+                offset += _keys[order[i]].meta_size;
+            }
+            store64(&index[8 * count], offset);
+            put(h.meta_index, index.data(), index.size());
+            put(h.meta, nullptr, 0);
+            for (size_t i = 0; i < count; ++i) {
+                auto &item = _keys[order[i]];
+                put(pos, _metadata.data() + item.meta_start, item.meta_size);
+            }
+        }
+        ok = ok && ::fflush(out) == 0 && ::fsync(::fileno(out)) == 0;
+        int err = errno;
+        ::fclose(out);
+        if (!ok || ::rename(tmp_path.c_str(), path) != 0) {
+            if (ok)
+                err = errno;
+            ::unlink(tmp_path.c_str());
+            errno = err;
+            fail("writing keyring");
+        }
+    }
+
+}
@@ -0,0 +1,1085 @@
+//
+//  monocypher/Monocypher+mlkem.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/mlkem.hh"
+#include "monocypher/key_exchange.hh"
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#   define MLKEM_AVX2 1
+#   include <immintrin.h>
+#endif
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    //======== KECCAK (SHA-3 and SHAKE)
+
+
+    namespace {
+        // A Keccak-f[1600] sponge, byte-oriented.
+        class keccak {
+        public:
+            // `rate` is the block size in bytes; `pad` is the domain-separation byte:
+            // 0x06 for SHA-3, 0x1F for SHAKE.
+            keccak(size_t rate, uint8_t pad)       :_rate(rate), _pad(pad) { }
+            ~keccak()                              {wipe(_state, sizeof(_state));}
+
+            void absorb(const uint8_t *in, size_t size) {
+                while (size > 0) {
+                    size_t n = min(size, _rate - _pos);
+                    size_t i = 0;
+                    for (; i < n && _pos % 8 != 0; ++i, ++_pos)
+                        _state[_pos / 8] ^= uint64_t(in[i]) << (8 * (_pos % 8));
+                    for (; i + 8 <= n; i += 8, _pos += 8)
+                        _state[_pos / 8] ^= load64(in + i);
+                    for (; i < n; ++i, ++_pos)
+                        _state[_pos / 8] ^= uint64_t(in[i]) << (8 * (_pos % 8));
+                    in += n;
+                    size -= n;
+                    if (_pos == _rate) {
+                        permute();
+                        _pos = 0;
+                    }
+                }
+            }
+
+            void finish() {
+                _state[_pos / 8] ^= uint64_t(_pad) << (8 * (_pos % 8));
+                _state[(_rate - 1) / 8] ^= uint64_t(0x80) << (8 * ((_rate - 1) % 8));
+                permute();
+                _pos = 0;
+            }
+
+            void squeeze(uint8_t *out, size_t size) {
+                while (size > 0) {
+                    if (_pos == _rate) {
+                        permute();
+                        _pos = 0;
+                    }
+                    size_t n = min(size, _rate - _pos);
+                    size_t i = 0;
+                    for (; i < n && _pos % 8 != 0; ++i, ++_pos)
+                        out[i] = uint8_t(_state[_pos / 8] >> (8 * (_pos % 8)));
+                    for (; i + 8 <= n; i += 8, _pos += 8)
+                        store64(out + i, _state[_pos / 8]);
+                    for (; i < n; ++i, ++_pos)
+                        out[i] = uint8_t(_state[_pos / 8] >> (8 * (_pos % 8)));
+                    out += n;
+                    size -= n;
+                }
+            }
+
+        private:
+            static uint64_t rotl(uint64_t x, unsigned n) {return (x << n) | (x >> (64 - n));}
+
+            static uint64_t load64(const uint8_t *p) {
+                uint64_t n = 0;
+                for (int i = 7; i >= 0; --i)
+                    n = (n << 8) | p[i];
+                return n;
+            }
+
+            static void store64(uint8_t *p, uint64_t n) {
+                for (int i = 0; i < 8; ++i, n >>= 8)
+                    p[i] = uint8_t(n);
+            }
+
+            void permute() {
+                static constexpr uint64_t kRoundConstants[24] = {
+                    0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+                    0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+                    0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+                    0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+                    0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+                    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+                };
+                // (Unrolled; the rho rotations and pi permutation are folded into constants.)
+                uint64_t a[25];
+                ::memcpy(a, _state, sizeof(a));
+                for (int round = 0; round < 24; ++round) {
+                    // Theta
+                    uint64_t c0 = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+                    uint64_t c1 = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+                    uint64_t c2 = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+                    uint64_t c3 = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+                    uint64_t c4 = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+                    uint64_t d0 = c4 ^ rotl(c1, 1);
+                    uint64_t d1 = c0 ^ rotl(c2, 1);
+                    uint64_t d2 = c1 ^ rotl(c3, 1);
+                    uint64_t d3 = c2 ^ rotl(c4, 1);
+                    uint64_t d4 = c3 ^ rotl(c0, 1);
+                    a[0] ^= d0; a[1] ^= d1; a[2] ^= d2; a[3] ^= d3; a[4] ^= d4;
+                    a[5] ^= d0; a[6] ^= d1; a[7] ^= d2; a[8] ^= d3; a[9] ^= d4;
+                    a[10] ^= d0; a[11] ^= d1; a[12] ^= d2; a[13] ^= d3; a[14] ^= d4;
+                    a[15] ^= d0; a[16] ^= d1; a[17] ^= d2; a[18] ^= d3; a[19] ^= d4;
+                    a[20] ^= d0; a[21] ^= d1; a[22] ^= d2; a[23] ^= d3; a[24] ^= d4;
+                    // Rho and pi
+                    uint64_t b[25];
+                    b[0] = a[0];
+                    b[10] = rotl(a[1], 1);
+                    b[7] = rotl(a[10], 3);
+                    b[11] = rotl(a[7], 6);
+                    b[17] = rotl(a[11], 10);
+                    b[18] = rotl(a[17], 15);
+                    b[3] = rotl(a[18], 21);
+                    b[5] = rotl(a[3], 28);
+                    b[16] = rotl(a[5], 36);
+                    b[8] = rotl(a[16], 45);
+                    b[21] = rotl(a[8], 55);
+                    b[24] = rotl(a[21], 2);
+                    b[4] = rotl(a[24], 14);
+                    b[15] = rotl(a[4], 27);
+                    b[23] = rotl(a[15], 41);
+                    b[19] = rotl(a[23], 56);
+                    b[13] = rotl(a[19], 8);
+                    b[12] = rotl(a[13], 25);
+                    b[2] = rotl(a[12], 43);
+                    b[20] = rotl(a[2], 62);
+                    b[14] = rotl(a[20], 18);
+                    b[22] = rotl(a[14], 39);
+                    b[9] = rotl(a[22], 61);
+                    b[6] = rotl(a[9], 20);
+                    b[1] = rotl(a[6], 44);
+                    // Chi
+                    a[0] = b[0] ^ (~b[1] & b[2]);
+                    a[1] = b[1] ^ (~b[2] & b[3]);
+                    a[2] = b[2] ^ (~b[3] & b[4]);
+                    a[3] = b[3] ^ (~b[4] & b[0]);
+                    a[4] = b[4] ^ (~b[0] & b[1]);
+                    a[5] = b[5] ^ (~b[6] & b[7]);
+                    a[6] = b[6] ^ (~b[7] & b[8]);
+                    a[7] = b[7] ^ (~b[8] & b[9]);
+                    a[8] = b[8] ^ (~b[9] & b[5]);
+                    a[9] = b[9] ^ (~b[5] & b[6]);
+                    a[10] = b[10] ^ (~b[11] & b[12]);
+                    a[11] = b[11] ^ (~b[12] & b[13]);
+                    a[12] = b[12] ^ (~b[13] & b[14]);
+                    a[13] = b[13] ^ (~b[14] & b[10]);
+                    a[14] = b[14] ^ (~b[10] & b[11]);
+                    a[15] = b[15] ^ (~b[16] & b[17]);
+                    a[16] = b[16] ^ (~b[17] & b[18]);
+                    a[17] = b[17] ^ (~b[18] & b[19]);
+                    a[18] = b[18] ^ (~b[19] & b[15]);
+                    a[19] = b[19] ^ (~b[15] & b[16]);
+                    a[20] = b[20] ^ (~b[21] & b[22]);
+                    a[21] = b[21] ^ (~b[22] & b[23]);
+                    a[22] = b[22] ^ (~b[23] & b[24]);
+                    a[23] = b[23] ^ (~b[24] & b[20]);
+                    a[24] = b[24] ^ (~b[20] & b[21]);
+                    a[0] ^= kRoundConstants[round];
+                }
+                ::memcpy(_state, a, sizeof(a));
+            }
+
+            uint64_t _state[25] = {};
+            size_t   _rate;
+            size_t   _pos = 0;
+            uint8_t  _pad;
+        };
+
+        struct sha3_256 : keccak  {sha3_256() :keccak(136, 0x06) { }};
+        struct sha3_512 : keccak  {sha3_512() :keccak(72, 0x06) { }};
+        struct shake128 : keccak  {shake128() :keccak(168, 0x1F) { }};
+        struct shake256 : keccak  {shake256() :keccak(136, 0x1F) { }};
+
+        template <class Sponge>
+        void sponge(uint8_t *out, size_t out_size,
+                    initializer_list<pair<const uint8_t*,size_t>> inputs)
+        {
+            Sponge s;
+            for (auto [data, size] : inputs)
+                s.absorb(data, size);
+            s.finish();
+            s.squeeze(out, out_size);
+        }
+    }
+
+
+    //======== FIELD ARITHMETIC
+
+
+    // Coefficients are int16s mod q. Multiplication uses Montgomery reduction with R = 2^16;
+    // values are kept in the range where intermediate products can't overflow.
+
+    static constexpr int     K = 3;                 // ML-KEM-768 module rank
+    static constexpr int16_t Q = 3329;
+    static constexpr int16_t QInv = -3327;          // q^-1 mod 2^16
+    static constexpr int     PolyBytes = 384;       // 256 12-bit coefficients
+    static constexpr int     DU = 10, DV = 4;
+    static constexpr size_t  PolyVecCompressedBytes = K * 32 * DU;
+
+    static constexpr int32_t modq(int64_t x)       {return int32_t(((x % Q) + Q) % Q);}
+
+    static constexpr int16_t kMont = int16_t(modq(int64_t(1) << 16));           // R mod q
+    static constexpr int16_t kMontSquared = int16_t(modq(int64_t(kMont) * kMont));
+
+    static constexpr int32_t powmodq(int32_t base, unsigned exp) {
+        int64_t result = 1;
+        for (unsigned i = 0; i < exp; ++i)
+            result = result * base % Q;
+        return int32_t(result);
+    }
+
+    static constexpr unsigned bitrev7(unsigned i) {
+        unsigned r = 0;
+        for (int b = 0; b < 7; ++b)
+            r |= ((i >> b) & 1) << (6 - b);
+        return r;
+    }
+
+    // Montgomery form of x, centered in (-q/2, q/2].
+    static constexpr int16_t to_mont_centered(int32_t x) {
+        int32_t m = modq(int64_t(x) * kMont);
+        return int16_t(m > Q / 2 ? m - Q : m);
+    }
+
+    struct zeta_tables {
+        int16_t zetas[128];         // 17^bitrev7(i), for the NTT layers
+        int16_t gammas[128];        // 17^(2*bitrev7(i)+1), for base-case multiplication
+        constexpr zeta_tables() :zetas(), gammas() {
+            for (unsigned i = 0; i < 128; ++i) {
+                zetas[i]  = to_mont_centered(powmodq(17, bitrev7(i)));
+                gammas[i] = to_mont_centered(powmodq(17, 2 * bitrev7(i) + 1));
+            }
+        }
+    };
+
+    static constexpr zeta_tables kZetas;
+
+    // Scaling factor at the end of the inverse NTT: R^2/128 (see `invntt`).
+    static constexpr int16_t kInvNTTScale = int16_t(modq(int64_t(kMontSquared) * powmodq(128, Q - 2)));
+
+
+    // Returns a * R^-1 mod q, in (-q, q), given |a| < q * 2^15.
+    static inline int16_t montgomery_reduce(int32_t a) {
+        int16_t t = int16_t(int16_t(a) * QInv);
+        return int16_t((a - int32_t(t) * Q) >> 16);
+    }
+
+    static inline int16_t fqmul(int16_t a, int16_t b) {
+        return montgomery_reduce(int32_t(a) * b);
+    }
+
+    // Returns a value congruent to a mod q, in [0, q].
+    static inline int16_t barrett_reduce(int16_t a) {
+        int16_t t = int16_t((int32_t(a) * 20159) >> 26);
+        return int16_t(a - t * Q);
+    }
+
+    // Returns the representative of a in [0, q), given a in [-q, 2q).
+    static inline uint16_t canonical(int16_t a) {
+        a = int16_t(a + ((a >> 15) & Q));
+        a = int16_t(a - Q);
+        a = int16_t(a + ((a >> 15) & Q));
+        return uint16_t(a);
+    }
+
+
+    //======== POLYNOMIALS
+
+
+    namespace {
+        struct alignas(32) poly {
+            int16_t c[256];
+        };
+        using polyvec = poly[K];
+    }
+
+
+    static void poly_reduce_portable(poly &p) {
+        for (auto &c : p.c)
+            c = barrett_reduce(c);
+    }
+
+    // In-place forward NTT; output coefficients are reduced.
+    static void poly_ntt_portable(poly &p) {
+        int16_t *f = p.c;
+        unsigned k = 1;
+        for (unsigned len = 128; len >= 2; len >>= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                int16_t zeta = kZetas.zetas[k++];
+                for (unsigned j = start; j < start + len; ++j) {
+                    int16_t t = fqmul(zeta, f[j + len]);
+                    f[j + len] = int16_t(f[j] - t);
+                    f[j] = int16_t(f[j] + t);
+                }
+            }
+        }
+        poly_reduce_portable(p);
+    }
+
+    // In-place inverse NTT, which also multiplies by R (compensating for the R^-1 introduced by
+    // `poly_basemul_acc`.) Input must be reduced.
+    static void poly_invntt_portable(poly &p) {
+        int16_t *f = p.c;
+        unsigned k = 127;
+        for (unsigned len = 2; len <= 128; len <<= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                int16_t zeta = kZetas.zetas[k--];
+                for (unsigned j = start; j < start + len; ++j) {
+                    int16_t t = f[j];
+                    f[j] = barrett_reduce(int16_t(t + f[j + len]));
+                    f[j + len] = fqmul(zeta, int16_t(f[j + len] - t));
+                }
+            }
+        }
+        for (auto &c : p.c)
+            c = fqmul(c, kInvNTTScale);
+    }
+
+
+#ifdef MLKEM_AVX2
+    // AVX2 versions of the NTTs, processing 16 coefficients per instruction. The arithmetic is
+    // exactly the same as the portable code's, so the results are bit-identical.
+
+    __attribute__((target("avx2")))
+    static inline __m256i fqmul_avx2(__m256i a, __m256i b) {
+        __m256i lo = _mm256_mullo_epi16(a, b);
+        __m256i hi = _mm256_mulhi_epi16(a, b);
+        __m256i t  = _mm256_mullo_epi16(lo, _mm256_set1_epi16(QInv));
+        return _mm256_sub_epi16(hi, _mm256_mulhi_epi16(t, _mm256_set1_epi16(Q)));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i barrett_avx2(__m256i a) {
+        __m256i t = _mm256_srai_epi16(_mm256_mulhi_epi16(a, _mm256_set1_epi16(20159)), 10);
+        return _mm256_sub_epi16(a, _mm256_mullo_epi16(t, _mm256_set1_epi16(Q)));
+    }
+
+    // Loads 8 coefficients at `lo` and 8 at `hi` into one vector.
+    __attribute__((target("avx2")))
+    static inline __m256i load_halves(const int16_t *lo, const int16_t *hi) {
+        return _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)lo)),
+                    _mm_loadu_si128((const __m128i*)hi), 1);
+    }
+
+    __attribute__((target("avx2")))
+    static inline void store_halves(int16_t *lo, int16_t *hi, __m256i v) {
+        _mm_storeu_si128((__m128i*)lo, _mm256_castsi256_si128(v));
+        _mm_storeu_si128((__m128i*)hi, _mm256_extracti128_si256(v, 1));
+    }
+
+    __attribute__((target("avx2")))
+    static void poly_reduce_avx2(poly &p) {
+        for (unsigned j = 0; j < 256; j += 16) {
+            __m256i *v = (__m256i*)&p.c[j];
+            _mm256_store_si256(v, barrett_avx2(_mm256_load_si256(v)));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void poly_ntt_avx2(poly &p) {
+        int16_t *f = p.c;
+        unsigned k = 1;
+        // Layers with len >= 16: each butterfly group spans whole vectors.
+        for (unsigned len = 128; len >= 16; len >>= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                __m256i zeta = _mm256_set1_epi16(kZetas.zetas[k++]);
+                for (unsigned j = start; j < start + len; j += 16) {
+                    __m256i a = _mm256_load_si256((const __m256i*)&f[j]);
+                    __m256i b = _mm256_load_si256((const __m256i*)&f[j + len]);
+                    __m256i t = fqmul_avx2(zeta, b);
+                    _mm256_store_si256((__m256i*)&f[j + len], _mm256_sub_epi16(a, t));
+                    _mm256_store_si256((__m256i*)&f[j], _mm256_add_epi16(a, t));
+                }
+            }
+        }
+        // len == 8: do two groups at once, one per 128-bit lane.
+        for (unsigned start = 0; start < 256; start += 32, k += 2) {
+            __m256i zeta = _mm256_inserti128_si256(
+                                _mm256_set1_epi16(kZetas.zetas[k]),
+                                _mm_set1_epi16(kZetas.zetas[k + 1]), 1);
+            __m256i a = load_halves(&f[start], &f[start + 16]);
+            __m256i b = load_halves(&f[start + 8], &f[start + 24]);
+            __m256i t = fqmul_avx2(zeta, b);
+            store_halves(&f[start + 8], &f[start + 24], _mm256_sub_epi16(a, t));
+            store_halves(&f[start], &f[start + 16], _mm256_add_epi16(a, t));
+        }
+        // len == 4 and 2 are scalar.
+        for (unsigned len = 4; len >= 2; len >>= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                int16_t zeta = kZetas.zetas[k++];
+                for (unsigned j = start; j < start + len; ++j) {
+                    int16_t t = fqmul(zeta, f[j + len]);
+                    f[j + len] = int16_t(f[j] - t);
+                    f[j] = int16_t(f[j] + t);
+                }
+            }
+        }
+        poly_reduce_avx2(p);
+    }
+
+    __attribute__((target("avx2")))
+    static void poly_invntt_avx2(poly &p) {
+        int16_t *f = p.c;
+        unsigned k = 127;
+        for (unsigned len = 2; len <= 4; len <<= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                int16_t zeta = kZetas.zetas[k--];
+                for (unsigned j = start; j < start + len; ++j) {
+                    int16_t t = f[j];
+                    f[j] = barrett_reduce(int16_t(t + f[j + len]));
+                    f[j + len] = fqmul(zeta, int16_t(f[j + len] - t));
+                }
+            }
+        }
+        for (unsigned start = 0; start < 256; start += 32, k -= 2) {
+            __m256i zeta = _mm256_inserti128_si256(
+                                _mm256_set1_epi16(kZetas.zetas[k]),
+                                _mm_set1_epi16(kZetas.zetas[k - 1]), 1);
+            __m256i a = load_halves(&f[start], &f[start + 16]);
+            __m256i b = load_halves(&f[start + 8], &f[start + 24]);
+            store_halves(&f[start], &f[start + 16], barrett_avx2(_mm256_add_epi16(a, b)));
+            store_halves(&f[start + 8], &f[start + 24], fqmul_avx2(zeta, _mm256_sub_epi16(b, a)));
+        }
+        for (unsigned len = 16; len <= 128; len <<= 1) {
+            for (unsigned start = 0; start < 256; start += 2 * len) {
+                __m256i zeta = _mm256_set1_epi16(kZetas.zetas[k--]);
+                for (unsigned j = start; j < start + len; j += 16) {
+                    __m256i a = _mm256_load_si256((const __m256i*)&f[j]);
+                    __m256i b = _mm256_load_si256((const __m256i*)&f[j + len]);
+                    _mm256_store_si256((__m256i*)&f[j], barrett_avx2(_mm256_add_epi16(a, b)));
+                    _mm256_store_si256((__m256i*)&f[j + len],
+                                       fqmul_avx2(zeta, _mm256_sub_epi16(b, a)));
+                }
+            }
+        }
+        __m256i scale = _mm256_set1_epi16(kInvNTTScale);
+        for (unsigned j = 0; j < 256; j += 16) {
+            __m256i *v = (__m256i*)&f[j];
+            _mm256_store_si256(v, fqmul_avx2(_mm256_load_si256(v), scale));
+        }
+    }
+
+    static bool cpu_has_avx2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+    static atomic<bool> sUseAVX2 {cpu_has_avx2()};
+
+    bool ML_KEM_768::set_simd_enabled(bool enabled) {
+        sUseAVX2 = enabled && cpu_has_avx2();
+        return sUseAVX2;
+    }
+
+    static void poly_ntt(poly &p) {
+        if (sUseAVX2.load(memory_order_relaxed))
+            poly_ntt_avx2(p);
+        else
+            poly_ntt_portable(p);
+    }
+
+    static void poly_invntt(poly &p) {
+        if (sUseAVX2.load(memory_order_relaxed))
+            poly_invntt_avx2(p);
+        else
+            poly_invntt_portable(p);
+    }
+
+    static void poly_reduce(poly &p) {
+        if (sUseAVX2.load(memory_order_relaxed))
+            poly_reduce_avx2(p);
+        else
+            poly_reduce_portable(p);
+    }
+
+#else
+    bool ML_KEM_768::set_simd_enabled(bool)         {return false;}
+    static void poly_ntt(poly &p)                   {poly_ntt_portable(p);}
+    static void poly_invntt(poly &p)                {poly_invntt_portable(p);}
+    static void poly_reduce(poly &p)                {poly_reduce_portable(p);}
+#endif
+
+
+    // r = sum of a[i] * b[i] in the NTT domain, times R^-1; reduced.
+    static void polyvec_basemul_acc(poly &r, polyvec const& a, polyvec const& b) {
+        for (int n = 0; n < 128; ++n) {
+            int16_t gamma = kZetas.gammas[n];
+            int32_t c0 = 0, c1 = 0;
+            for (int i = 0; i < K; ++i) {
+                int16_t a0 = a[i].c[2*n], a1 = a[i].c[2*n + 1];
+                int16_t b0 = b[i].c[2*n], b1 = b[i].c[2*n + 1];
+                c0 += fqmul(fqmul(a1, b1), gamma) + fqmul(a0, b0);
+                c1 += fqmul(a0, b1) + fqmul(a1, b0);
+            }
+            r.c[2*n]     = int16_t(c0);         // |c| < 6q, so these fit
+            r.c[2*n + 1] = int16_t(c1);
+        }
+        poly_reduce(r);
+    }
+
+    static void poly_add(poly &r, poly const& a) {
+        for (int i = 0; i < 256; ++i)
+            r.c[i] = int16_t(r.c[i] + a.c[i]);
+    }
+
+
+    //======== ENCODING & SAMPLING
+
+
+    static void poly_to_bytes(uint8_t out[PolyBytes], poly const& p) {
+        for (int i = 0; i < 128; ++i) {
+            uint16_t t0 = canonical(barrett_reduce(p.c[2*i]));
+            uint16_t t1 = canonical(barrett_reduce(p.c[2*i + 1]));
+            out[3*i]     = uint8_t(t0);
+            out[3*i + 1] = uint8_t((t0 >> 8) | (t1 << 4));
+            out[3*i + 2] = uint8_t(t1 >> 4);
+        }
+    }
+
+    // Decodes 12-bit coefficients (not reduced mod q.)
+    static void poly_from_bytes(poly &p, const uint8_t in[PolyBytes]) {
+        for (int i = 0; i < 128; ++i) {
+            p.c[2*i]     = int16_t((in[3*i] | (in[3*i + 1] << 8)) & 0xFFF);
+            p.c[2*i + 1] = int16_t((in[3*i + 1] >> 4) | (in[3*i + 2] << 4));
+        }
+    }
+
+    // Compress_d: round(x * 2^d / q) mod 2^d, for x in [0,q). Uses a multiplication instead of
+    // a division by q, which isn't constant-time on all CPUs.
+    static inline uint32_t compress(uint16_t x, int d) {
+        uint64_t t = (uint64_t(x) << d) + Q / 2;
+        return uint32_t((t * 1290168) >> 32) & ((1u << d) - 1);     // 1290168 ~ 2^32 / q
+    }
+
+    static inline int16_t decompress(uint32_t y, int d) {
+        return int16_t((y * Q + (1u << (d - 1))) >> d);
+    }
+
+    // Packs `d`-bit values little-endian.
+    static void pack_bits(uint8_t *out, const uint32_t *values, size_t count, int d) {
+        uint64_t acc = 0;
+        int bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            acc |= uint64_t(values[i]) << bits;
+            bits += d;
+            while (bits >= 8) {
+                *out++ = uint8_t(acc);
+                acc >>= 8;
+                bits -= 8;
+            }
+        }
+    }
+
+    static void unpack_bits(uint32_t *values, const uint8_t *in, size_t count, int d) {
+        uint64_t acc = 0;
+        int bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            while (bits < d) {
+                acc |= uint64_t(*in++) << bits;
+                bits += 8;
+            }
+            values[i] = uint32_t(acc & ((1u << d) - 1));
+            acc >>= d;
+            bits -= d;
+        }
+    }
+
+    static void poly_compress(uint8_t *out, poly const& p, int d) {
+        uint32_t values[256];
+        for (int i = 0; i < 256; ++i)
+            values[i] = compress(canonical(barrett_reduce(p.c[i])), d);
+        pack_bits(out, values, 256, d);
+    }
+
+    static void poly_decompress(poly &p, const uint8_t *in, int d) {
+        uint32_t values[256];
+        unpack_bits(values, in, 256, d);
+        for (int i = 0; i < 256; ++i)
+            p.c[i] = decompress(values[i], d);
+    }
+
+    // Rejection sampling for SampleNTT: parses 12-bit candidates from `buf` (a multiple of 3
+    // bytes), appending those less than q to `p` until it has 256. Returns the new count.
+    static int rej_uniform(poly &p, int n, const uint8_t *buf, size_t size) {
+        for (size_t pos = 0; pos < size && n < 256; pos += 3) {
+            uint16_t d1 = uint16_t(buf[pos] | ((buf[pos + 1] & 0x0F) << 8));
+            uint16_t d2 = uint16_t((buf[pos + 1] >> 4) | (buf[pos + 2] << 4));
+            if (d1 < Q)
+                p.c[n++] = int16_t(d1);
+            if (d2 < Q && n < 256)
+                p.c[n++] = int16_t(d2);
+        }
+        return n;
+    }
+
+    static constexpr size_t Shake128Rate = 168;     // a multiple of 3 bytes
+
+    // SampleNTT: rejection-samples uniform coefficients from SHAKE128(rho || j || i).
+    static void sample_ntt(poly &p, const uint8_t rho[32], uint8_t j, uint8_t i) {
+        shake128 xof;
+        uint8_t ji[2] = {j, i};
+        xof.absorb(rho, 32);
+        xof.absorb(ji, 2);
+        xof.finish();
+        uint8_t buf[Shake128Rate];
+        for (int n = 0; n < 256; ) {
+            xof.squeeze(buf, sizeof(buf));
+            n = rej_uniform(p, n, buf, sizeof(buf));
+        }
+    }
+
+
+#ifdef MLKEM_AVX2
+    // Generating the matrix is the most expensive part of ML-KEM, so with AVX2 it's done with
+    // four SHAKE128 instances at once, one per 64-bit lane of each vector.
+
+    __attribute__((target("avx2")))
+    static inline __m256i rotl_x4(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i xor5_x4(__m256i a, __m256i b, __m256i c, __m256i d, __m256i e) {
+        return _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(c, d)), e);
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256i chi_x4(__m256i a, __m256i b, __m256i c) {
+        return _mm256_xor_si256(a, _mm256_andnot_si256(b, c));
+    }
+
+    __attribute__((target("avx2")))
+    static void keccak_permute_x4(__m256i a[25]) {
+        static constexpr uint64_t kRoundConstants[24] = {
+            0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+            0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+            0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+            0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+            0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+            0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+        };
+        for (int round = 0; round < 24; ++round) {
+                __m256i c0 = xor5_x4(a[0], a[5], a[10], a[15], a[20]);
+                __m256i c1 = xor5_x4(a[1], a[6], a[11], a[16], a[21]);
+                __m256i c2 = xor5_x4(a[2], a[7], a[12], a[17], a[22]);
+                __m256i c3 = xor5_x4(a[3], a[8], a[13], a[18], a[23]);
+                __m256i c4 = xor5_x4(a[4], a[9], a[14], a[19], a[24]);
+                __m256i d0 = _mm256_xor_si256(c4, rotl_x4(c1, 1));
+                __m256i d1 = _mm256_xor_si256(c0, rotl_x4(c2, 1));
+                __m256i d2 = _mm256_xor_si256(c1, rotl_x4(c3, 1));
+                __m256i d3 = _mm256_xor_si256(c2, rotl_x4(c4, 1));
+                __m256i d4 = _mm256_xor_si256(c3, rotl_x4(c0, 1));
+                a[0] = _mm256_xor_si256(a[0], d0); a[1] = _mm256_xor_si256(a[1], d1);
+                a[2] = _mm256_xor_si256(a[2], d2); a[3] = _mm256_xor_si256(a[3], d3);
+                a[4] = _mm256_xor_si256(a[4], d4);
+                a[5] = _mm256_xor_si256(a[5], d0); a[6] = _mm256_xor_si256(a[6], d1);
+                a[7] = _mm256_xor_si256(a[7], d2); a[8] = _mm256_xor_si256(a[8], d3);
+                a[9] = _mm256_xor_si256(a[9], d4);
+                a[10] = _mm256_xor_si256(a[10], d0); a[11] = _mm256_xor_si256(a[11], d1);
+                a[12] = _mm256_xor_si256(a[12], d2); a[13] = _mm256_xor_si256(a[13], d3);
+                a[14] = _mm256_xor_si256(a[14], d4);
+                a[15] = _mm256_xor_si256(a[15], d0); a[16] = _mm256_xor_si256(a[16], d1);
+                a[17] = _mm256_xor_si256(a[17], d2); a[18] = _mm256_xor_si256(a[18], d3);
+                a[19] = _mm256_xor_si256(a[19], d4);
+                a[20] = _mm256_xor_si256(a[20], d0); a[21] = _mm256_xor_si256(a[21], d1);
+                a[22] = _mm256_xor_si256(a[22], d2); a[23] = _mm256_xor_si256(a[23], d3);
+                a[24] = _mm256_xor_si256(a[24], d4);
+                __m256i b[25];
+                b[0] = a[0];
+                b[10] = rotl_x4(a[1], 1);
+                b[7] = rotl_x4(a[10], 3);
+                b[11] = rotl_x4(a[7], 6);
+                b[17] = rotl_x4(a[11], 10);
+                b[18] = rotl_x4(a[17], 15);
+                b[3] = rotl_x4(a[18], 21);
+                b[5] = rotl_x4(a[3], 28);
+                b[16] = rotl_x4(a[5], 36);
+                b[8] = rotl_x4(a[16], 45);
+                b[21] = rotl_x4(a[8], 55);
+                b[24] = rotl_x4(a[21], 2);
+                b[4] = rotl_x4(a[24], 14);
+                b[15] = rotl_x4(a[4], 27);
+                b[23] = rotl_x4(a[15], 41);
+                b[19] = rotl_x4(a[23], 56);
+                b[13] = rotl_x4(a[19], 8);
+                b[12] = rotl_x4(a[13], 25);
+                b[2] = rotl_x4(a[12], 43);
+                b[20] = rotl_x4(a[2], 62);
+                b[14] = rotl_x4(a[20], 18);
+                b[22] = rotl_x4(a[14], 39);
+                b[9] = rotl_x4(a[22], 61);
+                b[6] = rotl_x4(a[9], 20);
+                b[1] = rotl_x4(a[6], 44);
+                a[0] = chi_x4(b[0], b[1], b[2]);
+                a[1] = chi_x4(b[1], b[2], b[3]);
+                a[2] = chi_x4(b[2], b[3], b[4]);
+                a[3] = chi_x4(b[3], b[4], b[0]);
+                a[4] = chi_x4(b[4], b[0], b[1]);
+                a[5] = chi_x4(b[5], b[6], b[7]);
+                a[6] = chi_x4(b[6], b[7], b[8]);
+                a[7] = chi_x4(b[7], b[8], b[9]);
+                a[8] = chi_x4(b[8], b[9], b[5]);
+                a[9] = chi_x4(b[9], b[5], b[6]);
+                a[10] = chi_x4(b[10], b[11], b[12]);
+                a[11] = chi_x4(b[11], b[12], b[13]);
+                a[12] = chi_x4(b[12], b[13], b[14]);
+                a[13] = chi_x4(b[13], b[14], b[10]);
+                a[14] = chi_x4(b[14], b[10], b[11]);
+                a[15] = chi_x4(b[15], b[16], b[17]);
+                a[16] = chi_x4(b[16], b[17], b[18]);
+                a[17] = chi_x4(b[17], b[18], b[19]);
+                a[18] = chi_x4(b[18], b[19], b[15]);
+                a[19] = chi_x4(b[19], b[15], b[16]);
+                a[20] = chi_x4(b[20], b[21], b[22]);
+                a[21] = chi_x4(b[21], b[22], b[23]);
+                a[22] = chi_x4(b[22], b[23], b[24]);
+                a[23] = chi_x4(b[23], b[24], b[20]);
+                a[24] = chi_x4(b[24], b[20], b[21]);
+                a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(int64_t(kRoundConstants[round])));
+        }
+    }
+
+    // Samples four matrix entries at once; `ji` holds their (j, i) indices.
+    __attribute__((target("avx2")))
+    static void sample_ntt_x4(poly* const p[4], const uint8_t rho[32], const uint8_t ji[4][2]) {
+        // Absorb the 34-byte inputs, which only differ in their last two bytes, and pad:
+        __m256i s[25];
+        for (int l = 0; l < 25; ++l)
+            s[l] = _mm256_setzero_si256();
+        for (int l = 0; l < 4; ++l) {
+            uint64_t lane;
+            ::memcpy(&lane, rho + 8 * l, 8);
+            s[l] = _mm256_set1_epi64x(int64_t(lane));
+        }
+        int64_t tail[4];
+        for (int k = 0; k < 4; ++k)
+            tail[k] = int64_t(ji[k][0] | (ji[k][1] << 8) | (0x1F << 16));
+        s[4] = _mm256_set_epi64x(tail[3], tail[2], tail[1], tail[0]);
+        s[Shake128Rate / 8 - 1] = _mm256_set1_epi64x(int64_t(0x80ull << 56));
+
+        // Squeeze blocks until all four polys are full:
+        alignas(32) uint64_t lanes[Shake128Rate / 8][4];
+        uint8_t buf[Shake128Rate];
+        int n[4] = {0, 0, 0, 0};
+        while (n[0] < 256 || n[1] < 256 || n[2] < 256 || n[3] < 256) {
+            keccak_permute_x4(s);
+            for (size_t l = 0; l < Shake128Rate / 8; ++l)
+                _mm256_store_si256((__m256i*)lanes[l], s[l]);
+            for (int k = 0; k < 4; ++k) {
+                if (n[k] < 256) {
+                    for (size_t l = 0; l < Shake128Rate / 8; ++l)
+                        ::memcpy(buf + 8 * l, &lanes[l][k], 8);     // (x86 is little-endian)
+                    n[k] = rej_uniform(*p[k], n[k], buf, sizeof(buf));
+                }
+            }
+        }
+    }
+#endif
+
+
+    // Generates the matrix A (or its transpose) from the seed rho.
+    static void generate_matrix(polyvec a[K], const uint8_t rho[32], bool transposed) {
+        auto index = [&](int i, int j) -> pair<uint8_t,uint8_t> {      // (j, i) input bytes
+            return transposed ? pair(uint8_t(i), uint8_t(j)) : pair(uint8_t(j), uint8_t(i));
+        };
+        int e = 0;
+#ifdef MLKEM_AVX2
+        if (sUseAVX2.load(memory_order_relaxed)) {
+            for (; e + 4 <= K * K; e += 4) {
+                poly* p[4];
+                uint8_t ji[4][2];
+                for (int k = 0; k < 4; ++k) {
+                    int i = (e + k) / K, j = (e + k) % K;
+                    p[k] = &a[i][j];
+                    auto [b0, b1] = index(i, j);
+                    ji[k][0] = b0;
+                    ji[k][1] = b1;
+                }
+                sample_ntt_x4(p, rho, ji);
+            }
+        }
+#endif
+        for (; e < K * K; ++e) {
+            int i = e / K, j = e % K;
+            auto [b0, b1] = index(i, j);
+            sample_ntt(a[i][j], rho, b0, b1);
+        }
+    }
+
+    // SamplePolyCBD_2(PRF_2(seed, nonce)): centered binomial distribution with eta = 2.
+    static void sample_cbd2(poly &p, const uint8_t seed[32], uint8_t nonce) {
+        uint8_t buf[128];
+        sponge<shake256>(buf, sizeof(buf), {{seed, 32}, {&nonce, 1}});
+        for (int i = 0; i < 32; ++i) {
+            uint32_t t = uint32_t(buf[4*i]) | uint32_t(buf[4*i + 1]) << 8
+                       | uint32_t(buf[4*i + 2]) << 16 | uint32_t(buf[4*i + 3]) << 24;
+            uint32_t d = (t & 0x55555555) + ((t >> 1) & 0x55555555);
+            for (int j = 0; j < 8; ++j) {
+                int16_t a = int16_t((d >> (4*j)) & 3);
+                int16_t b = int16_t((d >> (4*j + 2)) & 3);
+                p.c[8*i + j] = int16_t(a - b);
+            }
+        }
+        wipe(buf, sizeof(buf));
+    }
+
+
+    //======== K-PKE
+
+
+    static void pke_keygen(uint8_t ek[ML_KEM_768::public_key_size], uint8_t dk[K * PolyBytes],
+                           const uint8_t d[32])
+    {
+        uint8_t rho_sigma[64];
+        uint8_t k = K;
+        sponge<sha3_512>(rho_sigma, 64, {{d, 32}, {&k, 1}});
+        const uint8_t *rho = rho_sigma, *sigma = rho_sigma + 32;
+
+        polyvec a[K], s, e;
+        generate_matrix(a, rho, false);
+        uint8_t nonce = 0;
+        for (auto &p : s)
+            sample_cbd2(p, sigma, nonce++);
+        for (auto &p : e)
+            sample_cbd2(p, sigma, nonce++);
+        for (int i = 0; i < K; ++i) {
+            poly_ntt(s[i]);
+            poly_ntt(e[i]);
+        }
+        for (int i = 0; i < K; ++i) {
+            poly t;
+            polyvec_basemul_acc(t, a[i], s);
+            for (auto &c : t.c)
+                c = fqmul(c, kMontSquared);     // cancel the R^-1
+            poly_add(t, e[i]);
+            poly_to_bytes(ek + i * PolyBytes, t);
+            poly_to_bytes(dk + i * PolyBytes, s[i]);
+        }
+        ::memcpy(ek + K * PolyBytes, rho, 32);
+        wipe(rho_sigma, sizeof(rho_sigma));
+        wipe(s, sizeof(s));
+        wipe(e, sizeof(e));
+    }
+
+    static void pke_encrypt(uint8_t c[ML_KEM_768::ciphertext_size],
+                            const uint8_t ek[ML_KEM_768::public_key_size],
+                            const uint8_t m[32], const uint8_t r[32])
+    {
+        polyvec t, a[K], y, u;
+        poly e1, e2, v, mu;
+        for (int i = 0; i < K; ++i)
+            poly_from_bytes(t[i], ek + i * PolyBytes);
+        generate_matrix(a, ek + K * PolyBytes, true);
+
+        uint8_t nonce = 0;
+        for (auto &p : y)
+            sample_cbd2(p, r, nonce++);
+        for (auto &p : y)
+            poly_ntt(p);
+
+        for (int i = 0; i < K; ++i) {
+            polyvec_basemul_acc(u[i], a[i], y);
+            poly_invntt(u[i]);
+            sample_cbd2(e1, r, nonce++);
+            poly_add(u[i], e1);
+            poly_compress(c + i * 32 * DU, u[i], DU);
+        }
+
+        polyvec_basemul_acc(v, t, y);
+        poly_invntt(v);
+        sample_cbd2(e2, r, nonce++);
+        poly_add(v, e2);
+        for (int i = 0; i < 256; ++i)       // Decompress_1(m)
+            mu.c[i] = int16_t(-int16_t((m[i / 8] >> (i % 8)) & 1) & ((Q + 1) / 2));
+        poly_add(v, mu);
+        poly_compress(c + PolyVecCompressedBytes, v, DV);
+
+        wipe(y, sizeof(y));
+        wipe(&e1, sizeof(e1));
+        wipe(&e2, sizeof(e2));
+        wipe(&mu, sizeof(mu));
+    }
+
+    static void pke_decrypt(uint8_t m[32], const uint8_t dk[K * PolyBytes],
+                            const uint8_t c[ML_KEM_768::ciphertext_size])
+    {
+        polyvec u, s;
+        poly v, w;
+        for (int i = 0; i < K; ++i) {
+            poly_decompress(u[i], c + i * 32 * DU, DU);
+            poly_ntt(u[i]);
+            poly_from_bytes(s[i], dk + i * PolyBytes);
+        }
+        poly_decompress(v, c + PolyVecCompressedBytes, DV);
+        polyvec_basemul_acc(w, s, u);
+        poly_invntt(w);
+        for (int i = 0; i < 256; ++i)
+            w.c[i] = int16_t(v.c[i] - w.c[i]);
+        uint32_t bits[256];
+        for (int i = 0; i < 256; ++i)
+            bits[i] = compress(canonical(barrett_reduce(w.c[i])), 1);
+        pack_bits(m, bits, 256, 1);
+        wipe(s, sizeof(s));
+        wipe(&w, sizeof(w));
+        wipe(bits, sizeof(bits));
+    }
+
+
+    //======== ML-KEM
+
+
+    void ML_KEM_768::generate_fn(uint8_t pk[public_key_size], uint8_t sk[secret_key_size],
+                                 const uint8_t seed[seed_size])
+    {
+        // dk = dk_PKE || ek || H(ek) || z
+        pke_keygen(pk, sk, seed);
+        ::memcpy(sk + K * PolyBytes, pk, public_key_size);
+        sponge<sha3_256>(sk + K * PolyBytes + public_key_size, 32, {{pk, public_key_size}});
+        ::memcpy(sk + K * PolyBytes + public_key_size + 32, seed + 32, 32);
+    }
+
+
+    bool ML_KEM_768::check_public_key_fn(const uint8_t pk[public_key_size]) {
+        // FIPS 203 7.2: every coefficient must already be reduced mod q.
+        for (int i = 0; i < K * PolyBytes; i += 3) {
+            uint16_t t0 = uint16_t(pk[i] | ((pk[i + 1] & 0x0F) << 8));
+            uint16_t t1 = uint16_t((pk[i + 1] >> 4) | (pk[i + 2] << 4));
+            if (t0 >= Q || t1 >= Q)
+                return false;
+        }
+        return true;
+    }
+
+
+    void ML_KEM_768::encapsulate_fn(uint8_t ct[ciphertext_size], uint8_t ss[32],
+                                    const uint8_t pk[public_key_size],
+                                    const uint8_t m[encapsulation_seed_size])
+    {
+        // (K, r) = G(m || H(ek))
+        uint8_t h[32], kr[64];
+        sponge<sha3_256>(h, 32, {{pk, public_key_size}});
+        sponge<sha3_512>(kr, 64, {{m, 32}, {h, 32}});
+        pke_encrypt(ct, pk, m, kr + 32);
+        ::memcpy(ss, kr, 32);
+        wipe(kr, sizeof(kr));
+    }
+
+
+    void ML_KEM_768::decapsulate_fn(uint8_t ss[32], const uint8_t ct[ciphertext_size],
+                                    const uint8_t sk[secret_key_size])
+    {
+        const uint8_t *dk_pke = sk;
+        const uint8_t *ek = sk + K * PolyBytes;
+        const uint8_t *h  = ek + public_key_size;
+        const uint8_t *z  = h + 32;
+
+        uint8_t m[32], kr[64], reject[32];
+        pke_decrypt(m, dk_pke, ct);
+        sponge<sha3_512>(kr, 64, {{m, 32}, {h, 32}});
+        sponge<shake256>(reject, 32, {{z, 32}, {ct, ciphertext_size}});
+
+        // Re-encrypt, and if the ciphertext doesn't match, return the rejection key instead.
+        // Constant-time, so as not to reveal which happened.
+        uint8_t ct2[ciphertext_size];
+        pke_encrypt(ct2, ek, m, kr + 32);
+        uint32_t diff = 0;
+        for (size_t i = 0; i < ciphertext_size; ++i)
+            diff |= ct[i] ^ ct2[i];
+        uint8_t mask = uint8_t(-int32_t((diff | (0 - diff)) >> 31));  // 0xFF if different
+        for (int i = 0; i < 32; ++i)
+            ss[i] = uint8_t(kr[i] ^ (mask & (kr[i] ^ reject[i])));
+        wipe(m, sizeof(m));
+        wipe(kr, sizeof(kr));
+        wipe(reject, sizeof(reject));
+    }
+
+
+    //======== X25519 + ML-KEM-768 HYBRID
+
+
+    static constexpr char kHybridLabel[] = "Monocypher-Cpp X25519+ML-KEM-768";
+
+    static void hybrid_combine(uint8_t ss[32], const uint8_t ss_m[32], const uint8_t ss_x[32],
+                               const uint8_t ct_x[32], const uint8_t pk_x[32])
+    {
+        sponge<sha3_256>(ss, 32, {{(const uint8_t*)kHybridLabel, sizeof(kHybridLabel) - 1},
+                                  {ss_m, 32}, {ss_x, 32}, {ct_x, 32}, {pk_x, 32}});
+    }
+
+
+    void X25519_MLKEM768::generate_fn(uint8_t pk[public_key_size], uint8_t sk[secret_key_size],
+                                      const uint8_t seed[seed_size])
+    {
+        // sk = sk_M || sk_X || pk_X;  pk = pk_M || pk_X
+        uint8_t expanded[96];
+        sponge<shake256>(expanded, sizeof(expanded), {{seed, seed_size}});
+        ML_KEM_768::generate_fn(pk, sk, expanded);
+        uint8_t *sk_x = sk + ML_KEM_768::secret_key_size;
+        ::memcpy(sk_x, expanded + 64, 32);
+        x25519_public_key(pk + ML_KEM_768::public_key_size, sk_x);
+        ::memcpy(sk_x + 32, pk + ML_KEM_768::public_key_size, 32);
+        wipe(expanded, sizeof(expanded));
+    }
+
+
+    bool X25519_MLKEM768::check_public_key_fn(const uint8_t pk[public_key_size]) {
+        return ML_KEM_768::check_public_key_fn(pk);
+    }
+
+
+    void X25519_MLKEM768::encapsulate_fn(uint8_t ct[ciphertext_size], uint8_t ss[32],
+                                         const uint8_t pk[public_key_size],
+                                         const uint8_t seed[encapsulation_seed_size])
+    {
+        const uint8_t *pk_x = pk + ML_KEM_768::public_key_size;
+        uint8_t *ct_x = ct + ML_KEM_768::ciphertext_size;
+        uint8_t ss_m[32], ss_x[32];
+        ML_KEM_768::encapsulate_fn(ct, ss_m, pk, seed);
+        x25519_public_key(ct_x, seed + 32);
+        c::crypto_x25519(ss_x, seed + 32, pk_x);
+        hybrid_combine(ss, ss_m, ss_x, ct_x, pk_x);
+        wipe(ss_m, sizeof(ss_m));
+        wipe(ss_x, sizeof(ss_x));
+    }
+
+
+    void X25519_MLKEM768::decapsulate_fn(uint8_t ss[32], const uint8_t ct[ciphertext_size],
+                                         const uint8_t sk[secret_key_size])
+    {
+        const uint8_t *sk_x = sk + ML_KEM_768::secret_key_size;
+        const uint8_t *pk_x = sk_x + 32;
+        const uint8_t *ct_x = ct + ML_KEM_768::ciphertext_size;
+        uint8_t ss_m[32], ss_x[32];
+        ML_KEM_768::decapsulate_fn(ss_m, ct, sk);
+        c::crypto_x25519(ss_x, sk_x, ct_x);
+        hybrid_combine(ss, ss_m, ss_x, ct_x, pk_x);
+        wipe(ss_m, sizeof(ss_m));
+        wipe(ss_x, sizeof(ss_x));
+    }
+
+}
@@ -0,0 +1,220 @@
+//
+//  monocypher/Monocypher+multi_recipient.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/multi_recipient.hh"
+#include "monocypher/hash.hh"
+#include <algorithm>
+#include <stdexcept>
+
+namespace monocypher::ext {
+    using namespace std;
+
+    static constexpr uint8_t kVersion = 1;
+    static constexpr size_t  kHeaderSize = 1 + 32 + 1 + 4;
+    static constexpr size_t  kMaxFanoutBits = 16;
+
+    namespace {
+        struct slot {
+            uint32_t       hint;
+            session::mac   mac;
+            byte_array<32> wrapped_key;
+        };
+    }
+
+    // Derives a recipient's wrapping key, and its slot's hint, from the X25519 shared secret.
+    static session::key derive_wrapping_key(multi_recipient::key_exchange::shared_secret const& shared,
+                                            multi_recipient::public_key const& ephemeral,
+                                            multi_recipient::public_key const& recipient,
+                                            uint32_t &hint)
+    {
+        auto h = blake2b64::builder().update(shared).update(ephemeral).update(recipient).final();
+        hint = h[32] | (h[33] << 8) | (h[34] << 16) | (uint32_t(h[35]) << 24);
+        session::key k(h.data(), 32);
+        h.wipe();
+        return k;
+    }
+
+    static unsigned fanout_bits(size_t count) {
+        unsigned bits = 0;
+        while (bits < kMaxFanoutBits && (size_t(2) << bits) <= count)
+            ++bits;
+        return bits;
+    }
+
+    static size_t bucket_of(uint32_t hint, unsigned bits) {
+        return bits ? (hint >> (32 - bits)) : 0;
+    }
+
+    static void store32(uint8_t *dst, uint32_t n) {
+        for (int i = 0; i < 4; ++i)
+            dst[i] = uint8_t(n >> (8 * i));
+    }
+
+    static uint32_t load32(const uint8_t *src) {
+        return src[0] | (src[1] << 8) | (src[2] << 16) | (uint32_t(src[3]) << 24);
+    }
+
+
+    size_t multi_recipient::envelope_size(size_t count, size_t payload_size) {
+        return kHeaderSize + (size_t(4) << fanout_bits(count)) + count * slot_size
+             + sizeof(session::mac) + payload_size;
+    }
+
+
+    vector<uint8_t> multi_recipient::seal(input_bytes payload,
+                                          const public_key recipients[], size_t count,
+                                          unsigned threads)
+    {
+        if (count == 0 || count > UINT32_MAX)
+            throw invalid_argument("invalid multi_recipient count");
+        key_exchange ephemeral;
+        public_key ephemeral_pub = ephemeral.get_public_key();
+        session::key payload_key;
+
+        // Wrap the payload key for each recipient, in parallel, 64 recipients per job:
+        vector<slot> slots(count);
+        internal::parallel_for((count + 63) / 64, threads, SIZE_MAX, [&](size_t job) {
+            for (size_t i = 64 * job; i < min(64 * job + 64, count); ++i) {
+                session::key wrapping_key = derive_wrapping_key(
+                            ephemeral.get_shared_secret(recipients[i]), ephemeral_pub,
+                            recipients[i], slots[i].hint);
+                // Each wrapping key is used only once, so a zero nonce is fine.
+                slots[i].mac = wrapping_key.lock(session::nonce(0), payload_key,
+                                                 slots[i].wrapped_key.data());
+            }
+        });
+        sort(slots.begin(), slots.end(), [](auto &a, auto &b) {return a.hint < b.hint;});
+
+        // Write the header and fanout table:
+        unsigned bits = fanout_bits(count);
+        vector<uint8_t> envelope(envelope_size(count, payload.size));
+        uint8_t *out = envelope.data();
+        *out++ = kVersion;
+        ::memcpy(out, ephemeral_pub.data(), 32);
+        out += 32;
+        *out++ = uint8_t(bits);
+        store32(out, uint32_t(count));
+        out += 4;
+        size_t s = 0;
+        for (size_t bucket = 0; bucket < (size_t(1) << bits); ++bucket) {
+            while (s < count && bucket_of(slots[s].hint, bits) <= bucket)
+                ++s;
+            store32(out, uint32_t(s));
+            out += 4;
+        }
+
+        // Then the slots and the payload:
+        for (auto &sl : slots) {
+            store32(out, sl.hint);
+            ::memcpy(out + 4, sl.mac.data(), 16);
+            ::memcpy(out + 20, sl.wrapped_key.data(), 32);
+            out += slot_size;
+        }
+        session::mac mac = payload_key.lock(session::nonce(0), payload, out + 16);
+        ::memcpy(out, mac.data(), 16);
+        return envelope;
+    }
+
+
+    // Parses the header; returns a pointer to the first slot, or nullptr if malformed.
+    static const uint8_t* parse_header(input_bytes envelope, unsigned &bits, size_t &count) {
+        if (envelope.size < kHeaderSize || envelope.data[0] != kVersion)
+            return nullptr;
+        bits = envelope.data[33];
+        count = load32(&envelope.data[34]);
+        // `seal` always writes `fanout_bits(count)`; anything else would throw off the offsets.
+        if (count == 0 || bits != fanout_bits(count))
+            return nullptr;
+        // Equivalent to `envelope.size < envelope_size(count, 0)`, without overflowing:
+        size_t fixed = kHeaderSize + (size_t(4) << bits) + sizeof(session::mac);
+        if (envelope.size < fixed || count > (envelope.size - fixed) / multi_recipient::slot_size)
+            return nullptr;
+        return envelope.data + kHeaderSize + (size_t(4) << bits);
+    }
+
+
+    size_t multi_recipient::payload_size(input_bytes envelope) {
+        unsigned bits;
+        size_t count;
+        if (!parse_header(envelope, bits, count))
+            return 0;
+        return envelope.size - envelope_size(count, 0);
+    }
+
+
+    output_bytes multi_recipient::open(input_bytes envelope,
+                                       key_exchange const& recipient,
+                                       output_bytes payload_out)
+    {
+        unsigned bits;
+        size_t count;
+        const uint8_t *slots = parse_header(envelope, bits, count);
+        if (!slots)
+            return {};
+        const uint8_t *fanout = envelope.data + kHeaderSize;
+        const uint8_t *payload = slots + count * slot_size;
+        size_t payload_size = envelope.size - envelope_size(count, 0);
+        assert(payload_out.size >= payload_size);
+
+        public_key ephemeral_pub(envelope.data + 1, 32);
+        uint32_t hint;
+        session::key wrapping_key = derive_wrapping_key(recipient.get_shared_secret(ephemeral_pub),
+                                                        ephemeral_pub, recipient.get_public_key(),
+                                                        hint);
+
+        // Look up the hint's bucket in the fanout table, then scan its (few) slots:
+        size_t bucket = bucket_of(hint, bits);
+        size_t begin = bucket ? load32(fanout + 4 * (bucket - 1)) : 0;
+        size_t end = load32(fanout + 4 * bucket);
+        if (begin > end || end > count)
+            return {};
+        for (size_t i = begin; i < end; ++i) {
+            const uint8_t *sl = slots + i * slot_size;
+            if (load32(sl) != hint)
+                continue;
+            session::mac mac;
+            mac.fillWith(sl + 4, 16);
+            secret_byte_array<32> unwrapped;
+            if (!wrapping_key.unlock(session::nonce(0), mac, {sl + 20, 32}, unwrapped.data()))
+                continue;       // hint collision with another recipient
+            session::key payload_key(unwrapped.data(), unwrapped.size());
+            mac.fillWith(payload, 16);
+            if (!payload_key.unlock(session::nonce(0), mac, {payload + 16, payload_size},
+                                    payload_out.data))
+                return {};
+            return payload_out.shrunk_to(payload_size);
+        }
+        return {};
+    }
+
+}
@@ -0,0 +1,580 @@
+//
+//  monocypher/Monocypher+noise.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/noise.hh"
+#include <stdexcept>
+
+namespace monocypher::ext::noise {
+    using namespace std;
+
+    static_assert(sizeof(handshake) <= 8 * 64, "handshake state should fit in 8 cache lines");
+
+
+    // `read_message` returns `{nullptr,0}` for failure, so a successful read of an empty payload
+    // into a null buffer must return some other pointer.
+    static output_bytes non_null(output_bytes out) {
+        static uint8_t sEmpty;
+        if (!out.data)
+            out.data = &sEmpty;
+        return out;
+    }
+
+
+    //======== CIPHER STATE
+
+
+    // ChaChaPoly nonce: 32 bits of zeroes followed by the 64-bit little-endian counter.
+    static byte_array<12> make_nonce(uint64_t n) {
+        byte_array<12> nonce(0);
+        for (size_t i = 4; i < 12; ++i, n >>= 8)
+            nonce[i] = uint8_t(n & 0xFF);
+        return nonce;
+    }
+
+    static void aead_encrypt(secret_byte_array<32> const& k, uint64_t n,
+                             input_bytes ad, input_bytes plain, uint8_t *out) {
+        c::crypto_aead_ctx ctx;
+        c::crypto_aead_init_ietf(&ctx, k.data(), make_nonce(n).data());
+        c::crypto_aead_write(&ctx, out, out + plain.size, ad.data, ad.size, plain.data, plain.size);
+        c::crypto_wipe(&ctx, sizeof(ctx));
+    }
+
+
+    output_bytes cipher_state::encrypt(input_bytes ad, input_bytes plain, output_bytes out) {
+        if (!_has_key) {
+            out = out.shrunk_to(plain.size);
+            ::memmove(out.data, plain.data, plain.size);
+            return out;
+        }
+        if (_n == UINT64_MAX)
+            throw logic_error("Noise cipher_state nonce exhausted");
+        out = out.shrunk_to(plain.size + mac_size);
+        aead_encrypt(_k, _n++, ad, plain, u8(out.data));
+        return out;
+    }
+
+
+    optional<output_bytes> cipher_state::decrypt(input_bytes ad, input_bytes cipher,
+                                                 output_bytes out)
+    {
+        if (!_has_key) {
+            out = out.shrunk_to(cipher.size);
+            ::memmove(out.data, cipher.data, cipher.size);
+            return out;
+        }
+        if (cipher.size < mac_size || _n == UINT64_MAX)
+            return {};
+        size_t plain_size = cipher.size - mac_size;
+        out = out.shrunk_to(plain_size);
+        c::crypto_aead_ctx ctx;
+        c::crypto_aead_init_ietf(&ctx, _k.data(), make_nonce(_n).data());
+        int err = c::crypto_aead_read(&ctx, u8(out.data), cipher.data + plain_size,
+                                      ad.data, ad.size, cipher.data, plain_size);
+        c::crypto_wipe(&ctx, sizeof(ctx));
+        if (err)
+            return {};
+        ++_n;
+        return out;
+    }
+
+
+    void cipher_state::rekey() {
+        // REKEY(k) = ENCRYPT(k, maxnonce, zerolen, zeros), truncated to 32 bytes.
+        secret_byte_array<32 + mac_size> out(0);
+        aead_encrypt(_k, UINT64_MAX, {nullptr, 0}, {out.data(), 32}, out.data());
+        _k.fillWith(out.data(), 32);
+    }
+
+
+    //======== SYMMETRIC STATE
+
+
+    static void hmac(secret_byte_array<hash_size> &out,
+                     byte_array<hash_size> const& key,
+                     input_bytes data1, input_bytes data2 = {nullptr, 0}) {
+        secret_byte_array<128> pad(0);
+        for (size_t i = 0; i < hash_size; ++i)
+            pad[i] = key[i] ^ 0x36;
+        for (size_t i = hash_size; i < 128; ++i)
+            pad[i] = 0x36;
+        blake2b64::builder inner;
+        inner.update(pad).update(data1).update(data2);
+        blake2b64 inner_hash = inner.final();
+
+        for (size_t i = 0; i < 128; ++i)
+            pad[i] ^= 0x36 ^ 0x5C;
+        blake2b64::builder outer;
+        outer.update(pad).update(inner_hash);
+        blake2b64 outer_hash = outer.final();
+        out.fillWith(outer_hash.data(), hash_size);
+        inner_hash.wipe();
+        outer_hash.wipe();
+    }
+
+    // Noise's HKDF with two outputs.
+    static void hkdf(secret_byte_array<hash_size> const& ck, input_bytes ikm,
+                     secret_byte_array<hash_size> &out1, secret_byte_array<hash_size> &out2) {
+        secret_byte_array<hash_size> temp_key;
+        hmac(temp_key, ck, ikm);
+        uint8_t counter = 1;
+        hmac(out1, temp_key, {&counter, 1});
+        counter = 2;
+        hmac(out2, temp_key, out1, {&counter, 1});
+    }
+
+    static byte_array<32> const& truncated(secret_byte_array<hash_size> const& key) {
+        return key.range<0,32>();
+    }
+
+
+    void symmetric_state::initialize(const char *protocol_name) {
+        size_t len = strlen(protocol_name);
+        if (len <= hash_size) {
+            _h.fill(0);
+            ::memcpy(_h.data(), protocol_name, len);
+        } else {
+            _h = blake2b64::create(protocol_name, len);
+        }
+        _ck.fillWith(_h.data(), hash_size);
+        _cipher = cipher_state();
+    }
+
+
+    void symmetric_state::mix_key(input_bytes ikm) {
+        secret_byte_array<hash_size> temp_k;
+        hkdf(_ck, ikm, _ck, temp_k);
+        _cipher.initialize_key(truncated(temp_k));
+    }
+
+
+    void symmetric_state::mix_hash(input_bytes data) {
+        blake2b64::builder b;
+        b.update(_h).update(data);
+        _h = b.final();
+    }
+
+
+    output_bytes symmetric_state::encrypt_and_hash(input_bytes plain, output_bytes out) {
+        out = _cipher.encrypt(_h, plain, out);
+        mix_hash({out.data, out.size});
+        return out;
+    }
+
+
+    optional<output_bytes> symmetric_state::decrypt_and_hash(input_bytes cipher, output_bytes out) {
+        // Hash the ciphertext first, since decryption may overwrite it in place:
+        byte_array<hash_size> h = _h;
+        mix_hash(cipher);
+        return _cipher.decrypt(h, cipher, out);
+    }
+
+
+    void symmetric_state::split(role r, transport &t) const {
+        secret_byte_array<hash_size> k1, k2;
+        hkdf(_ck, {nullptr, 0}, k1, k2);
+        if (r == role::initiator) {
+            t.send.initialize_key(truncated(k1));
+            t.receive.initialize_key(truncated(k2));
+        } else {
+            t.send.initialize_key(truncated(k2));
+            t.receive.initialize_key(truncated(k1));
+        }
+    }
+
+
+    void symmetric_state::derive_ticket(resumption_ticket &ticket) const {
+        static constexpr const char kLabel[] = "Noise resumption ticket";
+        secret_byte_array<hash_size> secret, id;
+        hkdf(_ck, {kLabel, sizeof(kLabel) - 1}, secret, id);
+        ticket.ticket_secret.fillWith(secret.data(), 32);
+        ticket.ticket_id.fillWith(id.data(), 16);
+    }
+
+
+    //======== HANDSHAKE
+
+
+    namespace {
+        enum token : uint8_t {
+            end = 0, e, s, ee, es, se, ss,
+        };
+
+        enum key_flag : uint8_t {
+            has_s = 1, has_e = 2, has_rs = 4, has_re = 8,
+        };
+
+        struct pattern_info {
+            const char *protocol_name;
+            bool        responder_static_premessage;
+            uint8_t     message_count;
+            token       messages[3][5];
+        };
+
+        constexpr pattern_info kPatterns[] = {
+            {"Noise_NK_25519_ChaChaPoly_BLAKE2b", true, 2, {
+                {e, es, end},
+                {e, ee, end},
+            }},
+            {"Noise_XX_25519_ChaChaPoly_BLAKE2b", false, 3, {
+                {e, end},
+                {e, ee, s, es, end},
+                {s, se, end},
+            }},
+            {"Noise_IK_25519_ChaChaPoly_BLAKE2b", true, 2, {
+                {e, es, s, ss, end},
+                {e, ee, se, end},
+            }},
+        };
+
+        pattern_info const& info(pattern p)  {return kPatterns[unsigned(p)];}
+    }
+
+
+    handshake::handshake(pattern p, role r, options const& opts)
+    :_pattern(p)
+    ,_role(r)
+    {
+        auto &pat = info(p);
+        bool initiator = (r == role::initiator);
+        if (opts.local_static) {
+            _s = *opts.local_static;
+            _s_pub = dh(_s).get_public_key();
+            _has |= has_s;
+        }
+        if (opts.remote_static) {
+            _rs = *opts.remote_static;
+            _has |= has_rs;
+        }
+        if (opts.local_ephemeral) {
+            _e = *opts.local_ephemeral;
+            _has |= has_e;
+        }
+
+        bool needs_s  = (p == pattern::XX) || (p == pattern::IK) || !initiator;
+        bool needs_rs = initiator && pat.responder_static_premessage;
+        if (needs_s && !(_has & has_s))
+            throw invalid_argument("Noise handshake pattern requires a local static key");
+        if (needs_rs && !(_has & has_rs))
+            throw invalid_argument("Noise handshake pattern requires the remote static key");
+
+        _ss.initialize(pat.protocol_name);
+        _ss.mix_hash(opts.prologue);
+        if (pat.responder_static_premessage)
+            _ss.mix_hash(initiator ? _rs : _s_pub);
+    }
+
+
+    bool handshake::is_my_turn() const {
+        return !is_complete() && ((_message % 2 == 0) == (_role == role::initiator));
+    }
+
+
+    bool handshake::is_complete() const {
+        return _message >= info(_pattern).message_count;
+    }
+
+
+    size_t handshake::message_size(size_t payload_size) const {
+        if (is_complete())
+            return 0;
+        bool has_key = _ss.has_key();
+        size_t size = 0;
+        for (const token *t = info(_pattern).messages[_message]; *t != end; ++t) {
+            if (*t == e)
+                size += dh_size;
+            else if (*t == s)
+                size += dh_size + (has_key ? mac_size : 0);
+            else
+                has_key = true;
+        }
+        return size + payload_size + (has_key ? mac_size : 0);
+    }
+
+
+    // Performs a DH token (ee, es, se, ss) and mixes the result into the chaining key.
+    bool handshake::mix_dh(uint8_t tok) {
+        bool initiator = (_role == role::initiator);
+        const secret_key *local;
+        const public_key *remote;
+        switch (tok) {
+            case ee: local = &_e; remote = &_re; break;
+            case es: local = initiator ? &_e : &_s;  remote = initiator ? &_rs : &_re; break;
+            case se: local = initiator ? &_s : &_e;  remote = initiator ? &_re : &_rs; break;
+            case ss: local = &_s; remote = &_rs; break;
+            default: return false;
+        }
+        secret_byte_array<dh_size> shared;
+        c::crypto_x25519(shared.data(), local->data(), remote->data());
+        _ss.mix_key(shared);
+        return true;
+    }
+
+
+    output_bytes handshake::write_message(input_bytes payload, output_bytes out) {
+        if (!is_my_turn())
+            throw logic_error("Not the right time to write a Noise handshake message");
+        out = out.shrunk_to(message_size(payload.size));
+        assert(out.size <= max_message_size);
+        auto dst = u8(out.data);
+        for (const token *t = info(_pattern).messages[_message]; *t != end; ++t) {
+            if (*t == e) {
+                if (!(_has & has_e))
+                    _e.randomize();
+                _e_pub = dh(_e).get_public_key();
+                _has |= has_e;
+                ::memcpy(dst, _e_pub.data(), dh_size);
+                _ss.mix_hash(_e_pub);
+                dst += dh_size;
+            } else if (*t == s) {
+                dst += _ss.encrypt_and_hash(_s_pub, {dst, dh_size + mac_size}).size;
+            } else {
+                mix_dh(*t);
+            }
+        }
+        dst += _ss.encrypt_and_hash(payload, {dst, payload.size + mac_size}).size;
+        assert(dst == u8(out.data) + out.size);
+        ++_message;
+        return out;
+    }
+
+
+    output_bytes handshake::read_message(input_bytes message, output_bytes payload_out) {
+        if (is_my_turn() || is_complete())
+            throw logic_error("Not the right time to read a Noise handshake message");
+        if (message.size > max_message_size || message.size < message_size(0))
+            return {};
+        for (const token *t = info(_pattern).messages[_message]; *t != end; ++t) {
+            if (*t == e) {
+                _re.fillWith(message.data, dh_size);
+                _has |= has_re;
+                _ss.mix_hash(_re);
+                message.consume(dh_size);
+            } else if (*t == s) {
+                size_t len = dh_size + (_ss.has_key() ? mac_size : 0);
+                byte_array<dh_size + mac_size> temp;
+                ::memcpy(temp.data(), message.data, len);
+                if (!_ss.decrypt_and_hash({temp.data(), len}, {_rs.data(), dh_size}))
+                    return {};
+                _has |= has_rs;
+                message.consume(len);
+            } else {
+                mix_dh(*t);
+            }
+        }
+        auto payload = _ss.decrypt_and_hash(message, payload_out);
+        if (!payload)
+            return {};
+        ++_message;
+        return non_null(*payload);
+    }
+
+
+    transport handshake::split() const {
+        if (!is_complete())
+            throw logic_error("Noise handshake is not complete");
+        transport t;
+        _ss.split(_role, t);
+        return t;
+    }
+
+
+    optional<public_key> handshake::remote_static_key() const {
+        if (_has & has_rs)
+            return _rs;
+        return nullopt;
+    }
+
+
+    resumption_ticket handshake::get_resumption_ticket() const {
+        if (!is_complete())
+            throw logic_error("Noise handshake is not complete");
+        resumption_ticket ticket;
+        _ss.derive_ticket(ticket);
+        return ticket;
+    }
+
+
+    //======== TICKET CACHE
+
+
+    ticket_cache::ticket_cache(size_t capacity, clock::duration lifetime)
+    :_capacity(capacity)
+    ,_lifetime(lifetime)
+    {
+        assert(capacity > 0);
+    }
+
+
+    void ticket_cache::insert(resumption_ticket const& ticket) {
+        unique_lock<mutex> lock(_mutex);
+        if (auto i = _tickets.find(ticket.ticket_id); i != _tickets.end()) {
+            _order.erase(i->second.age);
+            _tickets.erase(i);
+        }
+        while (_tickets.size() >= _capacity) {
+            _tickets.erase(_order.front());
+            _order.pop_front();
+        }
+        _order.push_back(ticket.ticket_id);
+        _tickets.emplace(ticket.ticket_id,
+                         entry{ticket.ticket_secret, clock::now() + _lifetime, prev(_order.end())});
+    }
+
+
+    optional<resumption_ticket::secret> ticket_cache::take(resumption_ticket::id const& id) {
+        unique_lock<mutex> lock(_mutex);
+        auto i = _tickets.find(id);
+        if (i == _tickets.end())
+            return nullopt;
+        optional<resumption_ticket::secret> result;
+        if (clock::now() < i->second.expires)
+            result = i->second.secret;
+        _order.erase(i->second.age);
+        _tickets.erase(i);
+        return result;
+    }
+
+
+    size_t ticket_cache::size() const {
+        unique_lock<mutex> lock(_mutex);
+        return _tickets.size();
+    }
+
+
+    //======== RESUMPTION
+
+
+    static constexpr const char* kResumeProtocolName = "NoiseResume_25519_ChaChaPoly_BLAKE2b";
+
+
+    resumption::resumption(resumption_ticket const& ticket, input_bytes prologue)
+    :_role(role::initiator)
+    ,_ticket(ticket)
+    {
+        start(prologue);
+    }
+
+
+    resumption::resumption(ticket_cache &cache, input_bytes prologue)
+    :_role(role::responder)
+    ,_cache(&cache)
+    {
+        start(prologue);
+    }
+
+
+    void resumption::start(input_bytes prologue) {
+        _ss.initialize(kResumeProtocolName);
+        _ss.mix_hash(prologue);
+    }
+
+
+    bool resumption::is_my_turn() const {
+        return !is_complete() && ((_message == 0) == (_role == role::initiator));
+    }
+
+
+    size_t resumption::message_size(size_t payload_size) const {
+        if (is_complete())
+            return 0;
+        return (_message == 0 ? sizeof(resumption_ticket::id) : 0)
+             + random_size + payload_size + mac_size;
+    }
+
+
+    output_bytes resumption::write_message(input_bytes payload, output_bytes out) {
+        if (!is_my_turn())
+            throw logic_error("Not the right time to write a Noise resumption message");
+        out = out.shrunk_to(message_size(payload.size));
+        auto dst = u8(out.data);
+        if (_message == 0) {
+            ::memcpy(dst, _ticket.ticket_id.data(), sizeof(resumption_ticket::id));
+            _ss.mix_hash(_ticket.ticket_id);
+            dst += sizeof(resumption_ticket::id);
+        }
+        byte_array<random_size> rand;
+        rand.randomize();
+        ::memcpy(dst, rand.data(), random_size);
+        _ss.mix_hash(rand);
+        _ss.mix_key(_message == 0 ? input_bytes(_ticket.ticket_secret) : input_bytes(rand));
+        dst += random_size;
+        _ss.encrypt_and_hash(payload, {dst, payload.size + mac_size});
+        ++_message;
+        return out;
+    }
+
+
+    output_bytes resumption::read_message(input_bytes message, output_bytes payload_out) {
+        if (is_my_turn() || is_complete())
+            throw logic_error("Not the right time to read a Noise resumption message");
+        if (message.size < message_size(0))
+            return {};
+        if (_message == 0) {
+            _ticket.ticket_id.fillWith(message.data, sizeof(resumption_ticket::id));
+            message.consume(sizeof(resumption_ticket::id));
+            auto secret = _cache->take(_ticket.ticket_id);
+            if (!secret)
+                return {};
+            _ticket.ticket_secret = *secret;
+            _ss.mix_hash(_ticket.ticket_id);
+        }
+        byte_array<random_size> rand(message.data, random_size);
+        message.consume(random_size);
+        _ss.mix_hash(rand);
+        _ss.mix_key(_message == 0 ? input_bytes(_ticket.ticket_secret) : input_bytes(rand));
+        auto payload = _ss.decrypt_and_hash(message, payload_out);
+        if (!payload)
+            return {};
+        ++_message;
+        return non_null(*payload);
+    }
+
+
+    transport resumption::split() const {
+        if (!is_complete())
+            throw logic_error("Noise resumption is not complete");
+        transport t;
+        _ss.split(_role, t);
+        return t;
+    }
+
+
+    resumption_ticket resumption::get_resumption_ticket() const {
+        if (!is_complete())
+            throw logic_error("Noise resumption is not complete");
+        resumption_ticket ticket;
+        _ss.derive_ticket(ticket);
+        return ticket;
+    }
+
+}
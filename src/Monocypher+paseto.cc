@@ -0,0 +1,533 @@
+//
+//  Monocypher+paseto.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/paseto.hh"
+#include "monocypher/ext/chacha20_stream.hh"
+#include "monocypher/ext/sha512.hh"
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#   define BASE64_X86 1
+#   include <immintrin.h>
+#endif
+
+// PASETO v4 (see "docs/01-Protocol-Versions/Version4.md" in
+// <https://github.com/paseto-standard/paseto-spec>), and the unpadded base64url it's encoded with.
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    //======== BASE64URL
+
+
+    static constexpr char kBase64URL[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    // Maps a character to its 6-bit value, or to -1 if it's not in the alphabet.
+    struct base64_decode_table {
+        int8_t value[256];
+        constexpr base64_decode_table() :value() {
+            for (int i = 0; i < 256; ++i) value[i] = -1;
+            for (int i = 0; i < 64; ++i)  value[uint8_t(kBase64URL[i])] = int8_t(i);
+        }
+    };
+    static constexpr base64_decode_table kDecode;
+
+
+    string base64url_encode(input_bytes in) {
+        string out(base64url_encoded_size(in.size), '\0');
+        char *dst = out.data();
+        const uint8_t *src = in.data;
+        size_t n = in.size;
+        for (; n >= 3; n -= 3, src += 3) {
+            uint32_t w = uint32_t(src[0]) << 16 | uint32_t(src[1]) << 8 | src[2];
+            *dst++ = kBase64URL[(w >> 18) & 63];
+            *dst++ = kBase64URL[(w >> 12) & 63];
+            *dst++ = kBase64URL[(w >>  6) & 63];
+            *dst++ = kBase64URL[w & 63];
+        }
+        if (n > 0) {
+            uint32_t w = uint32_t(src[0]) << 16 | (n > 1 ? uint32_t(src[1]) << 8 : 0);
+            *dst++ = kBase64URL[(w >> 18) & 63];
+            *dst++ = kBase64URL[(w >> 12) & 63];
+            if (n > 1)
+                *dst++ = kBase64URL[(w >> 6) & 63];
+        }
+        return out;
+    }
+
+
+#ifdef BASE64_X86
+
+    // Decodes 32 characters into 24 bytes, or returns false if any character is invalid.
+    // The 6-bit values are found by range compares, then packed as in Muła & Lemire, "Faster
+    // Base64 Encoding and Decoding Using AVX2 Instructions" (2018).
+    // Mask of the bytes of `c` in the range [lo, hi]. (Bytes >= 0x80 compare as negative.)
+    __attribute__((target("avx2")))
+    static inline __m256i in_range_avx2(__m256i c, char lo, char hi) {
+        return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8(char(lo - 1))),
+                                _mm256_cmpgt_epi8(_mm256_set1_epi8(char(hi + 1)), c));
+    }
+
+    __attribute__((target("avx2")))
+    static bool decode32_avx2(const char *src, uint8_t *dst) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)src);
+        __m256i upper = in_range_avx2(c, 'A', 'Z');
+        __m256i lower = in_range_avx2(c, 'a', 'z');
+        __m256i digit = in_range_avx2(c, '0', '9');
+        __m256i dash  = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-'));
+        __m256i under = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_'));
+        __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                                        _mm256_or_si256(digit, _mm256_or_si256(dash, under)));
+        if (uint32_t(_mm256_movemask_epi8(valid)) != 0xFFFFFFFF)
+            return false;
+        __m256i offset = _mm256_or_si256(
+            _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')),
+                            _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+            _mm256_or_si256(_mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+                            _mm256_or_si256(_mm256_and_si256(dash, _mm256_set1_epi8(62 - '-')),
+                                            _mm256_and_si256(under, _mm256_set1_epi8(63 - '_')))));
+        __m256i v = _mm256_add_epi8(c, offset);
+
+        // Each 32-bit lane holds 4 values [a b c d]; merge them into the 24 bits abcd...
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));     // a<<6|b, c<<6|d
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));        // ab<<12|cd
+        // ...then gather their 3 bytes, big-endian, into the first 12 bytes of each 128-bit lane,
+        // and the two lanes' 12 bytes together:
+        v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                    -1, -1, -1, -1,
+                                                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                                    -1, -1, -1, -1));
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+        _mm_storel_epi64((__m128i*)(dst + 16), _mm256_extracti128_si256(v, 1));
+        return true;
+    }
+
+    static bool cpu_has_avx2() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+    }
+
+#else
+    static bool cpu_has_avx2()                      {return false;}
+#endif // BASE64_X86
+
+    static atomic<bool> sUseSIMD {cpu_has_avx2()};
+
+    bool base64url_set_simd(bool enabled) {
+        sUseSIMD = enabled && cpu_has_avx2();
+        return sUseSIMD;
+    }
+
+
+    output_bytes base64url_decode(string_view in, output_bytes out) {
+        size_t size = base64url_decoded_size(in.size());
+        if (in.size() % 4 == 1 || out.size < size)
+            return {};
+        auto src = in.data();
+        auto dst = (uint8_t*)out.data;
+        size_t n = in.size();
+#ifdef BASE64_X86
+        if (n >= 32 && sUseSIMD) {
+            do {
+                if (!decode32_avx2(src, dst))
+                    return {};
+                src += 32;
+                dst += 24;
+                n -= 32;
+            } while (n >= 32);
+        }
+#endif
+        auto value = [](char c) {return int32_t(kDecode.value[uint8_t(c)]);};
+        for (; n >= 4; n -= 4, src += 4) {
+            int32_t a = value(src[0]), b = value(src[1]), c = value(src[2]), d = value(src[3]);
+            if ((a | b | c | d) < 0)
+                return {};
+            uint32_t w = uint32_t(a) << 18 | uint32_t(b) << 12 | uint32_t(c) << 6 | uint32_t(d);
+            *dst++ = uint8_t(w >> 16);
+            *dst++ = uint8_t(w >> 8);
+            *dst++ = uint8_t(w);
+        }
+        if (n > 0) {
+            int32_t a = value(src[0]), b = value(src[1]), c = (n > 2) ? value(src[2]) : 0;
+            if ((a | b | c) < 0)
+                return {};
+            uint32_t w = uint32_t(a) << 18 | uint32_t(b) << 12 | uint32_t(c) << 6;
+            // The unused low bits of the last character must be zero:
+            if ((w & (n > 2 ? 0xFF : 0xFFFF)) != 0)
+                return {};
+            *dst++ = uint8_t(w >> 16);
+            if (n > 2)
+                *dst++ = uint8_t(w >> 8);
+        }
+        return out.shrunk_to(size);
+    }
+
+
+    //======== PASETO
+
+
+    namespace paseto {
+
+        static constexpr string_view kLocalHeader  = "v4.local.";
+        static constexpr string_view kPublicHeader = "v4.public.";
+
+        // A token's base64url payload and footer, pointing into the token.
+        struct token_parts {
+            string_view payload, footer;
+        };
+
+        static optional<token_parts> parse(string_view token, string_view header) {
+            if (token.substr(0, header.size()) != header)
+                return nullopt;
+            token.remove_prefix(header.size());
+            token_parts parts;
+            if (auto dot = token.find('.'); dot != string_view::npos) {
+                parts.payload = token.substr(0, dot);
+                parts.footer  = token.substr(dot + 1);
+                if (parts.footer.empty())
+                    return nullopt;
+            } else {
+                parts.payload = token;
+            }
+            return parts;
+        }
+
+        static optional<token_parts> parse(string_view token) {
+            if (auto parts = parse(token, kLocalHeader))
+                return parts;
+            return parse(token, kPublicHeader);
+        }
+
+        // Decodes the payload into the start of `buf` and the footer after it. `buf` must have
+        // room for the whole token, which is more than enough.
+        static bool decode(token_parts const& parts, output_bytes buf,
+                           input_bytes &payload, input_bytes &footer) {
+            auto p = base64url_decode(parts.payload, buf);
+            if (!p)
+                return false;
+            auto f = base64url_decode(parts.footer,
+                                      {(uint8_t*)buf.data + p.size, buf.size - p.size});
+            if (!f)
+                return false;
+            payload = {p.data, p.size};
+            footer  = {f.data, f.size};
+            return true;
+        }
+
+
+        // PASETO's "pre-authentication encoding": the number of pieces, then each piece
+        // preceded by its length, all as 64-bit little-endian (with the top bit clear.)
+        static void le64(uint8_t out[8], uint64_t n) {
+            n &= ~(uint64_t(1) << 63);
+            for (int i = 0; i < 8; ++i)
+                out[i] = uint8_t(n >> (8 * i));
+        }
+
+        template <class Builder>
+        static void pae(Builder &b, std::initializer_list<input_bytes> pieces) {
+            uint8_t len[8];
+            le64(len, pieces.size());
+            b.update(len, 8);
+            for (auto &piece : pieces) {
+                le64(len, piece.size);
+                b.update(len, 8);
+                b.update(piece);
+            }
+        }
+
+        // Ed25519's challenge `k = SHA512(R || A || PAE) mod L`, hashing the PAE as it's produced
+        // rather than copying the message into it first.
+        static void challenge(uint8_t k[32], const uint8_t R[32], const uint8_t A[32],
+                              std::initializer_list<input_bytes> pieces)
+        {
+            sha512::builder b;
+            b.update(R, 32).update(A, 32);
+            pae(b, pieces);
+            auto h = b.final();
+            c::crypto_eddsa_reduce(k, h.data());
+        }
+
+        // Signs the PAE of `pieces` the way `crypto_ed25519_sign` signs a message (RFC 8032
+        // 5.1.6), streaming it through both of the hashes that cover it.
+        static signature<Ed25519> sign_pae(key_pair<Ed25519> const& kp,
+                                           std::initializer_list<input_bytes> pieces)
+        {
+            secret_byte_array<64> a;                    // secret scalar, then nonce prefix
+            c::crypto_sha512(a.data(), kp.data(), 32);
+            c::crypto_eddsa_trim_scalar(a.data(), a.data());
+
+            secret_byte_array<32> r;
+            sha512::builder b;
+            b.update(a.data() + 32, 32);
+            pae(b, pieces);
+            auto h = b.final();
+            c::crypto_eddsa_reduce(r.data(), h.data());
+            h.wipe();
+
+            signature<Ed25519> sig;
+            uint8_t k[32];
+            c::crypto_eddsa_scalarbase(sig.data(), r.data());
+            challenge(k, sig.data(), kp.get_public_key().data(), pieces);
+            c::crypto_eddsa_mul_add(sig.data() + 32, k, a.data(), r.data());
+            return sig;
+        }
+
+
+        optional<string> footer(string_view token) {
+            auto parts = parse(token);
+            if (!parts)
+                return nullopt;
+            string result(base64url_decoded_size(parts->footer.size()), '\0');
+            if (!base64url_decode(parts->footer, {result.data(), result.size()}))
+                return nullopt;
+            return result;
+        }
+
+
+        template <class Fn>
+        static optional<string> decode_to_string(string_view token, Fn fn) {
+            string result(token.size(), '\0');
+            output_bytes message = fn(output_bytes{result.data(), result.size()});
+            if (!message)
+                return nullopt;
+            result.resize(message.size);
+            return result;
+        }
+
+
+        //======== V4.LOCAL
+
+
+        // Derives the encryption key, XChaCha20 nonce and authentication key from the token's
+        // nonce `n`.
+        static void local_keys(local::key const& key, byte_array<32> const& n,
+                               secret_byte_array<32> &ek, byte_array<24> &n2,
+                               secret_byte_array<32> &ak)
+        {
+            auto tmp = hash<Blake2b<56>>::mac_builder(key)
+                        .update("paseto-encryption-key"sv).update(n).final();
+            ek.fillWith(&tmp[0], 32);
+            n2.fillWith(&tmp[32], 24);
+            tmp.wipe();
+            auto a = hash<Blake2b<32>>::mac_builder(key)
+                        .update("paseto-auth-key-for-aead"sv).update(n).final();
+            ak.fillWith(a.data(), 32);
+            a.wipe();
+        }
+
+        static byte_array<32> local_tag(secret_byte_array<32> const& ak, byte_array<32> const& n,
+                                        input_bytes c, input_bytes f, input_bytes i)
+        {
+            hash<Blake2b<32>>::mac_builder b(ak);
+            pae(b, {kLocalHeader, n, c, f, i});
+            return byte_array<32>(b.final());
+        }
+
+
+        string local::encrypt(input_bytes message, string_view footer, string_view implicit) const {
+            byte_array<32> nonce;
+            nonce.randomize();
+            return encrypt(message, footer, implicit, nonce);
+        }
+
+        string local::encrypt(input_bytes message, string_view footer, string_view implicit,
+                              byte_array<32> const& n) const
+        {
+            secret_byte_array<32> ek, ak;
+            byte_array<24> n2;
+            local_keys(_key, n, ek, n2, ak);
+
+            // payload = n || c || t
+            string payload(32 + message.size + 32, '\0');
+            auto p = (uint8_t*)payload.data();
+            ::memcpy(p, n.data(), 32);
+            xchacha20_stream(ek, n2).apply(message, p + 32);
+            auto t = local_tag(ak, n, {p + 32, message.size}, footer, implicit);
+            ::memcpy(p + 32 + message.size, t.data(), 32);
+
+            string token(kLocalHeader);
+            token += base64url_encode(payload);
+            if (!footer.empty()) {
+                token += '.';
+                token += base64url_encode(footer);
+            }
+            return token;
+        }
+
+        output_bytes local::decrypt(string_view token, output_bytes message,
+                                    string_view implicit) const
+        {
+            auto parts = parse(token, kLocalHeader);
+            if (!parts || message.size < token.size())
+                return {};
+            input_bytes payload {nullptr, 0}, f {nullptr, 0};
+            if (!decode(*parts, message, payload, f) || payload.size < 64)
+                return {};
+            byte_array<32> n(payload.data, 32);
+            input_bytes c {payload.data + 32, payload.size - 64};
+            byte_array<32> t(c.data + c.size, 32);
+
+            secret_byte_array<32> ek, ak;
+            byte_array<24> n2;
+            local_keys(_key, n, ek, n2, ak);
+            if (local_tag(ak, n, c, f, implicit) != t)
+                return {};
+            ::memmove(message.data, c.data, c.size);
+            xchacha20_stream(ek, n2).apply({message.data, c.size}, message.data);
+            return message.shrunk_to(c.size);
+        }
+
+        optional<string> local::decrypt(string_view token, string_view implicit) const {
+            return decode_to_string(token, [&](output_bytes buf) {
+                return decrypt(token, buf, implicit);
+            });
+        }
+
+
+        //======== V4.PUBLIC
+
+
+        string signer::sign(input_bytes message, string_view footer, string_view implicit) const {
+            auto sig = sign_pae(_key_pair, {kPublicHeader, message, footer, implicit});
+
+            string payload((const char*)message.data, message.size);
+            payload.append((const char*)sig.data(), sig.size());
+            string token(kPublicHeader);
+            token += base64url_encode(payload);
+            if (!footer.empty()) {
+                token += '.';
+                token += base64url_encode(footer);
+            }
+            return token;
+        }
+
+
+        verifier::verifier(public_key<Ed25519> const& key, size_t cache_capacity,
+                           clock::duration cache_lifetime)
+        :_key(key)
+        ,_capacity(cache_capacity)
+        ,_lifetime(cache_lifetime)
+        {
+            _cache_key.randomize();
+        }
+
+        output_bytes verifier::verify(string_view token, output_bytes message,
+                                      string_view implicit) const
+        {
+            auto parts = parse(token, kPublicHeader);
+            if (!parts || message.size < token.size())
+                return {};
+
+            digest d;
+            if (_capacity > 0) {
+                d = token_digest(token, implicit);
+                if (cache_lookup(d)) {
+                    // Already verified; just decode the message.
+                    if (auto payload = base64url_decode(parts->payload, message);
+                            payload && payload.size >= sizeof(signature<Ed25519>))
+                        return payload.shrunk_to(payload.size - sizeof(signature<Ed25519>));
+                }
+            }
+
+            input_bytes payload {nullptr, 0}, f {nullptr, 0};
+            if (!decode(*parts, message, payload, f) || payload.size < sizeof(signature<Ed25519>))
+                return {};
+            input_bytes m {payload.data, payload.size - sizeof(signature<Ed25519>)};
+            signature<Ed25519> sig(m.data + m.size, sizeof(signature<Ed25519>));
+
+            uint8_t k[32];
+            challenge(k, sig.data(), _key.data(), {kPublicHeader, m, f, implicit});
+            if (!check_signature_equation(signature_rules::strict, sig.data(), _key.data(), k))
+                return {};
+            if (_capacity > 0)
+                cache_insert(d);
+            return message.shrunk_to(m.size);
+        }
+
+        optional<string> verifier::verify(string_view token, string_view implicit) const {
+            return decode_to_string(token, [&](output_bytes buf) {
+                return verify(token, buf, implicit);
+            });
+        }
+
+
+        // The cache key is a MAC of the token and implicit assertion, under a random per-verifier
+        // key, so entries can't be forged by finding hash collisions offline.
+        verifier::digest verifier::token_digest(string_view token, string_view implicit) const {
+            hash<Blake2b<32>>::mac_builder b(_cache_key);
+            pae(b, {token, implicit});
+            return digest(b.final());
+        }
+
+        bool verifier::cache_lookup(digest const& d) const {
+            unique_lock<mutex> lock(_mutex);
+            auto i = _cache.find(d);
+            if (i == _cache.end())
+                return false;
+            if (clock::now() >= i->second.expires) {
+                _order.erase(i->second.age);
+                _cache.erase(i);
+                return false;
+            }
+            ++_hits;
+            return true;
+        }
+
+        void verifier::cache_insert(digest const& d) const {
+            unique_lock<mutex> lock(_mutex);
+            if (_cache.find(d) != _cache.end())
+                return;
+            while (_cache.size() >= _capacity) {
+                _cache.erase(_order.front());
+                _order.pop_front();
+            }
+            _order.push_back(d);
+            _cache.emplace(d, entry{clock::now() + _lifetime, prev(_order.end())});
+        }
+
+        size_t verifier::cache_size() const {
+            unique_lock<mutex> lock(_mutex);
+            return _cache.size();
+        }
+
+        uint64_t verifier::cache_hits() const {
+            unique_lock<mutex> lock(_mutex);
+            return _hits;
+        }
+
+    }
+
+}
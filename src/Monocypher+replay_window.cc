@@ -0,0 +1,106 @@
+//
+//  monocypher/Monocypher+replay_window.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/replay_window.hh"
+#include <stdexcept>
+
+namespace monocypher::ext {
+    using namespace std;
+
+    // A slot's 64 bits are `tag << 32 | bits`, where the tag is the low 32 bits of the block
+    // number (seq / 32) whose sequence numbers are recorded in `bits`. A slot's block only ever
+    // moves forward, so a block whose tag isn't in its slot has never been recorded.
+    // (Tags are compared modulo 2^32, which is only ambiguous if a slot goes unused across a
+    // jump of 2^36 sequence numbers; then a fresh number might be rejected, never a repeat
+    // accepted.)
+
+    static inline uint32_t slot_tag(uint64_t slot)  {return uint32_t(slot >> 32);}
+
+    // Compares the block recorded in a slot to `block`: <0 if it's older, 0 if the same.
+    static inline int32_t compare_tag(uint64_t slot, uint64_t block) {
+        return int32_t(slot_tag(slot) - uint32_t(block));
+    }
+
+
+    replay_window::replay_window(size_t width)
+    :_slot_count((width + kBitsPerSlot - 1) / kBitsPerSlot + 1)    // +1 for the partial block
+    ,_slots(new atomic<uint64_t>[_slot_count])
+    {
+        if (width == 0)
+            throw invalid_argument("replay_window width must be nonzero");
+        for (size_t i = 0; i < _slot_count; ++i)
+            _slots[i].store(0, memory_order_relaxed);
+    }
+
+
+    bool replay_window::check(uint64_t seq) const {
+        if (too_old(seq))
+            return false;
+        uint64_t block = seq / kBitsPerSlot;
+        uint64_t bit = uint64_t(1) << (seq % kBitsPerSlot);
+        uint64_t slot = slot_for(block).load(memory_order_acquire);
+        int32_t cmp = compare_tag(slot, block);
+        return cmp < 0 || (cmp == 0 && !(slot & bit));
+    }
+
+
+    bool replay_window::commit(uint64_t seq) {
+        if (too_old(seq))
+            return false;
+        uint64_t block = seq / kBitsPerSlot;
+        uint64_t bit = uint64_t(1) << (seq % kBitsPerSlot);
+        uint64_t tagged_block = uint64_t(uint32_t(block)) << 32;
+        atomic<uint64_t> &slot = slot_for(block);
+
+        uint64_t cur = slot.load(memory_order_acquire);
+        uint64_t next;
+        do {
+            int32_t cmp = compare_tag(cur, block);
+            if (cmp > 0 || (cmp == 0 && (cur & bit)))
+                return false;                       // Slot has moved on, or seq is a replay
+            else if (cmp == 0)
+                next = cur | bit;
+            else
+                next = tagged_block | bit;          // Reuse the slot for this block
+        } while (!slot.compare_exchange_weak(cur, next, memory_order_acq_rel,
+                                             memory_order_acquire));
+
+        // Advance `_top` if this is the highest sequence number yet:
+        uint64_t top = _top.load(memory_order_relaxed);
+        while (seq >= top && !_top.compare_exchange_weak(top, seq + 1, memory_order_acq_rel,
+                                                         memory_order_relaxed))
+            { }
+        return true;
+    }
+
+}
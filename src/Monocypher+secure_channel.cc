@@ -0,0 +1,356 @@
+//
+//  monocypher/Monocypher+secure_channel.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/secure_channel.hh"
+#include "monocypher/hash.hh"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    static void store32_le(uint8_t *dst, uint32_t n) {
+        for (int i = 0; i < 4; ++i, n >>= 8)
+            dst[i] = uint8_t(n & 0xFF);
+    }
+
+    static uint32_t load32_le(const uint8_t *src) {
+        return src[0] | (uint32_t(src[1]) << 8) | (uint32_t(src[2]) << 16) | (uint32_t(src[3]) << 24);
+    }
+
+    [[noreturn]] static void throw_errno(const char *what) {
+        throw system_error(errno, generic_category(), what);
+    }
+
+
+    // Incrementally computes the same output as `crypto_aead_lock` (XChaCha20-Poly1305, no
+    // additional data), so plaintext can be encrypted piecemeal straight into a record buffer.
+    class secure_channel::record_sealer {
+    public:
+        ~record_sealer() {
+            c::crypto_wipe(&_poly, sizeof(_poly));
+        }
+
+        void begin(key const& k, session::nonce const& nonce) {
+            c::crypto_chacha20_h(_subkey.data(), k.data(), nonce.data());
+            ::memcpy(_nonce.data(), &nonce[16], 8);
+            byte_array<64> auth_key;
+            c::crypto_chacha20_djb(auth_key.data(), nullptr, 64, _subkey.data(), _nonce.data(), 0);
+            c::crypto_poly1305_init(&_poly, auth_key.data());
+            auth_key.wipe();
+            _counter = 1;
+            _stream_pos = 64;
+            _size = 0;
+        }
+
+        void update(const uint8_t *in, uint8_t *out, size_t size) {
+            uint8_t *start = out;
+            size_t total = size;
+            // Use up the keystream left over from the last call:
+            for (; size > 0 && _stream_pos < 64; --size)
+                *out++ = *in++ ^ _stream[_stream_pos++];
+            // Whole blocks:
+            if (size_t whole = size & ~size_t(63); whole > 0) {
+                _counter = c::crypto_chacha20_djb(out, in, whole, _subkey.data(), _nonce.data(),
+                                                  _counter);
+                in += whole;
+                out += whole;
+                size -= whole;
+            }
+            // Partial block; save the rest of the keystream for next time:
+            if (size > 0) {
+                _counter = c::crypto_chacha20_djb(_stream.data(), nullptr, 64,
+                                                  _subkey.data(), _nonce.data(), _counter);
+                for (size_t i = 0; i < size; ++i)
+                    out[i] = in[i] ^ _stream[i];
+                _stream_pos = size;
+            }
+            c::crypto_poly1305_update(&_poly, start, total);
+            _size += total;
+        }
+
+        void finish(uint8_t mac[16]) {
+            static constexpr uint8_t zero[16] = {};
+            c::crypto_poly1305_update(&_poly, zero, (16 - (_size & 15)) & 15);
+            uint8_t sizes[16] = {};                     // ad_size (0), then text size
+            for (size_t i = 0, n = _size; i < 8; ++i, n >>= 8)
+                sizes[8 + i] = uint8_t(n & 0xFF);
+            c::crypto_poly1305_update(&_poly, sizes, 16);
+            c::crypto_poly1305_final(&_poly, mac);
+        }
+
+    private:
+        secret_byte_array<32> _subkey;
+        byte_array<8>         _nonce;
+        secret_byte_array<64> _stream;
+        size_t                _stream_pos;
+        uint64_t              _counter;
+        size_t                _size;
+        c::crypto_poly1305_ctx _poly;
+    };
+
+
+    secure_channel::secure_channel(int fd, key const& send_key, key const& receive_key)
+    :secure_channel(fd, send_key, receive_key, options{})
+    { }
+
+
+    secure_channel::secure_channel(int fd, key const& send_key, key const& receive_key,
+                                   options const& opts)
+    :_fd(fd)
+    ,_options(opts)
+    ,_send_key(send_key)
+    ,_receive_key(receive_key)
+    ,_sealer(make_unique<record_sealer>())
+    {
+        if (_options.max_record_size == 0 || _options.max_record_size > UINT32_MAX
+                || _options.max_queued_records == 0 || _options.rekey_interval == 0)
+            throw invalid_argument("invalid secure_channel options");
+        _options.max_queued_records = min(_options.max_queued_records, size_t(IOV_MAX));
+        _records.resize(_options.max_queued_records + 1);
+        _record_sizes.resize(_options.max_queued_records + 1);
+        _recv_capacity = 2 * (header_size + _options.max_record_size);
+        _recv_buf = make_unique<uint8_t[]>(_recv_capacity);
+    }
+
+
+    secure_channel::~secure_channel() {
+        c::crypto_wipe(_recv_buf.get(), _recv_capacity);
+    }
+
+
+    void secure_channel::rekey(key &k) {
+        auto h = blake2b32::createMAC("monocypher secure_channel rekey"sv, k);
+        k = key(h.data(), h.size());
+        h.wipe();
+    }
+
+
+    //======== WRITING
+
+
+    void secure_channel::begin_record() {
+        auto &buf = _records[_queued];
+        if (!buf)
+            buf = make_unique<uint8_t[]>(header_size + _options.max_record_size);
+        _record_sizes[_queued] = 0;
+        _sealer->begin(_send_key, session::nonce(_send_seq));
+        _open = true;
+    }
+
+
+    void secure_channel::seal_record() {
+        uint8_t *buf = _records[_queued].get();
+        size_t size = _record_sizes[_queued];
+        store32_le(buf, uint32_t(size));
+        _sealer->finish(buf + 4);
+        _record_sizes[_queued] = header_size + size;
+        _open = false;
+        ++_queued;
+        if (++_send_seq % _options.rekey_interval == 0)
+            rekey(_send_key);
+        if (_queued >= _options.max_queued_records)
+            send_queued();
+    }
+
+
+    void secure_channel::write(input_bytes data) {
+        while (data.size > 0) {
+            if (!_open)
+                begin_record();
+            size_t &size = _record_sizes[_queued];
+            size_t n = min(data.size, _options.max_record_size - size);
+            _sealer->update(data.data, _records[_queued].get() + header_size + size, n);
+            size += n;
+            data.consume(n);
+            if (size == _options.max_record_size)
+                seal_record();
+        }
+    }
+
+
+    void secure_channel::flush() {
+        if (_open && _record_sizes[_queued] > 0)
+            seal_record();
+        send_queued();
+    }
+
+
+    void secure_channel::close_write() {
+        flush();
+        if (!_open)
+            begin_record();
+        seal_record();          // an empty record marks the end of the stream
+        send_queued();
+        if (::shutdown(_fd, SHUT_WR) != 0 && errno != ENOTSOCK)
+            throw_errno("secure_channel shutdown");
+    }
+
+
+    // Sends all sealed records with as few syscalls as possible.
+    void secure_channel::send_queued() {
+        if (_queued == 0)
+            return;
+        iovec iov[IOV_MAX];
+        for (size_t i = 0; i < _queued; ++i)
+            iov[i] = {_records[i].get(), _record_sizes[i]};
+        iovec *next = iov, *end = iov + _queued;
+        while (next < end) {
+            ssize_t n;
+            if (!_use_writev) {
+                msghdr msg = {};
+                msg.msg_iov = next;
+                msg.msg_iovlen = decltype(msg.msg_iovlen)(end - next);
+                int flags = 0;
+#ifdef MSG_NOSIGNAL
+                flags = MSG_NOSIGNAL;
+#endif
+                n = ::sendmsg(_fd, &msg, flags);
+                if (n < 0 && errno == ENOTSOCK) {
+                    _use_writev = true;     // Not a socket (a pipe?); fall back to writev
+                    continue;
+                }
+            } else {
+                n = ::writev(_fd, next, int(end - next));
+            }
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw_errno("secure_channel write");
+            }
+            // Skip past the data that was written:
+            for (size_t written = size_t(n); written > 0; ) {
+                size_t chunk = min(written, next->iov_len);
+                next->iov_base = (uint8_t*)next->iov_base + chunk;
+                next->iov_len -= chunk;
+                written -= chunk;
+                if (next->iov_len == 0)
+                    ++next;
+            }
+        }
+        if (_open) {
+            // Move the open (unsealed) record's buffer to the front:
+            swap(_records[0], _records[_queued]);
+            _record_sizes[0] = _record_sizes[_queued];
+        }
+        _queued = 0;
+    }
+
+
+    //======== READING
+
+
+    // Reads the next record into the buffer and decrypts it in place.
+    bool secure_channel::receive_record() {
+        uint8_t *buf = _recv_buf.get();
+        if (_record_end > 0) {
+            // Discard the previous record:
+            _recv_len -= _record_end;
+            ::memmove(buf, buf + _record_end, _recv_len);
+            _record_end = _plain_pos = _plain_end = 0;
+        }
+
+        auto fill_to = [&](size_t size) {
+            while (_recv_len < size) {
+                ssize_t n = ::read(_fd, buf + _recv_len, _recv_capacity - _recv_len);
+                if (n > 0)
+                    _recv_len += size_t(n);
+                else if (n == 0)
+                    return false;               // EOF without end-of-stream record: truncated
+                else if (errno != EINTR)
+                    throw_errno("secure_channel read");
+            }
+            return true;
+        };
+
+        if (!fill_to(header_size))
+            return false;
+        size_t size = load32_le(buf);
+        if (size > _options.max_record_size || !fill_to(header_size + size))
+            return false;
+
+        session::mac mac;
+        mac.fillWith(buf + 4, sizeof(mac));
+        uint8_t *text = buf + header_size;
+        if (!_receive_key.unlock(session::nonce(_recv_seq), mac, {text, size}, text))
+            return false;
+        if (++_recv_seq % _options.rekey_interval == 0)
+            rekey(_receive_key);
+        _plain_pos = header_size;
+        _plain_end = _record_end = header_size + size;
+        if (size == 0)
+            _eof = true;
+        return true;
+    }
+
+
+    output_bytes secure_channel::read(output_bytes buffer) {
+        while (_plain_pos == _plain_end) {
+            if (_failed)
+                return {};
+            if (_eof)
+                return buffer.shrunk_to(0);
+            if (!receive_record()) {
+                _failed = true;
+                c::crypto_wipe(_recv_buf.get(), _recv_capacity);
+                return {};
+            }
+        }
+        size_t n = min(buffer.size, _plain_end - _plain_pos);
+        ::memcpy(buffer.data, _recv_buf.get() + _plain_pos, n);
+        _plain_pos += n;
+        return buffer.shrunk_to(n);
+    }
+
+
+    bool secure_channel::read_exactly(output_bytes buffer) {
+        while (buffer.size > 0) {
+            output_bytes got = read(buffer);
+            if (got.size == 0)
+                return false;
+            buffer = {u8(buffer.data) + got.size, buffer.size - got.size};
+        }
+        return true;
+    }
+
+}
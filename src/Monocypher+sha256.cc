@@ -61,5 +61,25 @@ namespace monocypher::ext {
         sha256_final((SHA256_CTX*)ctx, hash);
     }
 
+    void SHA256::save_fn(const context *ctx, std::vector<uint8_t> &out) {
+        auto sha = (const SHA256_CTX*)ctx;
+        internal::state_writer w{out};
+        for (uint32_t s : sha->state)   w.u32(s);
+        w.u64(sha->bitlen);
+        w.u32(sha->datalen);
+        w.bytes(sha->data, sizeof(sha->data));
+    }
+
+    void SHA256::restore_fn(context *ctx, const uint8_t *state, size_t size) {
+        auto sha = (SHA256_CTX*)ctx;
+        internal::state_reader r{state, state + size};
+        for (uint32_t &s : sha->state)  s = r.u32();
+        sha->bitlen = r.u64();
+        sha->datalen = r.u32();
+        r.bytes(sha->data, sizeof(sha->data));
+        r.check(sha->datalen < 64);
+        r.finish();
+    }
+
 
 }
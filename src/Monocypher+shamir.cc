@@ -0,0 +1,315 @@
+//
+//  monocypher/Monocypher+shamir.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/shamir.hh"
+#include "monocypher/hash.hh"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#   define SHAMIR_X86 1
+#   include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   define SHAMIR_NEON 1
+#   include <arm_neon.h>
+#endif
+
+namespace monocypher::ext {
+    using namespace std;
+
+
+    //======== GF(2^8) ARITHMETIC
+
+
+    // Constant-time multiplication in GF(2^8) modulo x^8 + x^4 + x^3 + x + 1.
+    static inline uint8_t gf_mul(uint8_t a, uint8_t b) {
+        uint8_t r = 0;
+        for (int i = 0; i < 8; ++i) {
+            r ^= a & uint8_t(-(b & 1));
+            b >>= 1;
+            a = uint8_t((a << 1) ^ (0x1B & -(a >> 7)));
+        }
+        return r;
+    }
+
+    // Multiplicative inverse: a^254. (Only ever applied to public x-coordinates.)
+    static uint8_t gf_inv(uint8_t a) {
+        uint8_t result = 1;
+        for (int i = 0; i < 7; ++i) {           // 254 = 0b11111110
+            a = gf_mul(a, a);
+            result = gf_mul(result, a);
+        }
+        return result;
+    }
+
+
+    // The bulk operation everything is built on: dst[i] = c * src[i] ^ add[i].
+    // `c * b` is computed as lo[b & 0xF] ^ hi[b >> 4], where lo and hi are c times every low and
+    // high nibble. The SIMD versions do 16 or 32 of those lookups with one shuffle instruction,
+    // keeping the tables in registers, so there are no secret-dependent memory accesses.
+    // Each returns the number of bytes it processed (a multiple of its vector size.)
+
+    namespace {
+        struct mul_tables {
+            uint8_t lo[16], hi[16];
+
+            explicit mul_tables(uint8_t c) {
+                for (int i = 0; i < 16; ++i) {
+                    lo[i] = gf_mul(c, uint8_t(i));
+                    hi[i] = gf_mul(c, uint8_t(i << 4));
+                }
+            }
+        };
+    }
+
+    using muladd_fn = size_t (*)(uint8_t *dst, const uint8_t *src, const uint8_t *add, size_t n,
+                                 mul_tables const&);
+
+    static size_t muladd_none(uint8_t*, const uint8_t*, const uint8_t*, size_t, mul_tables const&) {
+        return 0;
+    }
+
+#ifdef SHAMIR_X86
+    __attribute__((target("ssse3")))
+    static size_t muladd_ssse3(uint8_t *dst, const uint8_t *src, const uint8_t *add, size_t n,
+                               mul_tables const& t)
+    {
+        const __m128i lo = _mm_loadu_si128((const __m128i*)t.lo);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)t.hi);
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+            __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, mask));
+            __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(v, 4), mask));
+            __m128i a = _mm_loadu_si128((const __m128i*)(add + i));
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(_mm_xor_si128(l, h), a));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    static size_t muladd_avx2(uint8_t *dst, const uint8_t *src, const uint8_t *add, size_t n,
+                              mul_tables const& t)
+    {
+        const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t.lo));
+        const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)t.hi));
+        const __m256i mask = _mm256_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+            __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(v, mask));
+            __m256i h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(v, 4), mask));
+            __m256i a = _mm256_loadu_si256((const __m256i*)(add + i));
+            _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(_mm256_xor_si256(l, h), a));
+        }
+        return i;
+    }
+#endif
+
+#ifdef SHAMIR_NEON
+    static size_t muladd_neon(uint8_t *dst, const uint8_t *src, const uint8_t *add, size_t n,
+                              mul_tables const& t)
+    {
+        const uint8x16_t lo = vld1q_u8(t.lo), hi = vld1q_u8(t.hi);
+        const uint8x16_t mask = vdupq_n_u8(0x0F);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            uint8x16_t v = vld1q_u8(src + i);
+            uint8x16_t l = vqtbl1q_u8(lo, vandq_u8(v, mask));
+            uint8x16_t h = vqtbl1q_u8(hi, vshrq_n_u8(v, 4));
+            vst1q_u8(dst + i, veorq_u8(veorq_u8(l, h), vld1q_u8(add + i)));
+        }
+        return i;
+    }
+#endif
+
+    static muladd_fn choose_muladd() {
+#if defined(SHAMIR_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return muladd_avx2;
+        if (__builtin_cpu_supports("ssse3"))
+            return muladd_ssse3;
+#elif defined(SHAMIR_NEON)
+        return muladd_neon;
+#endif
+        return muladd_none;
+    }
+
+    static void gf_muladd(uint8_t *dst, const uint8_t *src, uint8_t c, const uint8_t *add,
+                          size_t n)
+    {
+        static const muladd_fn simd_muladd = choose_muladd();
+        mul_tables tables(c);
+        size_t i = simd_muladd(dst, src, add, n, tables);
+        for (; i < n; ++i)
+            dst[i] = gf_mul(c, src[i]) ^ add[i];        // (bitwise, not table lookup)
+        wipe(&tables, sizeof(tables));
+    }
+
+
+    //======== SPLIT / COMBINE
+
+
+    static constexpr size_t kChunkSize = 16 * 1024;
+    static constexpr uint8_t kShareVersion = 1;
+
+
+    static byte_array<32> make_commitment(byte_array<16> const& salt, input_bytes secret) {
+        return blake2b32::builder().update(salt).update(secret).final();
+    }
+
+
+    vector<shamir::share> shamir::split(input_bytes secret, unsigned threshold, unsigned count) {
+        if (threshold < 1 || threshold > count || count > 255)
+            throw invalid_argument("invalid Shamir threshold or share count");
+        vector<share> shares(count);
+        byte_array<16> salt;
+        salt.randomize();
+        byte_array<32> commitment = make_commitment(salt, secret);
+        for (unsigned s = 0; s < count; ++s) {
+            shares[s].x = uint8_t(s + 1);
+            shares[s].threshold = uint8_t(threshold);
+            shares[s].salt = salt;
+            shares[s].commitment = commitment;
+            shares[s].y.resize(secret.size);
+        }
+
+        // Each byte of the secret is the constant term of its own random polynomial of degree
+        // threshold-1. Process the secret in chunks, so the random coefficients stay in cache.
+        size_t degree = threshold - 1;
+        auto coeffs = make_unique<uint8_t[]>(max(degree, size_t(1)) * kChunkSize);
+        for (size_t pos = 0; pos < secret.size; pos += kChunkSize) {
+            size_t n = min(kChunkSize, secret.size - pos);
+            if (degree > 0)
+                randomize(coeffs.get(), degree * kChunkSize);
+            auto coeff = [&](size_t j) {          // j'th coefficient of the chunk (0 = secret)
+                return j ? &coeffs[(j - 1) * kChunkSize] : secret.data + pos;
+            };
+            for (auto &sh : shares) {
+                // Evaluate at x by Horner's rule: y = (...(c[d] * x + c[d-1]) * x + ...) + c[0]
+                uint8_t *y = &sh.y[pos];
+                ::memcpy(y, coeff(degree), n);
+                for (size_t j = degree; j-- > 0; )
+                    gf_muladd(y, y, sh.x, coeff(j), n);
+            }
+        }
+        wipe(coeffs.get(), max(degree, size_t(1)) * kChunkSize);
+        return shares;
+    }
+
+
+    bool shamir::combine(const share shares[], size_t count, output_bytes secret_out) {
+        if (count == 0)
+            return false;
+        share const& first = shares[0];
+        size_t threshold = first.threshold;
+
+        // Pick `threshold` shares with distinct x's, all from the same split:
+        vector<const share*> use;
+        for (size_t i = 0; i < count && use.size() < threshold; ++i) {
+            share const& sh = shares[i];
+            if (sh.threshold != threshold || sh.salt != first.salt
+                    || sh.commitment != first.commitment || sh.y.size() != secret_out.size
+                    || sh.x == 0)
+                return false;
+            if (none_of(use.begin(), use.end(), [&](auto u) {return u->x == sh.x;}))
+                use.push_back(&sh);
+        }
+        if (threshold == 0 || use.size() < threshold)
+            return false;
+
+        // Lagrange interpolation at x=0: secret = sum of y_i * prod_{j!=i} x_j / (x_j - x_i)
+        // (Subtraction is XOR in GF(2^8).)
+        auto out = u8(secret_out.data);
+        ::memset(out, 0, secret_out.size);
+        for (auto si : use) {
+            uint8_t num = 1, den = 1;
+            for (auto sj : use) {
+                if (sj != si) {
+                    num = gf_mul(num, sj->x);
+                    den = gf_mul(den, sj->x ^ si->x);
+                }
+            }
+            gf_muladd(out, si->y.data(), gf_mul(num, gf_inv(den)), out, secret_out.size);
+        }
+
+        if (make_commitment(first.salt, {out, secret_out.size}) != first.commitment) {
+            wipe(out, secret_out.size);
+            return false;
+        }
+        return true;
+    }
+
+
+    //======== SERIALIZATION
+
+
+    static constexpr size_t kShareHeaderSize = 1 + 1 + 1 + 16 + 32;
+    static constexpr size_t kShareChecksumSize = 16;
+
+
+    vector<uint8_t> shamir::share::to_bytes() const {
+        vector<uint8_t> out;
+        out.reserve(kShareHeaderSize + y.size() + kShareChecksumSize);
+        out.push_back(kShareVersion);
+        out.push_back(x);
+        out.push_back(threshold);
+        out.insert(out.end(), salt.begin(), salt.end());
+        out.insert(out.end(), commitment.begin(), commitment.end());
+        out.insert(out.end(), y.begin(), y.end());
+        auto checksum = hash<Blake2b<kShareChecksumSize>>::create(out.data(), out.size());
+        out.insert(out.end(), checksum.begin(), checksum.end());
+        return out;
+    }
+
+
+    bool shamir::share::from_bytes(input_bytes in) {
+        if (in.size < kShareHeaderSize + kShareChecksumSize || in.data[0] != kShareVersion)
+            return false;
+        size_t body_size = in.size - kShareChecksumSize;
+        auto checksum = hash<Blake2b<kShareChecksumSize>>::create(in.data, body_size);
+        if (0 != ::memcmp(checksum.data(), in.data + body_size, kShareChecksumSize))
+            return false;
+        x = in.data[1];
+        threshold = in.data[2];
+        salt.fillWith(in.data + 3, 16);
+        commitment.fillWith(in.data + 19, 32);
+        wipe(y.data(), y.size());
+        y.assign(in.data + kShareHeaderSize, in.data + body_size);
+        return true;
+    }
+
+}
@@ -0,0 +1,201 @@
+//
+//  Monocypher+signature_rules.cc
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "monocypher/ext/signature_batch.hh"
+#include "edwards25519.hh"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// The explicit signature-verification rules, on top of the variable-time Edwards25519 arithmetic
+// in edwards25519.hh: everything they handle (public keys, signatures, messages) is public.
+
+namespace monocypher {
+    using namespace std;
+    using namespace edwards25519;
+
+
+    //======== MULTI-SCALAR MULTIPLICATION
+
+
+    // The odd and even multiples [1]P ... [8]P of a point, for signed 4-bit windows.
+    struct ge_table {
+        ge_cached multiple[8];
+
+        explicit ge_table(const ge &p) {
+            ge_cached pc = ge_to_cached(p);
+            ge q = p;
+            multiple[0] = pc;
+            for (int i = 1; i < 8; ++i) {
+                q = ge_add(q, pc);
+                multiple[i] = ge_to_cached(q);
+            }
+        }
+    };
+
+    // A scalar (less than 2^253) recoded as 64 signed radix-16 digits in [-8, 8].
+    struct scalar_digits {
+        int8_t d[64];
+
+        explicit scalar_digits(const uint8_t s[32]) {
+            for (int i = 0; i < 32; ++i) {
+                d[2 * i]     = int8_t(s[i] & 0x0F);
+                d[2 * i + 1] = int8_t(s[i] >> 4);
+            }
+            int carry = 0;
+            for (int i = 0; i < 63; ++i) {
+                d[i] = int8_t(d[i] + carry);
+                carry = (d[i] + 8) >> 4;
+                d[i] = int8_t(d[i] - carry * 16);
+            }
+            d[63] = int8_t(d[63] + carry);
+        }
+    };
+
+    struct msm_term {
+        const ge_table *table;
+        scalar_digits   digits;
+    };
+
+    // Straus' method: computes the sum of [scalar]point over all terms, sharing one chain of
+    // doublings among all of them. Variable-time.
+    static ge multiscalar_mul(const msm_term *terms, size_t count) {
+        ge acc = ge_identity();
+        for (int i = 63; i >= 0; --i) {
+            if (i < 63) {
+                for (int j = 0; j < 4; ++j)
+                    acc = ge_double(acc);
+            }
+            for (size_t t = 0; t < count; ++t) {
+                int d = terms[t].digits.d[i];
+                if (d > 0)
+                    acc = ge_add(acc, terms[t].table->multiple[d - 1]);
+                else if (d < 0)
+                    acc = ge_sub(acc, terms[t].table->multiple[-d - 1]);
+            }
+        }
+        return acc;
+    }
+
+    static const ge_table& base_table() {
+        static const ge_table table = [] {
+            ge b;
+            ge_frombytes(b, kBase, true);
+            return ge_table(b);
+        }();
+        return table;
+    }
+
+
+    //======== SIGNATURE VERIFICATION
+
+
+    bool check_signature_equation(signature_rules rules,
+                                  const uint8_t sig[64], const uint8_t pk[32], const uint8_t k[32])
+    {
+        if (rules == signature_rules::monocypher)
+            throw invalid_argument("check_signature_equation does not implement Monocypher's rules");
+        const uint8_t *S = sig + 32;
+        if (!scalar_is_canonical(S))
+            return false;
+        bool strict = (rules == signature_rules::strict);
+        ge A, R;
+        if (!ge_frombytes(A, pk, strict) || !ge_frombytes(R, sig, strict))
+            return false;
+        if (strict && (ge_has_small_order(A) || ge_has_small_order(R)))
+            return false;
+
+        // P = [S]B - [k]A
+        ge_table minusA(ge_neg(A));
+        msm_term terms[2] = {{&base_table(), scalar_digits(S)}, {&minusA, scalar_digits(k)}};
+        ge P = multiscalar_mul(terms, 2);
+        if (strict)
+            return ge_equal(P, R);                              // [S]B = R + [k]A
+        else
+            return ge_is_identity(ge_mul_cofactor(ge_sub(P, ge_to_cached(R)))); // [8]([S]B - R - [k]A) = 0
+    }
+
+}
+
+
+namespace monocypher::ext {
+    using namespace std;
+
+    // Signatures per multi-scalar multiplication; bounds the size of the point tables.
+    static constexpr size_t kBatchChunk = 64;
+
+    static bool verify_chunk(const signature_batch_item *items, size_t n) {
+        static constexpr uint8_t kZero[32] = {};
+        vector<ge_table> tables;
+        tables.reserve(2 * n);
+        vector<msm_term> terms;
+        terms.reserve(2 * n + 1);
+
+        // Random 128-bit coefficients z_i; the batch equation is
+        //   [8]( [sum z_i S_i]B - sum [z_i]R_i - sum [z_i k_i]A_i ) = 0
+        uint8_t z[kBatchChunk][32] = {};
+        for (size_t i = 0; i < n; ++i)
+            randomize(z[i], 16);
+
+        uint8_t sumS[32] = {};
+        for (size_t i = 0; i < n; ++i) {
+            auto &item = items[i];
+            const uint8_t *S = item.sig + 32;
+            ge A, R;
+            if (!scalar_is_canonical(S) || !ge_frombytes(A, item.A, false)
+                                        || !ge_frombytes(R, item.sig, false))
+                return false;
+            c::crypto_eddsa_mul_add(sumS, z[i], S, sumS);
+            uint8_t zk[32];
+            c::crypto_eddsa_mul_add(zk, z[i], item.k, kZero);
+
+            tables.emplace_back(ge_neg(R));
+            terms.push_back({&tables.back(), scalar_digits(z[i])});
+            tables.emplace_back(ge_neg(A));
+            terms.push_back({&tables.back(), scalar_digits(zk)});
+        }
+        terms.push_back({&base_table(), scalar_digits(sumS)});
+        return ge_is_identity(ge_mul_cofactor(multiscalar_mul(terms.data(), terms.size())));
+    }
+
+    bool verify_signature_batch(const signature_batch_item *items, size_t count) {
+        for (size_t i = 0; i < count; i += kBatchChunk) {
+            if (!verify_chunk(&items[i], std::min(kBatchChunk, count - i)))
+                return false;
+        }
+        return true;
+    }
+
+}
@@ -29,7 +29,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "monocypher/ext/xsalsa20.hh"
-#include <memory>
+#include <algorithm>
 #include <cstring>
 
 // Wrap 3rd party tweetnacl.c in a namespace to avoid messing with global namespace:
@@ -47,12 +47,53 @@ namespace monocypher::tweetnacl {
 namespace monocypher::ext {
     using namespace monocypher::tweetnacl;
 
-    // NaCL's `secretbox` C API is batshit crazy:  https://nacl.cr.yp.to/secretbox.html 🤯
-    // It requires 32 zero bytes before the plaintext,
-    // and writes 16 zero bytes before the mac-and-ciphertext.
-    // The size parameter needs to include those 32 bytes.
-    // Unboxing is the reverse.
-    // WTF.
+    // NaCl's `secretbox` C API requires 32 zero bytes before the plaintext, and writes 16 zero
+    // bytes before the mac-and-ciphertext, which would force us to copy into temporary buffers.
+    // Instead we implement secretbox here from its parts: XSalsa20, whose first 32 bytes of
+    // keystream are the Poly1305 key and the rest encrypt the message, and Poly1305 (which is
+    // Monocypher's.) No heap allocation, and the input and output may be the same buffer.
+
+    namespace {
+        struct xsalsa20_stream {
+            uint8_t subkey[32];
+            uint8_t input[16];      // 8-byte nonce, 8-byte block counter
+            uint8_t block0[64];     // First block: Poly1305 key, then 32 bytes of keystream
+
+            xsalsa20_stream(const uint8_t key[32], const uint8_t nonce[24]) {
+                crypto_core_hsalsa20(subkey, nonce, key, sigma);
+                memcpy(input, nonce + 16, 8);
+                memset(input + 8, 0, 8);
+                crypto_core_salsa20(block0, input, subkey, sigma);
+            }
+
+            ~xsalsa20_stream() {
+                crypto_wipe(this, sizeof(*this));
+            }
+
+            const uint8_t* poly1305_key() const {return block0;}
+
+            // XORs `size` bytes of the stream following the Poly1305 key into `in`.
+            void crypt(uint8_t *out, const uint8_t *in, size_t size) {
+                size_t n = std::min(size, size_t(32));
+                for (size_t i = 0; i < n; ++i)
+                    out[i] = in[i] ^ block0[32 + i];
+                uint8_t block[64];
+                for (uint64_t counter = 1; size > n; ++counter) {
+                    in += n;
+                    out += n;
+                    size -= n;
+                    for (int i = 0; i < 8; ++i)
+                        input[8 + i] = uint8_t(counter >> (8 * i));
+                    crypto_core_salsa20(block, input, subkey, sigma);
+                    n = std::min(size, size_t(64));
+                    for (size_t i = 0; i < n; ++i)
+                        out[i] = in[i] ^ block[i];
+                }
+                crypto_wipe(block, sizeof(block));
+            }
+        };
+    }
+
 
     void XSalsa20_Poly1305::lock(uint8_t *out,
                                  uint8_t mac[16],
@@ -62,27 +103,12 @@ namespace monocypher::ext {
                                  const uint8_t *plaintext, size_t size)
     {
         assert(ad_size == 0); // XSalsa20_Poly1305 does not support additional authenticated data
-        //TODO: Find a way to do this without having to allocate temporary buffers.
-        auto inBuffer = std::make_unique<uint8_t[]>(32 + size);
-        memset(&inBuffer[ 0], 0, 32);
-        memcpy(&inBuffer[32], plaintext, size);
-
-        auto outBuffer = std::make_unique<uint8_t[]>(32 + size);
-
-        crypto_secretbox_xsalsa20poly1305_tweet(outBuffer.get(),
-                                                inBuffer.get(),
-                                                size + 32,
-                                                nonce, key);
-
-        memcpy(mac, &outBuffer[16], 16);
-        memcpy(out, &outBuffer[32], size);
-
-//      Self-test:
-//        assert(0 == unlock(&inBuffer[0], key, nonce, mac, out, size)
-//               && 0 == memcmp(plaintext, &inBuffer[0], size));
-        crypto_wipe(&inBuffer[32], size);
+        xsalsa20_stream stream(key, nonce);
+        stream.crypt(out, plaintext, size);
+        c::crypto_poly1305(mac, out, size, stream.poly1305_key());
     }
 
+
     int XSalsa20_Poly1305::unlock(uint8_t *out,
                                   const uint8_t mac[16],
                                   const uint8_t key[32],
@@ -91,20 +117,20 @@ namespace monocypher::ext {
                                   const uint8_t *ciphertext, size_t size)
     {
         assert(ad_size == 0); // XSalsa20_Poly1305 does not support additional authenticated data
-        //TODO: Find a way to do this without having to allocate temporary buffers.
-        auto inBuffer = std::make_unique<uint8_t[]>(32 + size);
-        memset(&inBuffer[0], 0, 16);
-        memcpy(&inBuffer[16], mac, 16);
-        memcpy(&inBuffer[32], ciphertext, size);
-
-        auto outBuffer = std::make_unique<uint8_t[]>(32 + size);
-
-        if (0 != crypto_secretbox_xsalsa20poly1305_tweet_open(outBuffer.get(),
-                                                              inBuffer.get(), size + 32,
-                                                              nonce, key))
+        xsalsa20_stream stream(key, nonce);
+        uint8_t real_mac[16];
+        c::crypto_poly1305(real_mac, ciphertext, size, stream.poly1305_key());
+        int result = c::crypto_verify16(mac, real_mac);
+        crypto_wipe(real_mac, sizeof(real_mac));
+        if (result != 0)
             return -1;
-        memcpy(out, &outBuffer[32], size);
-        crypto_wipe(&outBuffer[32], size);
+        stream.crypt(out, ciphertext, size);
         return 0;
     }
+
+
+    void XSalsa20_Poly1305::hsalsa20(uint8_t out[32], const uint8_t key[32], const uint8_t in[16]) {
+        crypto_core_hsalsa20(out, in, key, sigma);
+    }
+
 }
@@ -32,6 +32,12 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Monocypher.hh"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // Bring in the monocypher implementation, still wrapped in a C++namespace:
 #include "../vendor/monocypher/src/monocypher.c"
@@ -107,4 +113,50 @@ namespace monocypher {
         }
         return true;
     }
+
+
+    void internal::parallel_for(size_t jobs, unsigned threads, size_t max_threads,
+                                std::function<void(size_t)> const& fn)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t nthreads = std::min({size_t(threads), max_threads, jobs});
+        if (nthreads <= 1) {
+            for (size_t job = 0; job < jobs; ++job)
+                fn(job);
+            return;
+        }
+
+        std::atomic<size_t> next_job {0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto work = [&] {
+            try {
+                for (size_t job; (job = next_job.fetch_add(1, std::memory_order_relaxed)) < jobs; )
+                    fn(job);
+            } catch (...) {
+                next_job = jobs;                    // stops the other threads
+                std::unique_lock<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        try {
+            workers.reserve(nthreads - 1);
+            for (size_t t = 1; t < nthreads; ++t)
+                workers.emplace_back(work);
+        } catch (...) {
+            // Couldn't start a thread; destroying a running one would call `std::terminate`.
+            next_job = jobs;
+            for (auto &worker : workers)
+                worker.join();
+            throw;
+        }
+        work();
+        for (auto &worker : workers)
+            worker.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
 }
@@ -0,0 +1,377 @@
+//
+//  edwards25519.hh
+//
+//  Monocypher-Cpp: Unofficial idiomatic C++17 wrapper for Monocypher
+//  <https://monocypher.org>
+//
+//  Copyright (c) 2026 Jens Alfke. All rights reserved.
+//
+// --- Standard 2-clause BSD licence follows ---
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+// Edwards25519 field and group arithmetic, shared by the library's own extensions to
+// Monocypher (which keeps its field and point code private.) This is a small, portable
+// implementation. The field operations, point addition and doubling are constant-time; the
+// comparisons, point decoding and scalar-multiplication helpers are *variable-time*, so only
+// use those on public values.
+
+namespace monocypher::edwards25519 {
+
+
+    //======== FIELD ARITHMETIC MODULO 2^255 - 19
+
+
+    // An element of GF(2^255 - 19), in ten signed limbs of alternately 26 and 25 bits
+    // ("radix 2^25.5"). Products of limbs fit comfortably in an int64_t, so this needs no
+    // 128-bit integer support.
+    struct fe {
+        int64_t v[10];
+    };
+
+    static constexpr int kLimbBits[10] = {26, 25, 26, 25, 26, 25, 26, 25, 26, 25};
+    static constexpr int kLimbPos[10]  = { 0, 26, 51, 77,102,128,153,179,204,230};
+
+
+    static inline fe fe_int(int64_t i) {
+        fe r = {};
+        r.v[0] = i;
+        return r;
+    }
+
+    // Rounding carry: brings every limb into (roughly) [-2^(bits-1), 2^(bits-1)].
+    static inline void fe_carry(fe &h) {
+        for (int i = 0; i < 10; ++i) {
+            int64_t c = (h.v[i] + (int64_t(1) << (kLimbBits[i] - 1))) >> kLimbBits[i];
+            h.v[i] -= c * (int64_t(1) << kLimbBits[i]);
+            if (i < 9)
+                h.v[i + 1] += c;
+            else
+                h.v[0] += 19 * c;
+        }
+        int64_t c = (h.v[0] + (int64_t(1) << 25)) >> 26;
+        h.v[0] -= c * (int64_t(1) << 26);
+        h.v[1] += c;
+    }
+
+    static inline fe fe_add(const fe &f, const fe &g) {
+        fe h;
+        for (int i = 0; i < 10; ++i) h.v[i] = f.v[i] + g.v[i];
+        return h;
+    }
+
+    static inline fe fe_sub(const fe &f, const fe &g) {
+        fe h;
+        for (int i = 0; i < 10; ++i) h.v[i] = f.v[i] - g.v[i];
+        return h;
+    }
+
+    static inline fe fe_neg(const fe &f) {
+        fe h;
+        for (int i = 0; i < 10; ++i) h.v[i] = -f.v[i];
+        return h;
+    }
+
+    // One term f[i] * g[j] of a product, for I = 10i + j. Two odd limbs each have a "missing"
+    // half bit; a term wrapping past 2^255 picks up a factor of 19, since 2^255 = 19 (mod p).
+    // (Written as a fold over an index_sequence so that every compiler fully unrolls it.)
+    template <size_t I>
+    static inline int64_t fe_mul_term(const fe &f, const fe &g) {
+        constexpr size_t i = I / 10, j = I % 10;
+        constexpr int64_t k = ((i & j & 1) ? 2 : 1) * ((i + j >= 10) ? 19 : 1);
+        return k * f.v[i] * g.v[j];
+    }
+
+    template <size_t... I>
+    static inline void fe_mul_terms(int64_t t[10], const fe &f, const fe &g, std::index_sequence<I...>) {
+        ((t[(I / 10 + I % 10) % 10] += fe_mul_term<I>(f, g)), ...);
+    }
+
+    // Squaring needs only the terms with i <= j; the others are duplicates.
+    template <size_t... I>
+    static inline void fe_sq_terms(int64_t t[10], const fe &f, std::index_sequence<I...>) {
+        ((t[(I / 10 + I % 10) % 10] += (I / 10 < I % 10) ? 2 * fe_mul_term<I>(f, f)
+                                     : (I / 10 == I % 10) ? fe_mul_term<I>(f, f) : 0), ...);
+    }
+
+    // Inputs must have limbs below 2^27 in magnitude, i.e. no more than a couple of additions
+    // away from a carried value.
+    static inline fe fe_mul(const fe &f, const fe &g) {
+        fe h = {};
+        fe_mul_terms(h.v, f, g, std::make_index_sequence<100>());
+        fe_carry(h);
+        return h;
+    }
+
+    static inline fe fe_sq(const fe &f) {
+        fe h = {};
+        fe_sq_terms(h.v, f, std::make_index_sequence<100>());
+        fe_carry(h);
+        return h;
+    }
+
+    static inline fe fe_sq_n(fe f, int n) {
+        while (n-- > 0) f = fe_sq(f);
+        return f;
+    }
+
+    // Decodes 255 bits, ignoring the top bit. Values >= p are accepted; they're simply
+    // non-canonical representations of (value - p).
+    static inline fe fe_frombytes(const uint8_t s[32]) {
+        uint8_t buf[40] = {};
+        ::memcpy(buf, s, 32);
+        buf[31] &= 0x7F;
+        fe h;
+        for (int i = 0; i < 10; ++i) {
+            uint64_t w = 0;
+            for (int b = 7; b >= 0; --b)
+                w = (w << 8) | buf[kLimbPos[i] / 8 + b];
+            h.v[i] = int64_t((w >> (kLimbPos[i] % 8)) & ((uint64_t(1) << kLimbBits[i]) - 1));
+        }
+        return h;
+    }
+
+    // Encodes canonically, i.e. fully reduced modulo p.
+    static inline void fe_tobytes(uint8_t s[32], const fe &f) {
+        int64_t t[10];
+        std::copy(std::begin(f.v), std::end(f.v), t);
+        // Flooring carries leave every limb non-negative and in range:
+        for (int pass = 0; pass < 3; ++pass) {
+            for (int i = 0; i < 10; ++i) {
+                int64_t c = t[i] >> kLimbBits[i];
+                t[i] -= c * (int64_t(1) << kLimbBits[i]);
+                if (i < 9)
+                    t[i + 1] += c;
+                else
+                    t[0] += 19 * c;
+            }
+        }
+        // Now 0 <= t < 2^255. Subtract p if t >= p, i.e. if t + 19 >= 2^255:
+        int64_t u[10];
+        std::copy(std::begin(t), std::end(t), u);
+        u[0] += 19;
+        for (int i = 0; i < 9; ++i) {
+            u[i + 1] += u[i] >> kLimbBits[i];
+            u[i] &= (int64_t(1) << kLimbBits[i]) - 1;
+        }
+        // (Selected with a mask rather than a branch, since the value may be secret.)
+        int64_t mask = -(u[9] >> 25);
+        u[9] &= (int64_t(1) << 25) - 1;
+        for (int i = 0; i < 10; ++i)
+            t[i] ^= (t[i] ^ u[i]) & mask;
+        uint8_t buf[40] = {};
+        for (int i = 0; i < 10; ++i) {
+            uint64_t w = uint64_t(t[i]) << (kLimbPos[i] % 8);
+            for (int b = 0; b < 8; ++b)
+                buf[kLimbPos[i] / 8 + b] |= uint8_t(w >> (8 * b));
+        }
+        ::memcpy(s, buf, 32);
+    }
+
+    static inline bool fe_iszero(const fe &f) {
+        uint8_t s[32];
+        fe_tobytes(s, f);
+        return std::all_of(std::begin(s), std::end(s), [](uint8_t b) {return b == 0;});
+    }
+
+    static inline bool fe_equal(const fe &f, const fe &g)  {return fe_iszero(fe_sub(f, g));}
+
+    static inline bool fe_isnegative(const fe &f) {
+        uint8_t s[32];
+        fe_tobytes(s, f);
+        return s[0] & 1;
+    }
+
+    // Returns f^((p-5)/8) = f^(2^252 - 3), using the usual addition chain.
+    static inline fe fe_pow22523(const fe &z) {
+        fe t0 = fe_sq(z);                                   // 2
+        fe t1 = fe_mul(z, fe_sq_n(t0, 2));                  // 9
+        t0 = fe_mul(t0, t1);                                // 11
+        t0 = fe_mul(t1, fe_sq(t0));                         // 2^5 - 1
+        t0 = fe_mul(fe_sq_n(t0, 5), t0);                    // 2^10 - 1
+        t1 = fe_mul(fe_sq_n(t0, 10), t0);                   // 2^20 - 1
+        t1 = fe_mul(fe_sq_n(t1, 20), t1);                   // 2^40 - 1
+        t0 = fe_mul(fe_sq_n(t1, 10), t0);                   // 2^50 - 1
+        t1 = fe_mul(fe_sq_n(t0, 50), t0);                   // 2^100 - 1
+        t1 = fe_mul(fe_sq_n(t1, 100), t1);                  // 2^200 - 1
+        t0 = fe_mul(fe_sq_n(t1, 50), t0);                   // 2^250 - 1
+        return fe_mul(fe_sq_n(t0, 2), z);                   // 2^252 - 3
+    }
+
+    // Returns 1/f = f^(p-2) = f^(2^255 - 21), or 0 if f is 0.
+    static inline fe fe_invert(const fe &f) {
+        return fe_mul(fe_sq_n(fe_pow22523(f), 3), fe_mul(fe_sq(f), f));
+    }
+
+
+    //======== GROUP ARITHMETIC
+
+
+    // A point in extended twisted-Edwards coordinates: x = X/Z, y = Y/Z, x*y = T/Z.
+    struct ge {
+        fe X, Y, Z, T;
+    };
+
+    // A point prepared for addition: (Y+X, Y-X, 2Z, 2dT).
+    struct ge_cached {
+        fe YpX, YmX, Z2, T2d;
+    };
+
+
+    static constexpr uint8_t kD[32] = {
+        0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+        0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52};
+    static constexpr uint8_t kSqrtM1[32] = {
+        0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+        0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b};
+    static constexpr uint8_t kBase[32] = {
+        0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+        0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66};
+    // The group order L = 2^252 + 27742317777372353535851937790883648493.
+    static constexpr uint8_t kL[32] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10};
+
+
+    static inline const fe& curve_d()  {static const fe d = fe_frombytes(kD); return d;}
+    static inline const fe& curve_2d() {static const fe d2 = fe_mul(curve_d(), fe_int(2)); return d2;}
+    static inline const fe& sqrt_m1()  {static const fe s = fe_frombytes(kSqrtM1); return s;}
+
+
+    static inline ge ge_identity() {
+        return ge{fe_int(0), fe_int(1), fe_int(1), fe_int(0)};
+    }
+
+    static inline ge ge_neg(const ge &p) {
+        return ge{fe_neg(p.X), p.Y, p.Z, fe_neg(p.T)};
+    }
+
+    static inline ge_cached ge_to_cached(const ge &p) {
+        return ge_cached{fe_add(p.Y, p.X), fe_sub(p.Y, p.X), fe_add(p.Z, p.Z),
+                         fe_mul(p.T, curve_2d())};
+    }
+
+    // Unified addition ("add-2008-hwcd-3"); also works for doubling and the identity.
+    static inline ge ge_add(const ge &p, const ge_cached &q) {
+        fe a = fe_mul(fe_sub(p.Y, p.X), q.YmX);
+        fe b = fe_mul(fe_add(p.Y, p.X), q.YpX);
+        fe c = fe_mul(p.T, q.T2d);
+        fe d = fe_mul(p.Z, q.Z2);
+        fe e = fe_sub(b, a), f = fe_sub(d, c), g = fe_add(d, c), h = fe_add(b, a);
+        return ge{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+    }
+
+    static inline ge ge_sub(const ge &p, const ge_cached &q) {
+        fe a = fe_mul(fe_sub(p.Y, p.X), q.YpX);
+        fe b = fe_mul(fe_add(p.Y, p.X), q.YmX);
+        fe c = fe_mul(p.T, q.T2d);
+        fe d = fe_mul(p.Z, q.Z2);
+        fe e = fe_sub(b, a), f = fe_add(d, c), g = fe_sub(d, c), h = fe_add(b, a);
+        return ge{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+    }
+
+    // Doubling ("dbl-2008-hwcd", a = -1.)
+    static inline ge ge_double(const ge &p) {
+        fe a = fe_sq(p.X);
+        fe b = fe_sq(p.Y);
+        fe zz = fe_sq(p.Z);
+        fe c = fe_add(zz, zz);
+        fe e = fe_sub(fe_sub(fe_sq(fe_add(p.X, p.Y)), a), b);
+        fe g = fe_sub(b, a);
+        fe f = fe_sub(g, c);
+        fe h = fe_neg(fe_add(a, b));
+        fe_carry(e);
+        fe_carry(f);
+        return ge{fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+    }
+
+    static inline ge ge_mul_cofactor(ge p) {
+        return ge_double(ge_double(ge_double(p)));
+    }
+
+    static inline bool ge_is_identity(const ge &p) {
+        return fe_iszero(p.X) && fe_equal(p.Y, p.Z);
+    }
+
+    static inline bool ge_equal(const ge &p, const ge &q) {
+        return fe_equal(fe_mul(p.X, q.Z), fe_mul(q.X, p.Z))
+            && fe_equal(fe_mul(p.Y, q.Z), fe_mul(q.Y, p.Z));
+    }
+
+    static inline bool ge_has_small_order(const ge &p) {
+        return ge_is_identity(ge_mul_cofactor(p));
+    }
+
+    // True if the 255-bit y coordinate of an encoded point is less than p.
+    static inline bool y_is_canonical(const uint8_t s[32]) {
+        if ((s[31] & 0x7F) != 0x7F || s[0] < 0xED)
+            return true;
+        return !std::all_of(&s[1], &s[31], [](uint8_t b) {return b == 0xFF;});
+    }
+
+    // Decodes a point per RFC 8032 section 5.1.3. If `strict` is false, the y coordinate may
+    // be >= p, and x = 0 may come with the sign bit set ("negative zero"), as ZIP-215 allows.
+    static inline bool ge_frombytes(ge &p, const uint8_t s[32], bool strict) {
+        if (strict && !y_is_canonical(s))
+            return false;
+        bool sign = s[31] >> 7;
+        fe y = fe_frombytes(s);
+        fe yy = fe_sq(y);
+        fe u = fe_sub(yy, fe_int(1));                        // y^2 - 1
+        fe v = fe_add(fe_mul(yy, curve_d()), fe_int(1));     // d y^2 + 1
+        fe v3 = fe_mul(fe_sq(v), v);
+        fe x = fe_mul(fe_mul(u, v3), fe_pow22523(fe_mul(fe_mul(v3, v3), fe_mul(u, v)))); // u v^3 (u v^7)^((p-5)/8)
+        fe vxx = fe_mul(v, fe_sq(x));
+        if (!fe_equal(vxx, u)) {
+            if (!fe_equal(vxx, fe_neg(u)))
+                return false;                                // not on the curve
+            x = fe_mul(x, sqrt_m1());
+        }
+        if (fe_iszero(x)) {
+            if (sign && strict)
+                return false;
+        } else if (fe_isnegative(x) != sign) {
+            x = fe_neg(x);
+        }
+        p = ge{x, y, fe_int(1), fe_mul(x, y)};
+        return true;
+    }
+
+    // True if a little-endian 256-bit scalar is less than L.
+    static inline bool scalar_is_canonical(const uint8_t s[32]) {
+        for (int i = 31; i >= 0; --i) {
+            if (s[i] != kL[i])
+                return s[i] < kL[i];
+        }
+        return false;
+    }
+
+}
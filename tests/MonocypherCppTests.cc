@@ -11,8 +11,10 @@
 #include "monocypher/ext/sha256.hh"
 #include "monocypher/ext/sha512.hh"
 #include "monocypher/ext/xsalsa20.hh"
+#include <chrono>
 #include <iostream>
 #include <tuple>    // for `tie`
+#include <vector>
 
 #include "catch.hpp"
 
@@ -200,6 +202,22 @@ TEST_CASE("key exchange", "[Crypto") {
 }
 
 
+TEST_CASE("X25519 fixed-base public key", "[Crypto") {
+    // The comb-based `x25519_public_key` must match the Montgomery ladder exactly, whatever
+    // the bits X25519 clamping ignores:
+    for (int i = 0; i < 200; ++i) {
+        secret_byte_array<32> sk;
+        sk.randomize();
+        if (i == 0)  sk.fill(0);
+        if (i == 1)  sk.fill(0xFF);
+        byte_array<32> expected, actual;
+        c::crypto_x25519_public_key(expected.data(), sk.data());
+        x25519_public_key(actual.data(), sk.data());
+        CHECK(actual == expected);
+    }
+}
+
+
 TEST_CASE("key_exchange_raw", "[Crypto") {
     key_exchange<X25519_Raw> kx1, kx2;
 
@@ -260,6 +278,28 @@ static void test_encryption() {
         cout << "unlocked: '" << plaintextStr << "'\n";
         CHECK(plaintextStr == message);
     }
+    {
+        // box_in_place/unbox_in_place:
+        uint8_t packet[16 + 14];
+        ::memcpy(&packet[16], message.data(), message.size());
+        output_bytes box = key.box_in_place(nonce, {packet, sizeof(packet)});
+        CHECK(box.data == packet);
+        CHECK(box.size == sizeof(packet));
+        char boxbuf[100];
+        output_bytes expected = key.box(nonce, input_bytes{message.c_str(), message.size()},
+                                        output_bytes{boxbuf, sizeof(boxbuf)});
+        CHECK(hexString(box.data, box.size) == hexString(expected.data, expected.size));
+
+        output_bytes unbox = key.unbox_in_place(nonce, {packet, sizeof(packet)});
+        CHECK(unbox.data == &packet[16]);
+        CHECK(string((char*)unbox.data, unbox.size) == message);
+
+        // Tampering is detected:
+        key.box_in_place(nonce, {packet, sizeof(packet)});
+        packet[20] ^= 1;
+        CHECK(!key.unbox_in_place(nonce, {packet, sizeof(packet)}));
+        CHECK(!key.unbox_in_place(nonce, {packet, 15}));
+    }
 }
 
 TEST_CASE("XChaCha20-Poly1305 Encryption", "[Crypto")  {test_encryption<XChaCha20_Poly1305>();}
@@ -344,6 +384,39 @@ TEST_CASE("EdDSA Signatures", "[Crypto")   {test_signatures<EdDSA>();}
 TEST_CASE("Ed25519 Signatures", "[Crypto") {test_signatures<Ed25519>();}
 
 
+template <class Algorithm>
+static void test_fixed_base_signing(decltype(c::crypto_eddsa_key_pair) c_key_pair,
+                                    decltype(c::crypto_eddsa_sign) c_sign) {
+    // `generate_fn` and `sign_fn` may use the library's own fixed-base table; they must agree
+    // exactly with Monocypher's functions.
+    string message = "Our hovercraft is full of eels";
+    for (int i = 0; i < 50; ++i) {
+        byte_array<32> seed1, seed2;
+        seed1.randomize();
+        seed2 = seed1;
+        byte_array<64> sk1, sk2;
+        byte_array<32> pk1, pk2;
+        Algorithm::generate_fn(sk1.data(), pk1.data(), seed1.data());
+        c_key_pair(sk2.data(), pk2.data(), seed2.data());
+        CHECK(sk1 == sk2);
+        CHECK(pk1 == pk2);
+
+        byte_array<64> sig1, sig2;
+        Algorithm::sign_fn(sig1.data(), sk1.data(), u8(message.data()), message.size());
+        c_sign(sig2.data(), sk1.data(), u8(message.data()), message.size());
+        CHECK(sig1 == sig2);
+        message += char('a' + i % 26);
+    }
+}
+
+TEST_CASE("EdDSA fixed-base signing", "[Crypto") {
+    test_fixed_base_signing<EdDSA>(c::crypto_eddsa_key_pair, c::crypto_eddsa_sign);
+}
+TEST_CASE("Ed25519 fixed-base signing", "[Crypto") {
+    test_fixed_base_signing<Ed25519>(c::crypto_ed25519_key_pair, c::crypto_ed25519_sign);
+}
+
+
 template <class Algorithm>
 static void test_signatures_to_kx() {
     auto keyPair1 = key_pair<Algorithm>::generate();
@@ -372,3 +445,60 @@ static void test_signatures_to_kx() {
 
 TEST_CASE("EdDSA Signature-to-KeyExchange", "[Crypto")   {test_signatures_to_kx<EdDSA>();}
 TEST_CASE("Ed25519 Signature-to-KeyExchange", "[Crypto") {test_signatures_to_kx<Ed25519>();}
+
+
+TEST_CASE("Batch Signature-to-KeyExchange", "[Crypto") {
+    using pubkey = monocypher::public_key<EdDSA>;
+    using kxkey = key_exchange<X25519_Raw>::public_key;
+    vector<pubkey> keys(5000);
+    for (auto &key : keys)
+        key.randomize();    // (any 32 bytes will do; only y is used)
+    // Edge cases: y = 1 (the identity), y = 0, y = -1, y = p (non-canonical 0), sign bit set:
+    keys[0].fill(0);  keys[0][0] = 1;
+    keys[1].fill(0);
+    keys[2].fill(0xFF); keys[2][0] = 0xEC; keys[2][31] = 0x7F;
+    keys[3].fill(0xFF); keys[3][0] = 0xED; keys[3][31] = 0x7F;
+    keys[4].fill(0);  keys[4][0] = 1; keys[4][31] = 0x80;
+
+    vector<kxkey> expected(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        expected[i] = keys[i].for_key_exchange<X25519_Raw>();
+    for (unsigned threads : {1, 3, 0}) {
+        vector<kxkey> out(keys.size());
+        pubkey::for_key_exchange_many<X25519_Raw>(keys.data(), keys.size(), out.data(), threads);
+        for (size_t i = 0; i < keys.size(); ++i)
+            CHECK(out[i] == expected[i]);
+    }
+    kxkey one;
+    pubkey::for_key_exchange_many<X25519_Raw>(&keys[10], 1, &one);
+    CHECK(one == expected[10]);
+}
+
+
+TEST_CASE("Batch Signature-to-KeyExchange benchmark", "[.][Crypto]") {
+    using pubkey = monocypher::public_key<EdDSA>;
+    using kxkey = key_exchange<X25519_Raw>::public_key;
+    vector<pubkey> keys(5000);
+    for (auto &key : keys)
+        key.randomize();
+
+    auto time_it = [&](auto fn) {
+        double best = 1e9;
+        for (int trial = 0; trial < 3; ++trial) {
+            auto start = chrono::steady_clock::now();
+            fn();
+            best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+        }
+        return best / keys.size() * 1e9;
+    };
+    vector<kxkey> out(keys.size());
+    double single = time_it([&] {
+        for (size_t i = 0; i < keys.size(); ++i)
+            out[i] = keys[i].for_key_exchange<X25519_Raw>();
+    });
+    double batch = time_it([&] {
+        pubkey::for_key_exchange_many<X25519_Raw>(keys.data(), keys.size(), out.data(), 1);
+    });
+    cout << "for_key_exchange: " << single << " ns/key; for_key_exchange_many (1 thread): "
+         << batch << " ns/key (" << single / batch << "x)\n";
+}
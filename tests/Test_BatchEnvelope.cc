@@ -0,0 +1,118 @@
+//
+//  Test_BatchEnvelope.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/batch_envelope.hh"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+TEST_CASE("Batch envelope", "[BatchEnvelope]") {
+    batch_envelope::key key;
+    vector<vector<uint8_t>> envelopes;
+    batch_envelope::writer::options opts;
+    opts.max_size = 1024;
+    opts.max_delay = chrono::hours(1);
+    batch_envelope::writer writer(key, opts, [&](input_bytes env) {
+        envelopes.emplace_back(env.data, env.data + env.size);
+    });
+
+    // Write 100 events of 20-80 bytes:
+    vector<string> events;
+    size_t total_size = 0;
+    for (int i = 0; i < 100; ++i) {
+        string event = "event #" + to_string(i) + " " + string(13 + (i * 37) % 60, 'a' + i % 26);
+        events.push_back(event);
+        total_size += event.size();
+        writer.add(event);
+        CHECK(writer.pending_size() <= opts.max_size);
+    }
+    CHECK(writer.pending_records() > 0);
+    writer.flush();
+    CHECK(writer.pending_records() == 0);
+
+    size_t envelope_size = 0;
+    for (auto &env : envelopes) {
+        CHECK(env.size() <= opts.max_size);
+        envelope_size += env.size();
+    }
+    cout << events.size() << " events, " << total_size << " bytes, sent in " << envelopes.size()
+         << " envelopes totaling " << envelope_size << " bytes\n";
+    CHECK(envelope_size - total_size < 100 * (24 + 16));
+
+    // Open the envelopes and read back the events:
+    size_t n = 0;
+    for (auto &env : envelopes) {
+        auto records = batch_envelope::open(key, {env.data(), env.size()});
+        REQUIRE(records);
+        for (input_bytes record : *records) {
+            REQUIRE(n < events.size());
+            CHECK(string((const char*)record.data, record.size) == events[n]);
+            // Zero-copy: the record points into the envelope.
+            CHECK(record.data >= env.data());
+            CHECK(record.data + record.size <= env.data() + env.size());
+            ++n;
+        }
+    }
+    CHECK(n == events.size());
+
+    // Tampering:
+    auto &env = envelopes[0];
+    env[env.size() - 1] ^= 1;
+    CHECK(!batch_envelope::open(key, {env.data(), env.size()}));
+    CHECK(!batch_envelope::open(key, {env.data(), 43}));
+
+    CHECK_THROWS_AS(writer.add(string(1000, 'x')), invalid_argument);
+}
+
+
+TEST_CASE("Batch envelope flush timing", "[BatchEnvelope]") {
+    batch_envelope::key key;
+    vector<vector<uint8_t>> envelopes;
+    batch_envelope::writer::options opts;
+    opts.max_delay = chrono::milliseconds(20);
+    opts.max_records = 3;
+    batch_envelope::writer writer(key, opts, [&](input_bytes env) {
+        envelopes.emplace_back(env.data, env.data + env.size);
+    });
+
+    writer.add("one"sv);
+    writer.add("two"sv);
+    CHECK(!writer.flush_if_due());
+    CHECK(envelopes.empty());
+    CHECK(writer.flush_if_due(batch_envelope::clock::now() + chrono::milliseconds(25)));
+    REQUIRE(envelopes.size() == 1);
+
+    // Flush on record count:
+    for (auto str : {"three"sv, "four"sv, "five"sv, "six"sv})
+        writer.add(str);
+    CHECK(envelopes.size() == 2);
+    CHECK(writer.pending_records() == 1);
+
+    // An `add` after the delay flushes:
+    this_thread::sleep_for(chrono::milliseconds(25));
+    writer.add("seven"sv);
+    CHECK(envelopes.size() == 3);
+
+    cout << "Envelope with 2 records: " << hexString(envelopes[0].data(), envelopes[0].size()) << endl;
+    CHECK(envelopes[0].size() == batch_envelope::overhead + 3 + 3 + 2);
+
+    vector<string> got;
+    for (auto &env : envelopes) {
+        auto records = batch_envelope::open(key, {env.data(), env.size()});
+        REQUIRE(records);
+        for (input_bytes record : *records)
+            got.emplace_back((const char*)record.data, record.size);
+    }
+    CHECK(got == vector<string>{"one", "two", "three", "four", "five", "six", "seven"});
+}
@@ -0,0 +1,169 @@
+//
+//  Test_Blake2b.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+
+
+// Lengths around the block size and its multiples, where lanes retire at different times.
+static vector<vector<uint8_t>> test_messages() {
+    vector<size_t> sizes = {0, 1, 3, 127, 128, 129, 255, 256, 257, 1000, 1024, 4000, 64, 65};
+    for (int i = 0; i < 40; ++i)
+        sizes.push_back(size_t(rand()) % 3000);
+    vector<vector<uint8_t>> messages;
+    for (size_t size : sizes) {
+        vector<uint8_t> msg(size);
+        for (size_t i = 0; i < size; ++i)
+            msg[i] = uint8_t(i * 7 + size);
+        messages.push_back(move(msg));
+    }
+    return messages;
+}
+
+
+template <size_t Size>
+static void check_create_many(size_t count) {
+    using blake2b = monocypher::hash<Blake2b<Size>>;
+    auto messages = test_messages();
+    messages.resize(min(count, messages.size()));
+    vector<input_bytes> inputs;
+    for (auto &m : messages)
+        inputs.push_back({m.data(), m.size()});
+
+    vector<blake2b> hashes(inputs.size());
+    blake2b::create_many(inputs.data(), inputs.size(), hashes.data());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        INFO("message #" << i << ", size " << inputs[i].size);
+        CHECK(hashes[i] == blake2b::create(inputs[i]));
+    }
+
+    for (size_t keySize : {1, 16, 32, 64}) {
+        vector<blake2b> macs(inputs.size());
+        auto check_key = [&](const auto &key) {
+            blake2b::createMAC_many(inputs.data(), inputs.size(), key, macs.data());
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                INFO("key size " << key.size() << ", message #" << i << ", size " << inputs[i].size);
+                CHECK(macs[i] == blake2b::createMAC(inputs[i], key));
+            }
+        };
+        switch (keySize) {
+            case 1:  check_key(byte_array<1>({0x55})); break;
+            case 16: {byte_array<16> k; k.randomize(); check_key(k); break;}
+            case 32: {byte_array<32> k; k.randomize(); check_key(k); break;}
+            case 64: {byte_array<64> k; k.randomize(); check_key(k); break;}
+        }
+    }
+}
+
+
+TEST_CASE("Blake2b create_many", "[Blake2b]") {
+    for (unsigned lanes : {8, 4, 1}) {
+        unsigned actual = blake2b_many_set_lanes(lanes);
+        INFO("lanes = " << actual);
+        for (size_t count : {0, 1, 2, 3, 5, 8, 9, 100}) {
+            check_create_many<32>(count);
+            check_create_many<64>(count);
+        }
+        check_create_many<48>(100);
+    }
+    blake2b_many_set_lanes(8);
+}
+
+
+TEST_CASE("Blake2b create_many benchmark", "[.][Blake2b]") {
+    constexpr size_t kCount = 4096;
+    vector<vector<uint8_t>> messages;
+    vector<input_bytes> inputs;
+    size_t total = 0;
+    for (size_t i = 0; i < kCount; ++i) {
+        messages.emplace_back(1024 + size_t(rand()) % 3072, uint8_t(i));
+        total += messages.back().size();
+    }
+    for (auto &m : messages)
+        inputs.push_back({m.data(), m.size()});
+    vector<blake2b32> hashes(kCount), expected(kCount);
+
+    auto time = [&](const char *what, auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "    " << what << ": " << (total / elapsed.count() / 1e6) << " MB/s\n";
+    };
+    cout << "Blake2b-32 of " << kCount << " messages of 1-4KB:\n";
+    time("create, one at a time", [&] {
+        for (size_t i = 0; i < kCount; ++i)
+            expected[i] = blake2b32::create(inputs[i]);
+    });
+    for (unsigned lanes : {1, 4, 8}) {
+        if (blake2b_many_set_lanes(lanes) != lanes)
+            continue;
+        string what = "create_many, " + to_string(lanes) + " lane(s)";
+        time(what.c_str(), [&] {
+            blake2b32::create_many(inputs.data(), kCount, hashes.data());
+        });
+        CHECK(hashes == expected);
+    }
+    blake2b_many_set_lanes(8);
+}
+
+
+TEST_CASE("Blake2b short messages", "[Blake2b]") {
+    // Every length up to the short-message limit and a bit beyond, against the generic
+    // init/update/final path:
+    uint8_t data[160];
+    for (size_t i = 0; i < sizeof(data); ++i)
+        data[i] = uint8_t(i * 13 + 1);
+    byte_array<32> key;
+    key.randomize();
+    for (size_t size = 0; size <= sizeof(data); ++size) {
+        INFO("size = " << size);
+        blake2b64::builder b;
+        b.update(data, size);
+        CHECK(blake2b64::create(data, size) == b.final());
+        blake2b32::builder b32;
+        b32.update(data, size);
+        CHECK(blake2b32::create(data, size) == b32.final());
+        blake2b64::mac_builder mb(key);
+        mb.update(data, size);
+        CHECK(blake2b64::createMAC(data, size, key) == mb.final());
+    }
+}
+
+
+TEST_CASE("Blake2b short message latency", "[.][Blake2b]") {
+    constexpr int kIterations = 20000, kTrials = 5;
+    uint8_t data[128] = {};
+    byte_array<32> key;
+    key.randomize();
+    auto time = [&](const char *what, size_t size, auto fn) {
+        double best = 1e99;     // best of several trials, to filter out noise
+        for (int trial = 0; trial < kTrials; ++trial) {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < kIterations; ++i) {
+                data[0] = uint8_t(i);
+                fn(size);
+            }
+            chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+            best = min(best, elapsed.count() / kIterations);
+        }
+        cout << "    " << what << "(" << size << " bytes): " << best << " ns\n";
+    };
+    uint8_t out[64];
+    cout << "Blake2b-32 latency:\n";
+    for (size_t size : {16, 32, 64, 128}) {
+        time("crypto_blake2b        ", size, [&](size_t n) {c::crypto_blake2b(out, 32, data, n);});
+        time("blake2b32::create     ", size, [&](size_t n) {::memcpy(out, blake2b32::create(data, n).data(), 32);});
+        time("crypto_blake2b_keyed  ", size, [&](size_t n) {c::crypto_blake2b_keyed(out, 32, key.data(), 32, data, n);});
+        time("blake2b32::createMAC  ", size, [&](size_t n) {::memcpy(out, blake2b32::createMAC(data, n, key).data(), 32);});
+    }
+}
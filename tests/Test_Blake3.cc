@@ -7,6 +7,7 @@
 #include "monocypher/ext/blake3.hh"
 #include <iostream>
 #include <tuple>    // for `tie`
+#include <vector>
 
 #include "catch.hpp"
 
@@ -59,3 +60,31 @@ TEST_CASE("Blake3 HMAC") {
     CHECK(mac2 == mac);
 
 }
+
+
+TEST_CASE("Blake3 checkpoint", "[Checkpoint]") {
+    // Long enough to build up a few levels of the chaining-value stack:
+    vector<uint8_t> data(20000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uint8_t(i * 37 + 11);
+    auto expected = ext::blake3::create(data.data(), data.size());
+    for (size_t split : {0, 1, 64, 1024, 1025, 4096, 9000, 20000}) {
+        ext::blake3::builder b;
+        b.update(data.data(), split);
+        vector<uint8_t> checkpoint = b.checkpoint();
+        auto b2 = ext::blake3::builder::restore({checkpoint.data(), checkpoint.size()});
+        b2.update(&data[split], data.size() - split);
+        CHECK(b2.final() == expected);
+    }
+
+    secret_byte_array<32> mac_key;
+    mac_key.randomize();
+    session::key checkpoint_key;
+    ext::blake3::mac_builder mb(mac_key);
+    mb.update(data.data(), 5000);
+    vector<uint8_t> checkpoint = mb.checkpoint(checkpoint_key);
+    auto mb2 = ext::blake3::mac_builder::restore({checkpoint.data(), checkpoint.size()},
+                                                 checkpoint_key);
+    mb2.update(&data[5000], data.size() - 5000);
+    CHECK(mb2.final() == ext::blake3::createMAC(data.data(), data.size(), mac_key));
+}
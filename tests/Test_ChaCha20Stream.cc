@@ -0,0 +1,134 @@
+//
+//  Test_ChaCha20Stream.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/chacha20_stream.hh"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+
+
+static vector<uint8_t> test_data(size_t size) {
+    vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = uint8_t(i * 37 + 11);
+    return data;
+}
+
+
+TEST_CASE("XChaCha20 stream matches crypto_chacha20_x", "[ChaCha20Stream]") {
+    session::key key;
+    session::nonce nonce;
+    auto plain = test_data(5000);
+    vector<uint8_t> expected(plain.size());
+    c::crypto_chacha20_x(expected.data(), plain.data(), plain.size(), key.data(), nonce.data(), 0);
+
+    for (unsigned lanes : {16, 8, 1}) {
+        unsigned actual = ext::chacha20_stream::set_lanes(lanes);
+        if (actual != lanes)
+            continue;
+        ext::xchacha20_stream stream(key, nonce);
+        // Slices at every alignment, and long enough to take the SIMD path:
+        for (size_t start : {0, 1, 63, 64, 65, 500, 1024, 1500, 4999}) {
+            for (size_t len : {0, 1, 64, 100, 1024, 1025, 2100, 4000}) {
+                len = min(len, plain.size() - start);
+                vector<uint8_t> out(len);
+                stream.apply_at(start, {&plain[start], len}, out.data());
+                CHECK(memcmp(out.data(), &expected[start], len) == 0);
+
+                // In place:
+                vector<uint8_t> buf(&plain[start], &plain[start] + len);
+                stream.apply_at(start, {buf.data(), len}, buf.data());
+                CHECK(buf == out);
+            }
+        }
+    }
+    ext::chacha20_stream::set_lanes(16);
+}
+
+
+TEST_CASE("XChaCha20 stream seek and keystream", "[ChaCha20Stream]") {
+    session::key key;
+    session::nonce nonce;
+    auto plain = test_data(3000);
+
+    // Sequential `apply` calls in odd-size pieces == one call:
+    ext::xchacha20_stream stream(key, nonce);
+    vector<uint8_t> whole(plain.size()), pieces(plain.size());
+    stream.apply_at(0, {plain.data(), plain.size()}, whole.data());
+    for (size_t pos = 0; pos < plain.size(); ) {
+        size_t n = min<size_t>(plain.size() - pos, 1 + pos % 700);
+        CHECK(stream.tell() == pos);
+        stream.apply({&plain[pos], n}, &pieces[pos]);
+        pos += n;
+    }
+    CHECK(pieces == whole);
+
+    // Decrypting is the same operation:
+    stream.seek(100);
+    stream.apply({&whole[100], 1000}, &whole[100]);
+    CHECK(memcmp(&whole[100], &plain[100], 1000) == 0);
+
+    // Keystream at an offset matches Monocypher's counter, and a stream constructed at that offset:
+    vector<uint8_t> ks(1000), expected(1000);
+    stream.keystream_at(64 * 7, ks.data(), ks.size());
+    c::crypto_chacha20_x(expected.data(), nullptr, expected.size(), key.data(), nonce.data(), 7);
+    CHECK(ks == expected);
+    ext::xchacha20_stream stream7(key, nonce, 64 * 7);
+    vector<uint8_t> zeros(1000, 0);
+    stream7.apply({zeros.data(), zeros.size()}, ks.data());
+    CHECK(ks == expected);
+}
+
+
+TEST_CASE("ChaCha20 stream matches crypto_chacha20_djb", "[ChaCha20Stream]") {
+    secret_byte_array<32> key;
+    key.randomize();
+    byte_array<8> nonce;
+    nonce.randomize();
+    // Start just below a 2^32-block boundary, so the counter carries into its high word:
+    uint64_t ctr = 0xFFFFFFFFull - 5;
+    vector<uint8_t> expected(4096), out(4096);
+    c::crypto_chacha20_djb(expected.data(), nullptr, expected.size(), key.data(), nonce.data(), ctr);
+    ext::chacha20_stream(key, nonce).keystream_at(64 * ctr, out.data(), out.size());
+    CHECK(out == expected);
+}
+
+
+TEST_CASE("ChaCha20 stream benchmark", "[.][ChaCha20Stream]") {
+    session::key key;
+    session::nonce nonce;
+    vector<uint8_t> buf(1 << 20);
+    ext::xchacha20_stream stream(key, nonce);
+
+    using clock = chrono::steady_clock;
+    auto time_it = [&](auto fn) {
+        double best = 1e9;
+        for (int trial = 0; trial < 5; ++trial) {
+            auto start = clock::now();
+            fn();
+            best = min(best, chrono::duration<double>(clock::now() - start).count());
+        }
+        return buf.size() / best / 1e9;
+    };
+    double monocypher = time_it([&] {
+        c::crypto_chacha20_x(buf.data(), buf.data(), buf.size(), key.data(), nonce.data(), 0);
+    });
+    cout << "crypto_chacha20_x: " << monocypher << " GB/s\n";
+    for (unsigned lanes : {16, 8}) {
+        if (ext::chacha20_stream::set_lanes(lanes) != lanes)
+            continue;
+        double simd = time_it([&] {stream.apply_at(0, {buf.data(), buf.size()}, buf.data());});
+        cout << "xchacha20_stream, " << lanes << " lanes: " << simd << " GB/s ("
+             << simd / monocypher << "x)\n";
+    }
+    ext::chacha20_stream::set_lanes(16);
+}
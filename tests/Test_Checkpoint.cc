@@ -0,0 +1,116 @@
+//
+//  Test_Checkpoint.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/sha256.hh"
+#include "monocypher/ext/sha512.hh"
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+
+
+static vector<uint8_t> test_data(size_t size) {
+    vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+        data[i] = uint8_t(i * 37 + 11);
+    return data;
+}
+
+
+// Hashes `data` in one go, and again with a checkpoint/restore at every interesting split point.
+template <class H>
+static void test_checkpoints() {
+    auto data = test_data(3000);
+    auto expected = H::create(data.data(), data.size());
+    for (size_t split : {0, 1, 63, 64, 65, 127, 128, 129, 1024, 1025, 2999, 3000}) {
+        typename H::builder b;
+        b.update(data.data(), split);
+        vector<uint8_t> checkpoint = b.checkpoint();
+        auto b2 = H::builder::restore({checkpoint.data(), checkpoint.size()});
+        b2.update(&data[split], data.size() - split);
+        CHECK(b2.final() == expected);
+        // The original builder is unaffected:
+        b.update(&data[split], data.size() - split);
+        CHECK(b.final() == expected);
+    }
+}
+
+
+TEST_CASE("Hash checkpoints", "[Checkpoint]") {
+    test_checkpoints<blake2b32>();
+    test_checkpoints<blake2b64>();
+    test_checkpoints<ext::sha256>();
+    test_checkpoints<sha512>();
+}
+
+
+TEST_CASE("Hash checkpoint errors", "[Checkpoint]") {
+    auto data = test_data(200);
+    blake2b64::builder b;
+    b.update(data.data(), data.size());
+    vector<uint8_t> checkpoint = b.checkpoint();
+    input_bytes cp{checkpoint.data(), checkpoint.size()};
+
+    // Wrong algorithm or hash size:
+    CHECK_THROWS_AS(sha512::builder::restore(cp), invalid_argument);
+    CHECK_THROWS_AS(blake2b32::builder::restore(cp), invalid_argument);
+    // Truncated:
+    for (size_t size = 0; size < checkpoint.size(); size += 7)
+        CHECK_THROWS_AS(blake2b64::builder::restore({checkpoint.data(), size}), invalid_argument);
+    // Any corrupted byte:
+    for (size_t i = 0; i < checkpoint.size(); ++i) {
+        auto bad = checkpoint;
+        bad[i] ^= 0x20;
+        CHECK_THROWS_AS(blake2b64::builder::restore({bad.data(), bad.size()}), invalid_argument);
+    }
+    // A MAC checkpoint can't be restored as a plain builder, and vice versa:
+    session::key key;
+    blake2b64::mac_builder mb(key);
+    vector<uint8_t> mac_checkpoint = mb.checkpoint(key);
+    CHECK_THROWS_AS(blake2b64::builder::restore({mac_checkpoint.data(), mac_checkpoint.size()}),
+                    invalid_argument);
+    CHECK_THROWS_AS(blake2b64::mac_builder::restore(cp, key), invalid_argument);
+}
+
+
+template <class H, size_t KeySize>
+static void test_mac_checkpoints(const byte_array<KeySize> &mac_key) {
+    auto data = test_data(1000);
+    auto expected = H::createMAC(data.data(), data.size(), mac_key);
+    session::key checkpoint_key;
+    for (size_t split : {0, 100, 128, 999}) {
+        typename H::mac_builder b(mac_key);
+        b.update(data.data(), split);
+        vector<uint8_t> checkpoint = b.checkpoint(checkpoint_key);
+        input_bytes cp{checkpoint.data(), checkpoint.size()};
+
+        // The MAC key does not appear in the checkpoint:
+        string cpStr(checkpoint.begin(), checkpoint.end());
+        CHECK(cpStr.find(string((const char*)mac_key.data(), 16)) == string::npos);
+
+        auto b2 = H::mac_builder::restore(cp, checkpoint_key);
+        b2.update(&data[split], data.size() - split);
+        CHECK(b2.final() == expected);
+
+        session::key wrong_key;
+        CHECK_THROWS_AS(H::mac_builder::restore(cp, wrong_key), invalid_argument);
+        checkpoint.back() ^= 1;
+        CHECK_THROWS_AS(H::mac_builder::restore({checkpoint.data(), checkpoint.size()},
+                                                checkpoint_key), invalid_argument);
+    }
+}
+
+
+TEST_CASE("MAC checkpoints", "[Checkpoint]") {
+    secret_byte_array<32> mac_key;
+    mac_key.randomize();
+    test_mac_checkpoints<blake2b64>(mac_key);
+    test_mac_checkpoints<sha512>(mac_key);
+}
@@ -0,0 +1,172 @@
+//
+//  Test_Datagram.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/datagram.hh"
+#include <iostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+TEST_CASE("Datagram seal and open", "[Datagram]") {
+    datagram_sender::key key;
+    datagram_sender sender(key);
+    datagram_receiver receiver(key);
+    CHECK(sender.overhead() == 20);
+
+    // Seal some packets, then open them out of order:
+    vector<vector<uint8_t>> packets;
+    for (int i = 0; i < 5; ++i) {
+        string message = "Message #" + to_string(i);
+        vector<uint8_t> packet(message.size() + sender.overhead());
+        output_bytes sealed = sender.seal(message, {packet.data(), packet.size()});
+        CHECK(sealed.size == packet.size());
+        packets.push_back(packet);
+    }
+    cout << "Packet 3: " << hexString(packets[3].data(), packets[3].size()) << endl;
+    CHECK(sender.next_sequence() == 5);
+
+    for (int i : {2, 0, 4, 1, 3}) {
+        char buf[100];
+        output_bytes message = receiver.open({packets[i].data(), packets[i].size()},
+                                             {buf, sizeof(buf)});
+        REQUIRE(message);
+        CHECK(string(buf, message.size) == "Message #" + to_string(i));
+    }
+    CHECK(receiver.expected_sequence() == 5);
+
+    // Replays are rejected:
+    char buf[100];
+    CHECK(!receiver.open({packets[1].data(), packets[1].size()}, {buf, sizeof(buf)}));
+
+    // Decrypt in place:
+    vector<uint8_t> packet(10 + 20);
+    sender.seal("Message #5"sv, {packet.data(), packet.size()});
+    output_bytes message = receiver.open({packet.data(), packet.size()},
+                                         {packet.data() + 20, packet.size() - 20});
+    REQUIRE(message);
+    CHECK(string((char*)message.data, message.size) == "Message #5");
+
+    // Tampering:
+    sender.seal("Message #6"sv, {packet.data(), packet.size()});
+    packet[0] ^= 1;             // sequence number
+    CHECK(!receiver.open({packet.data(), packet.size()}, {buf, sizeof(buf)}));
+    packet[0] ^= 1;
+    packet.back() ^= 1;         // ciphertext
+    CHECK(!receiver.open({packet.data(), packet.size()}, {buf, sizeof(buf)}));
+    CHECK(!receiver.open({packet.data(), 19}, {buf, sizeof(buf)}));
+    CHECK(receiver.expected_sequence() == 6);
+    packet.back() ^= 1;         // Forgeries didn't affect the window:
+    CHECK(receiver.open({packet.data(), packet.size()}, {buf, sizeof(buf)}));
+}
+
+
+TEST_CASE("Datagram sequence wraparound", "[Datagram]") {
+    datagram_sender::key key;
+    datagram_sender sender(key, 1);
+    datagram_receiver receiver(key, 1);
+
+    // With 1-byte sequence numbers, sequence 300 is sent as 44:
+    uint8_t packet[100], held[100], buf[100];
+    size_t held_size = 0;
+    for (int i = 0; i < 1000; ++i) {
+        output_bytes sealed = sender.seal("hi"sv, {packet, sizeof(packet)});
+        if (i == 290) {
+            // Hold this one back and deliver it late:
+            memcpy(held, packet, sealed.size);
+            held_size = sealed.size;
+            continue;
+        }
+        REQUIRE(receiver.open({packet, sealed.size}, {buf, sizeof(buf)}));
+        if (i == 300) {
+            CHECK(packet[0] == 44);
+            REQUIRE(receiver.open({held, held_size}, {buf, sizeof(buf)}));
+        }
+    }
+    CHECK(receiver.expected_sequence() == 1000);
+    CHECK(receiver.expand_sequence(0xE8) == 1000);
+    CHECK(receiver.expand_sequence(0xE7) == 999);
+    CHECK(receiver.expand_sequence(0x69) == 873);
+    CHECK(receiver.expand_sequence(0x68) == 1128);
+
+    CHECK_THROWS_AS(datagram_sender(key, 0), invalid_argument);
+    CHECK_THROWS_AS(datagram_receiver(key, 9), invalid_argument);
+}
+
+
+#ifndef _WIN32
+
+// Creates a UDP socket bound to a random port on the loopback interface.
+static int make_udp_socket(sockaddr_in &addr) {
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(fd >= 0);
+    addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0);
+    socklen_t len = sizeof(addr);
+    REQUIRE(::getsockname(fd, (sockaddr*)&addr, &len) == 0);
+    return fd;
+}
+
+
+TEST_CASE("Datagram batches over loopback", "[Datagram]") {
+    sockaddr_in addr1, addr2;
+    int fd1 = make_udp_socket(addr1), fd2 = make_udp_socket(addr2);
+    REQUIRE(::connect(fd1, (sockaddr*)&addr2, sizeof(addr2)) == 0);
+    REQUIRE(::connect(fd2, (sockaddr*)&addr1, sizeof(addr1)) == 0);
+
+    datagram_sender::key key;
+    datagram_sender sender(key);
+    datagram_receiver receiver(key);
+
+    datagram_batch out(32, 200);
+    for (int i = 0; out.add(sender, "Telemetry sample #" + to_string(i)); ++i)
+        { }
+    CHECK(out.size() == 32);
+    CHECK(out.send(fd1) == 32);
+    CHECK(out.size() == 0);
+
+    // A forged packet mixed in:
+    uint8_t junk[50] = {};
+    REQUIRE(::send(fd1, junk, sizeof(junk), 0) == sizeof(junk));
+
+    datagram_batch in(16, 200);
+    vector<string> received;
+    size_t rejected = 0;
+    while (received.size() + rejected < 33) {
+        in.receive(fd2, receiver);
+        for (auto &msg : in.messages())
+            received.emplace_back((const char*)msg.data, msg.size);
+        rejected += in.rejected();
+    }
+    CHECK(rejected == 1);
+    REQUIRE(received.size() == 32);
+    for (int i = 0; i < 32; ++i)
+        CHECK(received[i] == "Telemetry sample #" + to_string(i));
+    CHECK(receiver.expected_sequence() == 32);
+
+    CHECK_THROWS_AS(out.add(sender, string(181, 'x')), invalid_argument);
+    datagram_batch tiny(4, 16);                     // can't hold even the 20-byte overhead
+    CHECK_THROWS_AS(tiny.receive(fd2, receiver), invalid_argument);
+
+    ::close(fd1);
+    ::close(fd2);
+}
+
+#endif // _WIN32
@@ -0,0 +1,101 @@
+//
+//  Test_HashBatch.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/sha256.hh"
+#include "monocypher/ext/sha512.hh"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+
+
+// A mix like a source tree's: lots of small files, some medium, a few big ones.
+static vector<vector<uint8_t>> test_files(size_t count) {
+    vector<vector<uint8_t>> files;
+    for (size_t i = 0; i < count; ++i) {
+        size_t size;
+        if (i % 50 == 7)        size = 1'000'000 + i * 1000;
+        else if (i % 5 == 0)    size = 100'000 + i * 37;
+        else                    size = (i * 7919) % 20'000;
+        files.emplace_back(size);
+        for (size_t j = 0; j < size; j += 97)
+            files.back()[j] = uint8_t(i + j);
+    }
+    return files;
+}
+
+static vector<input_bytes> inputs_of(vector<vector<uint8_t>> const& files) {
+    vector<input_bytes> inputs;
+    for (auto &file : files)
+        inputs.emplace_back(file.data(), file.size());
+    return inputs;
+}
+
+
+template <class H>
+static void test_create_batch(vector<input_bytes> const& inputs) {
+    vector<H> expected(inputs.size()), out(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+        expected[i] = H::create(inputs[i]);
+    for (unsigned threads : {1, 3, 0}) {
+        for (auto &h : out) h.fill(0);
+        H::create_batch(inputs.data(), inputs.size(), out.data(), threads);
+        for (size_t i = 0; i < inputs.size(); ++i)
+            CHECK(out[i] == expected[i]);
+    }
+}
+
+
+TEST_CASE("hash create_batch", "[HashBatch]") {
+    auto files = test_files(200);
+    auto inputs = inputs_of(files);
+    test_create_batch<blake2b32>(inputs);
+    test_create_batch<blake2b64>(inputs);
+    test_create_batch<ext::sha256>(inputs);
+    test_create_batch<sha512>(inputs);
+
+    // Edge cases: nothing, one message, all-empty messages.
+    blake2b64::create_batch(nullptr, 0, nullptr);
+    test_create_batch<blake2b64>({inputs[0]});
+    vector<input_bytes> empties(100, input_bytes(nullptr, 0));
+    test_create_batch<blake2b64>(empties);
+}
+
+
+TEST_CASE("hash create_batch benchmark", "[.][HashBatch]") {
+    auto files = test_files(500);
+    auto inputs = inputs_of(files);
+    size_t total = 0;
+    for (auto &in : inputs) total += in.size;
+    vector<blake2b64> out(inputs.size());
+
+    using clock = chrono::steady_clock;
+    auto time_it = [&](auto fn) {
+        double best = 1e9;
+        for (int trial = 0; trial < 3; ++trial) {
+            auto start = clock::now();
+            fn();
+            best = min(best, chrono::duration<double>(clock::now() - start).count());
+        }
+        return best;
+    };
+    double serial = time_it([&] {
+        for (size_t i = 0; i < inputs.size(); ++i)
+            out[i] = blake2b64::create(inputs[i]);
+    });
+    double batch = time_it([&] {
+        blake2b64::create_batch(inputs.data(), inputs.size(), out.data());
+    });
+    cout << "Blake2b of " << inputs.size() << " files, " << total / 1e6 << " MB: "
+         << "one by one " << serial * 1e3 << " ms, create_batch " << batch * 1e3 << " ms ("
+         << serial / batch << "x on " << thread::hardware_concurrency() << " cores)\n";
+}
@@ -0,0 +1,140 @@
+//
+//  Test_KeyTable.cc
+//  Monocypher-Cpp
+//
+
+#include "Monocypher.hh"
+#include "monocypher/ext/key_table.hh"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+// Makes a recognizable key for connection `id`, version `version`.
+static session::key make_key(uint64_t id, uint64_t version) {
+    uint8_t bytes[32];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i]      = uint8_t(id >> (8 * i));
+        bytes[8 + i]  = uint8_t(version >> (8 * i));
+        bytes[16 + i] = bytes[24 + i] = uint8_t(0xA5 ^ i);
+    }
+    return session::key(bytes, sizeof(bytes));
+}
+
+static uint64_t key_id(session::key const& k) {
+    uint64_t id = 0;
+    for (int i = 0; i < 8; ++i)
+        id |= uint64_t(k[i]) << (8 * i);
+    return id;
+}
+
+
+TEST_CASE("Session key table", "[KeyTable]") {
+    session_key_table::options opts;
+    opts.max_keys = 100;
+    session_key_table table(opts);
+    cout << "Key memory locked: " << table.is_memory_locked() << endl;
+    session_key_table::reader reader(table);
+
+    for (uint64_t id = 1; id <= 100; ++id)
+        REQUIRE(table.insert_or_assign(id * 1000, make_key(id * 1000, 0)));
+    CHECK(table.size() == 100);
+    CHECK(!table.insert_or_assign(999, make_key(999, 0)));       // full
+
+    auto k = reader.find(5000);
+    REQUIRE(k);
+    CHECK(*k == make_key(5000, 0));
+    CHECK(!reader.find(5001));
+
+    // Rotate a key while a reader is using the old one (OK here since the pool isn't full):
+    bool found = reader.with_key(7000, [&](session::key const& old) {
+        REQUIRE(table.insert_or_assign(7000, make_key(7000, 1)));
+        CHECK(table.retired_count() == 1);          // can't be reclaimed yet
+        CHECK(old == make_key(7000, 0));            // still intact
+    });
+    CHECK(found);
+    table.collect();
+    CHECK(table.retired_count() == 0);
+    CHECK(*reader.find(7000) == make_key(7000, 1));
+    CHECK(table.size() == 100);
+
+    // A callback that throws doesn't leave the reader holding back reclamation:
+    CHECK_THROWS_AS(reader.with_key(7000, [](session::key const&) {throw runtime_error("oops");}),
+                    runtime_error);
+    REQUIRE(table.insert_or_assign(7000, make_key(7000, 1)));
+    table.collect();
+    CHECK(table.retired_count() == 0);
+
+    CHECK(table.erase(7000));
+    CHECK(!table.erase(7000));
+    CHECK(!reader.find(7000));
+    CHECK(table.size() == 99);
+
+    // Churn through many IDs, forcing the index to be rebuilt to clear tombstones:
+    for (uint64_t id = 1000001; id < 1005000; ++id) {
+        REQUIRE(table.insert_or_assign(id, make_key(id, 0)));
+        REQUIRE(table.erase(id));
+    }
+    CHECK(table.size() == 99);
+    CHECK(table.retired_count() == 0);
+    for (uint64_t id = 1; id <= 100; ++id) {
+        if (id != 7)
+            CHECK(*reader.find(id * 1000) == make_key(id * 1000, 0));
+    }
+}
+
+
+TEST_CASE("Session key table concurrency", "[KeyTable]") {
+    static constexpr uint64_t kKeys = 1000;
+    static constexpr int kReaders = 8;
+    session_key_table::options opts;
+    opts.max_keys = kKeys;
+    session_key_table table(opts);
+    for (uint64_t id = 0; id < kKeys; ++id)
+        REQUIRE(table.insert_or_assign(id, make_key(id, 0)));
+
+    atomic<bool> stop {false};
+    atomic<uint64_t> lookups {0}, bad {0};
+    vector<thread> readers;
+    for (int t = 0; t < kReaders; ++t) {
+        readers.emplace_back([&, t] {
+            session_key_table::reader reader(table);
+            uint64_t n = 0, id = t;
+            while (!stop) {
+                id = (id * 31 + 7) % kKeys;
+                bool found = reader.with_key(id, [&](session::key const& k) {
+                    if (key_id(k) != id)
+                        ++bad;
+                });
+                if (!found)
+                    ++bad;
+                ++n;
+            }
+            lookups += n;
+        });
+    }
+
+    // Rotate all the keys repeatedly while the readers run:
+    for (uint64_t version = 1; version <= 20; ++version) {
+        for (uint64_t id = 0; id < kKeys; ++id)
+            REQUIRE(table.insert_or_assign(id, make_key(id, version)));
+    }
+    stop = true;
+    for (auto &thread : readers)
+        thread.join();
+    table.collect();
+
+    cout << lookups << " lookups during rotation\n";
+    CHECK(bad == 0);
+    CHECK(table.retired_count() == 0);
+    session_key_table::reader reader(table);
+    for (uint64_t id = 0; id < kKeys; ++id)
+        CHECK(*reader.find(id) == make_key(id, 20));
+}
@@ -0,0 +1,123 @@
+//
+//  Test_Keyring.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/keyring.hh"
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+static string temp_path(const char *name) {
+    return string("/tmp/monocypher_test_") + name;
+}
+
+
+TEST_CASE("Keyring build and lookup", "[Keyring]") {
+    constexpr size_t kCount = 20000;
+    vector<keyring::key> keys(kCount);
+    keyring::builder builder;
+    for (size_t i = 0; i < kCount; ++i) {
+        keys[i].randomize();
+        string meta = (i % 3 == 0) ? "" : "key #" + to_string(i);
+        builder.add(keys[i], {meta.data(), meta.size()});
+    }
+    string path = temp_path("keyring");
+    builder.write(path.c_str());
+
+    keyring::builder dup_builder = builder;
+    dup_builder.add(keys[17]);
+    CHECK_THROWS_AS(dup_builder.write(path.c_str()), invalid_argument);
+
+    keyring ring(path.c_str());
+    REQUIRE(ring.size() == kCount);
+
+    // Every key is found, with its metadata:
+    for (size_t i = 0; i < kCount; ++i) {
+        auto e = ring.find(keys[i]);
+        REQUIRE(e);
+        CHECK(*e->key_ptr == keys[i]);
+        string meta((const char*)e->metadata.data, e->metadata.size);
+        CHECK(meta == ((i % 3 == 0) ? "" : "key #" + to_string(i)));
+
+        auto byID = ring.find(keyring::id_of(keys[i]));
+        REQUIRE(byID);
+        CHECK(byID->index == e->index);
+    }
+
+    // Keys are stored in sorted order:
+    for (size_t i = 1; i < kCount; ++i)
+        CHECK(memcmp(ring[i-1].key_ptr->data(), ring[i].key_ptr->data(), 32) < 0);
+
+    // Missing keys aren't found:
+    for (int i = 0; i < 1000; ++i) {
+        keyring::key missing;
+        missing.randomize();
+        CHECK(!ring.contains(missing));
+        CHECK(ring.find_all(keyring::id_of(missing)).empty());
+    }
+    // ...including ones adjacent to real keys:
+    keyring::key near = *ring[100].key_ptr;
+    near[31] ^= 1;
+    CHECK(!ring.contains(near));
+
+    auto pk = ring[5].typed_key<Ed25519>();
+    CHECK(ring.contains(pk));
+
+    remove(path.c_str());
+}
+
+
+TEST_CASE("Keyring empty", "[Keyring]") {
+    string path = temp_path("keyring_empty");
+    keyring::builder().write(path.c_str());
+    keyring ring(path.c_str());
+    CHECK(ring.size() == 0);
+    keyring::key k;
+    k.randomize();
+    CHECK(!ring.contains(k));
+    CHECK(!ring.find(keyring::id_of(k)));
+    remove(path.c_str());
+}
+
+
+TEST_CASE("Keyring invalid files", "[Keyring]") {
+    CHECK_THROWS_AS(keyring("/tmp/monocypher_test_nonexistent"), system_error);
+
+    keyring::builder builder;
+    for (int i = 0; i < 10; ++i) {
+        keyring::key k;
+        k.randomize();
+        builder.add(k, {"meta", 4});
+    }
+    string path = temp_path("keyring_bad");
+    builder.write(path.c_str());
+
+    // Truncate it:
+    FILE *f = fopen(path.c_str(), "rb");
+    vector<uint8_t> data(1 << 20);
+    data.resize(fread(data.data(), 1, data.size(), f));
+    fclose(f);
+    f = fopen(path.c_str(), "wb");
+    fwrite(data.data(), 1, data.size() - 1, f);
+    fclose(f);
+    CHECK_THROWS_AS(keyring(path.c_str()), runtime_error);
+
+    // Bad magic:
+    data[0] ^= 1;
+    f = fopen(path.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+    CHECK_THROWS_AS(keyring(path.c_str()), runtime_error);
+    remove(path.c_str());
+}
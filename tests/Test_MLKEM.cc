@@ -0,0 +1,164 @@
+//
+//  Test_MLKEM.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/mlkem.hh"
+#include <chrono>
+#include <iostream>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+// Digest of a large value, to keep the expected values below short.
+template <size_t Size>
+static string digest(byte_array<Size> const& data) {
+    auto h = blake2b32::create(data.data(), data.size());
+    return hexString(h.data(), h.size(), false);
+}
+
+
+TEST_CASE("ML-KEM-768 known answers", "[MLKEM]") {
+    // Expected values computed by a separate implementation of the FIPS 203 pseudocode.
+    struct vector {
+        uint8_t d, z, m;            // each is 32 bytes: 0,1,2... or all the same value
+        bool    counting;
+        const char *public_key, *ciphertext, *shared_secret, *rejection_secret;
+    };
+    static const vector kVectors[] = {
+        {0, 32, 64, true,
+         "ED55DC79A5E00EE5A5517D622E5B2D6F22AD296C2796301EB38DC3F40E6E5E62",
+         "9B4092DE550F283C52EC84187BCE3A39E16CF54ED63449AC765D237563E2B9AF",
+         "9CDDD089FFE70E3996E76F7C8D06746DF34D07E8657BC0FCF2BB0E1C3084AEA1",
+         "B226202DDEC451DD618360BF464885649F11FC709A7E62954804F2E4EC5BD71E"},
+        {0xFF, 0xEE, 0xDD, false,
+         "DB35A96EAD0A74FA6EC7C29EB85178A46E38C012F084BF95F99C7D6A7F927C38",
+         "AA120AB950CFE7D779E7CA281594C75D6F5212003CBA56051758C56C8F976110",
+         "9C7B58E9F0A16F6C38FFF9DE8FF928AEDB1247F0BA2F7535AE3B8C3D86ABFF79",
+         "BD67B6A4ABC14A6785AB83524DA2A271FD05054014E7BF916E4AA6DC709A2F4D"},
+    };
+
+    using KEM = kem<ML_KEM_768>;
+    for (bool simd : {true, false}) {
+        bool usingSIMD = ML_KEM_768::set_simd_enabled(simd);
+        INFO("SIMD = " << usingSIMD);
+        for (auto &v : kVectors) {
+            KEM::seed seed;
+            byte_array<32> m;
+            for (uint8_t i = 0; i < 32; ++i) {
+                seed[i]      = v.counting ? uint8_t(v.d + i) : v.d;
+                seed[32 + i] = v.counting ? uint8_t(v.z + i) : v.z;
+                m[i]         = v.counting ? uint8_t(v.m + i) : v.m;
+            }
+            KEM recipient(seed);
+            CHECK(digest(recipient.get_public_key()) == v.public_key);
+
+            auto [ct, secret] = KEM::encapsulate(recipient.get_public_key(), m);
+            CHECK(digest(ct) == v.ciphertext);
+            CHECK(hexString(secret.data(), 32, false) == v.shared_secret);
+            CHECK(recipient.decapsulate(ct) == secret);
+
+            // Implicit rejection: a bad ciphertext yields a pseudorandom secret derived from z.
+            ct[1000] ^= 0x80;
+            CHECK(hexString(recipient.decapsulate(ct).data(), 32, false) == v.rejection_secret);
+        }
+    }
+    ML_KEM_768::set_simd_enabled(true);
+}
+
+
+TEST_CASE("ML-KEM-768 round trip", "[MLKEM]") {
+    using KEM = kem<ML_KEM_768>;
+    for (int i = 0; i < 20; ++i) {
+        KEM recipient;
+        REQUIRE(KEM::is_valid(recipient.get_public_key()));
+        auto [ct, secret] = KEM::encapsulate(recipient.get_public_key());
+        CHECK(recipient.decapsulate(ct) == secret);
+
+        ct[i * 50] ^= 1;
+        CHECK(recipient.decapsulate(ct) != secret);
+
+        KEM other;
+        ct[i * 50] ^= 1;
+        CHECK(other.decapsulate(ct) != secret);
+    }
+
+    // A public key with a coefficient >= q is rejected:
+    KEM recipient;
+    KEM::public_key pk = recipient.get_public_key();
+    pk[0] = 0xFF;
+    pk[1] |= 0x0F;
+    CHECK(!KEM::is_valid(pk));
+    CHECK_THROWS_AS(KEM::encapsulate(pk), invalid_argument);
+}
+
+
+TEST_CASE("X25519+ML-KEM-768 hybrid", "[MLKEM]") {
+    using KEM = kem<X25519_MLKEM768>;
+    KEM::seed seed;
+    seed.randomize();
+    KEM recipient(seed);
+    CHECK(KEM(seed).get_public_key() == recipient.get_public_key());     // deterministic
+
+    for (int i = 0; i < 10; ++i) {
+        auto [ct, secret] = KEM::encapsulate(recipient.get_public_key());
+        CHECK(recipient.decapsulate(ct) == secret);
+
+        // Tampering with either component changes the secret:
+        KEM::ciphertext bad = ct;
+        bad[17] ^= 1;
+        CHECK(recipient.decapsulate(bad) != secret);
+        bad = ct;
+        bad[ML_KEM_768::ciphertext_size + 5] ^= 1;
+        CHECK(recipient.decapsulate(bad) != secret);
+    }
+
+    // The ML-KEM part of the public key, and its shared secret, are ML-KEM's:
+    KEM::public_key pk = recipient.get_public_key();
+    byte_array<64> randomness;
+    randomness.randomize();
+    auto [ct, secret] = KEM::encapsulate(pk, randomness);
+    kem<ML_KEM_768>::public_key mlkem_pk(pk.data(), ML_KEM_768::public_key_size);
+    auto [mlkem_ct, mlkem_secret] = kem<ML_KEM_768>::encapsulate(mlkem_pk,
+                                                                 randomness.range<0,32>());
+    CHECK(memcmp(ct.data(), mlkem_ct.data(), ML_KEM_768::ciphertext_size) == 0);
+    CHECK(secret != mlkem_secret);
+}
+
+
+TEST_CASE("ML-KEM-768 benchmark", "[.][MLKEM]") {
+    auto bench = [](const char *what, int n, auto fn) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i)
+            fn();
+        chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+        cout << "    " << what << ": " << elapsed.count() / n << " us, "
+             << int(n / (elapsed.count() / 1e6)) << "/sec\n";
+    };
+
+    for (bool simd : {true, false}) {
+        cout << "ML-KEM-768 (" << (ML_KEM_768::set_simd_enabled(simd) ? "AVX2" : "portable")
+             << "):\n";
+        using KEM = kem<ML_KEM_768>;
+        KEM recipient;
+        auto [ct, secret] = KEM::encapsulate(recipient.get_public_key());
+        bench("keygen", 200, [] {KEM k;});
+        bench("encaps", 200, [&] {(void)KEM::encapsulate(recipient.get_public_key());});
+        bench("decaps", 200, [&] {(void)recipient.decapsulate(ct);});
+    }
+    ML_KEM_768::set_simd_enabled(true);
+
+    cout << "X25519+ML-KEM-768:\n";
+    using KEM = kem<X25519_MLKEM768>;
+    KEM recipient;
+    auto [ct, secret] = KEM::encapsulate(recipient.get_public_key());
+    bench("keygen", 50, [] {KEM k;});
+    bench("encaps", 50, [&] {(void)KEM::encapsulate(recipient.get_public_key());});
+    bench("decaps", 50, [&] {(void)recipient.decapsulate(ct);});
+}
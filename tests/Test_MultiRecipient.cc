@@ -0,0 +1,121 @@
+//
+//  Test_MultiRecipient.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/multi_recipient.hh"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+TEST_CASE("Multi-recipient envelope", "[MultiRecipient]") {
+    string payload = "The quick brown fox jumped over the lazy dog's back.";
+    for (size_t count : {1, 2, 3, 100, 1000}) {
+        vector<multi_recipient::key_exchange> recipients(count);
+        vector<multi_recipient::public_key> public_keys;
+        for (auto &r : recipients)
+            public_keys.push_back(r.get_public_key());
+
+        auto start = chrono::steady_clock::now();
+        vector<uint8_t> envelope = multi_recipient::seal(payload, public_keys);
+        auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start);
+        cout << count << " recipients: envelope is " << envelope.size() << " bytes, sealed in "
+             << elapsed.count() << " ms\n";
+        CHECK(envelope.size() == multi_recipient::envelope_size(count, payload.size()));
+        REQUIRE(multi_recipient::payload_size({envelope.data(), envelope.size()}) == payload.size());
+
+        // Spot-check some recipients (all of them, if there are few):
+        for (size_t i = 0; i < count; i += (count < 10 ? 1 : count / 7)) {
+            char buf[100];
+            output_bytes out = multi_recipient::open({envelope.data(), envelope.size()},
+                                                     recipients[i], {buf, sizeof(buf)});
+            REQUIRE(out);
+            CHECK(string(buf, out.size) == payload);
+        }
+
+        // A non-recipient can't open it:
+        multi_recipient::key_exchange stranger;
+        char buf[100];
+        CHECK(!multi_recipient::open({envelope.data(), envelope.size()}, stranger, {buf, sizeof(buf)}));
+    }
+}
+
+
+TEST_CASE("Multi-recipient envelope tampering", "[MultiRecipient]") {
+    vector<multi_recipient::key_exchange> recipients(10);
+    vector<multi_recipient::public_key> public_keys;
+    for (auto &r : recipients)
+        public_keys.push_back(r.get_public_key());
+    string payload = "hello";
+    vector<uint8_t> envelope = multi_recipient::seal(payload, public_keys, 1);
+    char buf[100];
+
+    auto opens = [&](vector<uint8_t> const& env, size_t i) {
+        return bool(multi_recipient::open({env.data(), env.size()}, recipients[i], {buf, sizeof(buf)}));
+    };
+
+    for (size_t i = 0; i < 10; ++i)
+        CHECK(opens(envelope, i));
+
+    auto corrupt = envelope;
+    corrupt.back() ^= 1;                                    // payload
+    CHECK(!opens(corrupt, 0));
+    corrupt = envelope;
+    corrupt[5] ^= 1;                                        // ephemeral key
+    CHECK(!opens(corrupt, 0));
+    corrupt = envelope;
+    corrupt[0] = 2;                                         // version
+    CHECK(!opens(corrupt, 0));
+    corrupt = envelope;
+    corrupt[34] = 0xFF;                                     // count
+    CHECK(!opens(corrupt, 0));
+    corrupt.resize(40);
+    CHECK(!opens(corrupt, 0));
+    CHECK(multi_recipient::payload_size({corrupt.data(), corrupt.size()}) == 0);
+
+    // The fanout-bits byte must match the count, or the table offsets would be wrong:
+    for (uint8_t bits : {0, 2, 4, 16, 255}) {
+        corrupt = envelope;
+        corrupt[33] = bits;
+        CHECK(!opens(corrupt, 0));
+        CHECK(multi_recipient::payload_size({corrupt.data(), corrupt.size()}) == 0);
+    }
+    corrupt = envelope;
+    corrupt[34] = 9;                                        // a count with the same bits
+    CHECK(!opens(corrupt, 0));
+}
+
+
+TEST_CASE("Multi-recipient envelope header bits", "[MultiRecipient]") {
+    multi_recipient::key_exchange recipient;
+    multi_recipient::public_key public_key = recipient.get_public_key();
+    vector<uint8_t> envelope = multi_recipient::seal("hi"sv, &public_key, 1);
+    char buf[100];
+    auto opens = [&](vector<uint8_t> const& env) {
+        return bool(multi_recipient::open({env.data(), env.size()}, recipient, {buf, sizeof(buf)}));
+    };
+    CHECK(opens(envelope));
+
+    for (uint8_t bits : {1, 16}) {                          // one recipient has no fanout bits
+        auto corrupt = envelope;
+        corrupt[33] = bits;
+        CHECK(!opens(corrupt));
+        CHECK(multi_recipient::payload_size({corrupt.data(), corrupt.size()}) == 0);
+    }
+    for (uint32_t count : {2u, 0xFFFFFFFFu}) {
+        auto corrupt = envelope;
+        for (int i = 0; i < 4; ++i)
+            corrupt[34 + i] = uint8_t(count >> (8 * i));
+        CHECK(!opens(corrupt));
+        CHECK(multi_recipient::payload_size({corrupt.data(), corrupt.size()}) == 0);
+    }
+}
@@ -0,0 +1,339 @@
+//
+//  Test_Noise.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/noise.hh"
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+// Runs a handshake to completion, passing a payload in each message.
+template <class Handshake>
+static void run_handshake(Handshake &initiator, Handshake &responder) {
+    uint8_t message[1024], payload[1024];
+    int n = 0;
+    while (!initiator.is_complete() || !responder.is_complete()) {
+        Handshake &sender   = initiator.is_my_turn() ? initiator : responder;
+        Handshake &receiver = initiator.is_my_turn() ? responder : initiator;
+        string text = "handshake payload #" + to_string(++n);
+        size_t expected_size = sender.message_size(text.size());
+        output_bytes msg = sender.write_message(text, {message, sizeof(message)});
+        cout << "message " << n << " (" << msg.size << " bytes)\n";
+        REQUIRE(msg.size == expected_size);
+        output_bytes got = receiver.read_message({msg.data, msg.size}, {payload, sizeof(payload)});
+        REQUIRE(got);
+        CHECK(string((char*)got.data, got.size) == text);
+    }
+    CHECK(initiator.handshake_hash() == responder.handshake_hash());
+}
+
+
+// Checks that two transports can exchange messages in both directions.
+static void check_transport(noise::transport &a, noise::transport &b) {
+    for (int i = 0; i < 3; ++i) {
+        string text = "transport message " + to_string(i);
+        uint8_t cipher[100], plain[100];
+        output_bytes c = a.send.encrypt({nullptr, 0}, text, {cipher, sizeof(cipher)});
+        CHECK(c.size == text.size() + noise::mac_size);
+        auto p = b.receive.decrypt({nullptr, 0}, {c.data, c.size}, {plain, sizeof(plain)});
+        REQUIRE(p);
+        CHECK(string((char*)p->data, p->size) == text);
+
+        c = b.send.encrypt({nullptr, 0}, text, {cipher, sizeof(cipher)});
+        p = a.receive.decrypt({nullptr, 0}, {c.data, c.size}, {plain, sizeof(plain)});
+        REQUIRE(p);
+        CHECK(string((char*)p->data, p->size) == text);
+    }
+}
+
+
+TEST_CASE("Noise XX", "[Noise]") {
+    noise::secret_key alice_key, bob_key;
+    alice_key.randomize();
+    bob_key.randomize();
+
+    noise::handshake alice(noise::pattern::XX, noise::role::initiator,
+                           {"prologue"sv, alice_key, nullopt});
+    noise::handshake bob(noise::pattern::XX, noise::role::responder,
+                         {"prologue"sv, bob_key, nullopt});
+    CHECK(alice.is_my_turn());
+    CHECK(!bob.is_my_turn());
+    CHECK(!bob.remote_static_key());
+    run_handshake(alice, bob);
+
+    // Each side has learned the other's static key:
+    CHECK(*alice.remote_static_key() == noise::dh(bob_key).get_public_key());
+    CHECK(*bob.remote_static_key() == noise::dh(alice_key).get_public_key());
+
+    auto ta = alice.split(), tb = bob.split();
+    check_transport(ta, tb);
+
+    // Rekeying both directions in sync still works:
+    ta.send.rekey();
+    tb.receive.rekey();
+    check_transport(ta, tb);
+}
+
+
+TEST_CASE("Noise NK and IK", "[Noise]") {
+    noise::secret_key server_key, client_key;
+    server_key.randomize();
+    client_key.randomize();
+    auto server_pub = noise::dh(server_key).get_public_key();
+
+    SECTION("NK") {
+        noise::handshake client(noise::pattern::NK, noise::role::initiator,
+                                {{nullptr, 0}, nullopt, server_pub});
+        noise::handshake server(noise::pattern::NK, noise::role::responder,
+                                {{nullptr, 0}, server_key, nullopt});
+        run_handshake(client, server);
+        CHECK(!server.remote_static_key());
+        auto tc = client.split(), ts = server.split();
+        check_transport(tc, ts);
+    }
+    SECTION("IK") {
+        noise::handshake client(noise::pattern::IK, noise::role::initiator,
+                                {{nullptr, 0}, client_key, server_pub});
+        noise::handshake server(noise::pattern::IK, noise::role::responder,
+                                {{nullptr, 0}, server_key, nullopt});
+        run_handshake(client, server);
+        CHECK(*server.remote_static_key() == noise::dh(client_key).get_public_key());
+        auto tc = client.split(), ts = server.split();
+        check_transport(tc, ts);
+    }
+    SECTION("Missing keys") {
+        CHECK_THROWS_AS(noise::handshake(noise::pattern::IK, noise::role::initiator,
+                                         {{nullptr, 0}, client_key, nullopt}),
+                        std::invalid_argument);
+        CHECK_THROWS_AS(noise::handshake(noise::pattern::XX, noise::role::responder, {}),
+                        std::invalid_argument);
+    }
+}
+
+
+// Known-answer vectors for Noise_{NK,XX,IK}_25519_ChaChaPoly_BLAKE2b. The keys, prologue and
+// payloads are those of the cacophony test vectors; the expected messages were computed with an
+// independent implementation of the Noise spec (its ChaCha20-Poly1305 and X25519 checked against
+// RFC 8439 and RFC 7748.) Each handshake message carries a payload, then the initiator and the
+// responder each send one transport message.
+struct noise_vector {
+    noise::pattern pattern;
+    const char    *messages[3];
+    const char    *handshake_hash;
+    const char    *transport[2];
+};
+
+static const noise_vector kNoiseVectors[] = {
+    {noise::pattern::NK, {
+        "ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c7944f3041e39b0c8ba56008f2d11"
+        "83fea6ac83564ead0267b0842ec4c521ed1e1407",
+        "95ebc60d2b1fa672c1f46a8aa265ef51bfe38e7ccb39ec5be34069f1448088432281dcc1835131f305dca145"
+        "25e15e27d1f32294aa835e40fc18be480c1db9",
+        nullptr},
+     "f87aa4eb6416e5b0d2b6e6f0b7bc41f3c5986a5d32d55c08d67cbd412f3ec2fa04d8e358ab95b3bbfab054a1"
+     "40a98eccf4284bb6309b600981d451ecac484932", {
+        "303176c4fce68f2f9e6676342db8ec2920e4aba0c54412a9397c0b",
+        "8227a04dfe1999fe793554bc7c000546e267592ece519c8600fa929d9f8777b9a2"}},
+    {noise::pattern::XX, {
+        "ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c79444c756477696720766f6e204d"
+        "69736573",
+        "95ebc60d2b1fa672c1f46a8aa265ef51bfe38e7ccb39ec5be34069f1448088430505b6745ce64a5f33f0e8e3"
+        "b83f11ce8802bca507f4f2d8b564dbe277e1966116e132faa2dfd70b8b077b9f94b913df5056ae1319469b82"
+        "4a98d54bbaa82c325595587064f978c4b6d104f7596e6f",
+        "99579e1c1ee15e422a57ddd6b16d37087b17558e8369c18991b4b2ca3a824abf904cdcf5458b5431a75af034"
+        "ca9e9b982de039eaaf156775e2d580cd4e5ebae89c3f8cb2594b556d8a8169"},
+     "8cf47d7b3cb5804c0109d48e8bcdbee2cbb65687d8ea2c92994ca361fb86151ad93627b98936cbb32de56e8a"
+     "bb21def3925011ac3e35db9cbeea73ab9a4392c2", {
+        "b235dad81dda67845fd789dbc4b4caeec1afdb281b22ad25eb4e96",
+        "f552fda09dbcf7bc09a00d0a76ffb2260c344598b96b7144208da092d6d4245e5c"}},
+    {noise::pattern::IK, {
+        "ca35def5ae56cec33dc2036731ab14896bc4c75dbb07a61f879f8e3afa4c7944ba83a447b38c83e327ad9369"
+        "29812f624884847b7831e95e197b2f797088efdd2f88f1db7e1fb0e99c64419097af91cee64e470f4b6fcd92"
+        "98ce0b56fe20f86e13bf70439c538e3602a7127af71a29cc",
+        "95ebc60d2b1fa672c1f46a8aa265ef51bfe38e7ccb39ec5be34069f1448088439f069b267a06b3de3ecb1043"
+        "bcb098e9af91d9c64748d998c7b47890871571",
+        nullptr},
+     "1c8fa891cb414fedba6daa7c6f4ae0a6d98e5f9768cc9cecd27e805614943ee9c8a1b27fbfb76dc197255c8a"
+     "a69f6b4285c423840b8bedf45e652ca64f797d81", {
+        "c81b6a1d6e8a8f8b2accbbe13aebb915054e9be09e8ec977a4eb3e",
+        "a152c0bd0f49bbda65ca545c7e7e2389cf1e5d9efbafd306b490e8b583c7218144"}},
+};
+
+
+TEST_CASE("Noise known-answer vectors", "[Noise]") {
+    auto key = [](const char *hex) {
+        noise::secret_key k;
+        k.fillWith(from_hex(hex).data(), 32);
+        return k;
+    };
+    auto init_static  = key("e61ef9919cde45dd5f82166404bd08e38bceb5dfdfded0a34c8df7ed542214d1");
+    auto init_eph     = key("893e28b9dc6ca8d611ab664754b8ceb7bac5117349a4439a6b0569da977c464a");
+    auto resp_static  = key("4a3acbfdb163dec651dfa3194dece676d437029c62a408b4c5ea9114246e4893");
+    auto resp_eph     = key("bbdb4cdbd309f1a1f2e1456967fe288cadd6f712d65dc7b7793d5e63da6b375b");
+    auto resp_pub     = noise::dh(resp_static).get_public_key();
+    const string_view prologue = "John Galt";
+    const string_view payloads[3] = {"Ludwig von Mises", "Murray Rothbard", "F. A. Hayek"};
+    const string_view transport[2] = {"Carl Menger", "Jean-Baptiste Say"};
+
+    for (auto &v : kNoiseVectors) {
+        INFO("pattern #" << int(v.pattern));
+        noise::handshake::options init_opts {prologue, init_static, resp_pub, init_eph};
+        if (v.pattern == noise::pattern::NK)
+            init_opts.local_static = nullopt;
+        else if (v.pattern == noise::pattern::XX)
+            init_opts.remote_static = nullopt;
+        noise::handshake initiator(v.pattern, noise::role::initiator, init_opts);
+        noise::handshake responder(v.pattern, noise::role::responder,
+                                   {prologue, resp_static, nullopt, resp_eph});
+
+        uint8_t message[200], payload[200];
+        for (int i = 0; !initiator.is_complete(); ++i) {
+            INFO("message " << i + 1);
+            auto &sender   = initiator.is_my_turn() ? initiator : responder;
+            auto &receiver = initiator.is_my_turn() ? responder : initiator;
+            output_bytes msg = sender.write_message(payloads[i], {message, sizeof(message)});
+            CHECK(vector<uint8_t>(u8(msg.data), u8(msg.data) + msg.size) == from_hex(v.messages[i]));
+            output_bytes got = receiver.read_message({msg.data, msg.size}, {payload, sizeof(payload)});
+            REQUIRE(got);
+            CHECK(string_view((char*)got.data, got.size) == payloads[i]);
+        }
+        REQUIRE(responder.is_complete());
+        CHECK(vector<uint8_t>(initiator.handshake_hash().begin(), initiator.handshake_hash().end())
+              == from_hex(v.handshake_hash));
+        CHECK(responder.handshake_hash() == initiator.handshake_hash());
+
+        auto ti = initiator.split(), tr = responder.split();
+        for (int i = 0; i < 2; ++i) {
+            auto &sender = (i == 0) ? ti : tr, &receiver = (i == 0) ? tr : ti;
+            uint8_t cipher[100], plain[100];
+            output_bytes c = sender.send.encrypt({nullptr, 0}, transport[i], {cipher, sizeof(cipher)});
+            CHECK(vector<uint8_t>(cipher, cipher + c.size) == from_hex(v.transport[i]));
+            auto p = receiver.receive.decrypt({nullptr, 0}, {c.data, c.size},
+                                              {plain, sizeof(plain)});
+            REQUIRE(p);
+            CHECK(string_view((char*)p->data, p->size) == transport[i]);
+        }
+    }
+}
+
+
+TEST_CASE("Noise empty payloads", "[Noise]") {
+    noise::secret_key server_key;
+    server_key.randomize();
+    noise::handshake client(noise::pattern::NK, noise::role::initiator,
+                            {{nullptr, 0}, nullopt, noise::dh(server_key).get_public_key()});
+    noise::handshake server(noise::pattern::NK, noise::role::responder,
+                            {{nullptr, 0}, server_key, nullopt});
+    // Read each message's empty payload into a null buffer:
+    uint8_t message[200];
+    output_bytes msg = client.write_message({nullptr, 0}, {message, sizeof(message)});
+    CHECK(msg.size == 48);
+    output_bytes got = server.read_message({msg.data, msg.size}, {nullptr, 0});
+    CHECK(got);
+    CHECK(got.size == 0);
+    msg = server.write_message({nullptr, 0}, {message, sizeof(message)});
+    got = client.read_message({msg.data, msg.size}, {nullptr, 0});
+    CHECK(got);
+    CHECK(got.size == 0);
+    REQUIRE(client.is_complete());
+    REQUIRE(server.is_complete());
+
+    auto tc = client.split(), ts = server.split();
+    output_bytes c = tc.send.encrypt({nullptr, 0}, {nullptr, 0}, {message, sizeof(message)});
+    auto p = ts.receive.decrypt({nullptr, 0}, {c.data, c.size}, {nullptr, 0});
+    REQUIRE(p);
+    CHECK(p->size == 0);
+
+    // Same for a resumption:
+    noise::ticket_cache cache;
+    cache.insert(server.get_resumption_ticket());
+    noise::resumption rclient(client.get_resumption_ticket()), rserver(cache);
+    msg = rclient.write_message({nullptr, 0}, {message, sizeof(message)});
+    CHECK(rserver.read_message({msg.data, msg.size}, {nullptr, 0}));
+    msg = rserver.write_message({nullptr, 0}, {message, sizeof(message)});
+    CHECK(rclient.read_message({msg.data, msg.size}, {nullptr, 0}));
+    CHECK(rclient.is_complete());
+}
+
+
+TEST_CASE("Noise handshake failures", "[Noise]") {
+    noise::secret_key server_key, other_key;
+    server_key.randomize();
+    other_key.randomize();
+
+    // Initiator has the wrong static key for the responder:
+    noise::handshake client(noise::pattern::NK, noise::role::initiator,
+                            {{nullptr, 0}, nullopt, noise::dh(other_key).get_public_key()});
+    noise::handshake server(noise::pattern::NK, noise::role::responder,
+                            {{nullptr, 0}, server_key, nullopt});
+    uint8_t message[200], payload[200];
+    output_bytes msg = client.write_message("hi"sv, {message, sizeof(message)});
+    CHECK(!server.read_message({msg.data, msg.size}, {payload, sizeof(payload)}));
+
+    CHECK_THROWS_AS(server.split(), std::logic_error);
+    CHECK_THROWS_AS(client.write_message("again"sv, {message, sizeof(message)}),
+                    std::logic_error);
+
+    // A tampered message fails too:
+    noise::handshake server2(noise::pattern::NK, noise::role::responder,
+                             {{nullptr, 0}, other_key, nullopt});
+    message[msg.size - 1] ^= 1;
+    CHECK(!server2.read_message({msg.data, msg.size}, {payload, sizeof(payload)}));
+}
+
+
+TEST_CASE("Noise resumption", "[Noise]") {
+    noise::secret_key server_key;
+    server_key.randomize();
+    auto server_pub = noise::dh(server_key).get_public_key();
+    noise::ticket_cache cache(2);
+
+    noise::handshake client(noise::pattern::NK, noise::role::initiator,
+                            {{nullptr, 0}, nullopt, server_pub});
+    noise::handshake server(noise::pattern::NK, noise::role::responder,
+                            {{nullptr, 0}, server_key, nullopt});
+    run_handshake(client, server);
+    noise::resumption_ticket ticket = client.get_resumption_ticket();
+    noise::resumption_ticket server_ticket = server.get_resumption_ticket();
+    CHECK(ticket.ticket_id == server_ticket.ticket_id);
+    CHECK(ticket.ticket_secret == server_ticket.ticket_secret);
+    cache.insert(server_ticket);
+    CHECK(cache.size() == 1);
+
+    // Resume without any DH:
+    noise::resumption rclient(ticket), rserver(cache);
+    run_handshake(rclient, rserver);
+    auto tc = rclient.split(), ts = rserver.split();
+    check_transport(tc, ts);
+    CHECK(cache.size() == 0);
+
+    // The ticket was consumed, so it can't be replayed:
+    noise::resumption rclient2(ticket), rserver2(cache);
+    uint8_t message[200], payload[200];
+    output_bytes msg = rclient2.write_message("replay"sv, {message, sizeof(message)});
+    CHECK(!rserver2.read_message({msg.data, msg.size}, {payload, sizeof(payload)}));
+
+    // But the resumed session issues a new ticket:
+    cache.insert(rserver.get_resumption_ticket());
+    noise::resumption rclient3(rclient.get_resumption_ticket()), rserver3(cache);
+    run_handshake(rclient3, rserver3);
+
+    // The cache evicts the oldest tickets when full:
+    noise::resumption_ticket t1, t2, t3;
+    t1.ticket_id.randomize();  t2.ticket_id.randomize();  t3.ticket_id.randomize();
+    cache.insert(t1);
+    cache.insert(t2);
+    cache.insert(t3);
+    CHECK(cache.size() == 2);
+    CHECK(!cache.take(t1.ticket_id));
+    CHECK(cache.take(t3.ticket_id));
+}
@@ -0,0 +1,237 @@
+//
+//  Test_Paseto.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/paseto.hh"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+static const char *kSignedMessage =
+    R"({"data":"this is a signed message","exp":"2022-01-01T00:00:00+00:00"})";
+static const char *kSecretMessage =
+    R"({"data":"this is a secret message","exp":"2022-01-01T00:00:00+00:00"})";
+static const char *kFooter = R"({"kid":"zVhMiPBP9fRf2snEcT7gFTioeA9COcNy9DfgL1W60haN"})";
+static const char *kImplicit = R"({"test-vector":"4-E-9"})";
+
+
+TEST_CASE("Base64url", "[Paseto]") {
+    CHECK(base64url_encode(string_view("")) == "");
+    CHECK(base64url_encode(string_view("f")) == "Zg");
+    CHECK(base64url_encode(string_view("fo")) == "Zm8");
+    CHECK(base64url_encode(string_view("foo")) == "Zm9v");
+    CHECK(base64url_encode(string_view("\xfb\xff\xbf")) == "-_-_");
+
+    // Round trip every length, through both the SIMD and scalar decoders:
+    vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uint8_t(i * 131 + 7);
+    for (bool simd : {true, false}) {
+        bool using_simd = base64url_set_simd(simd);
+        INFO("SIMD " << using_simd);
+        for (size_t len = 0; len <= data.size(); ++len) {
+            string enc = base64url_encode({data.data(), len});
+            CHECK(enc.size() == base64url_encoded_size(len));
+            CHECK(base64url_decoded_size(enc.size()) == len);
+            vector<uint8_t> dec(enc.size() + 1);
+            output_bytes out = base64url_decode(enc, {dec.data(), dec.size()});
+            REQUIRE(out);
+            CHECK(out.size == len);
+            CHECK(memcmp(dec.data(), data.data(), len) == 0);
+        }
+
+        // Every invalid character is caught, wherever it is:
+        string enc = base64url_encode({data.data(), 96});
+        vector<uint8_t> dec(enc.size());
+        for (char bad : {'=', '+', '/', '.', ' ', '\0', '\x80', '\xff', '@', '[', '`', '{'}) {
+            for (size_t pos : {0, 5, 31, 32, 63, 100, 127}) {
+                string corrupt = enc;
+                corrupt[pos] = bad;
+                CHECK(!base64url_decode(corrupt, {dec.data(), dec.size()}));
+            }
+        }
+    }
+    base64url_set_simd(true);
+
+    uint8_t buf[8];
+    CHECK(!base64url_decode("Zm9vY", {buf, sizeof(buf)}));      // impossible length
+    CHECK(!base64url_decode("Zh", {buf, sizeof(buf)}));         // nonzero unused bits
+    CHECK(!base64url_decode("Zm9", {buf, sizeof(buf)}));
+    CHECK(base64url_decode("Zm8", {buf, sizeof(buf)}).size == 2);
+    CHECK(!base64url_decode("Zm9vZm9vZm9v", {buf, sizeof(buf)}));   // buffer too small
+}
+
+
+TEST_CASE("PASETO v4.public test vector", "[Paseto]") {
+    // Test vector 4-S-1 from the PASETO spec:
+    key_pair<Ed25519> kp(key_pair<Ed25519>::seed(
+        from_hex("b4cbfb43df4ce210727d953e4a713307fa19bb7d9f85041438d9e11b942a3774").data(), 32));
+    CHECK(hexString(kp.get_public_key().data(), 32, false) ==
+          "1EB9DBBBBC047C03FD70604E0071F0987E16B28B757225C11F00415D0E20B1A2");
+    string expected = "v4.public.eyJkYXRhIjoidGhpcyBpcyBhIHNpZ25lZCBtZXNzYWdlIiwiZXhwIjoiMjAyMi0wMS0w"
+                      "MVQwMDowMDowMCswMDowMCJ9bg_XBBzds8lTZShVlwwKSgeKpLT3yukTw6JUz3W4h_ExsQV-P0V5"
+                      "4zemZDcAxFaSeef1QlXEFtkqxT1ciiQEDA";
+    paseto::signer signer(kp);
+    string token = signer.sign(string_view(kSignedMessage));
+    CHECK(token == expected);
+
+    paseto::verifier verifier(kp.get_public_key());
+    CHECK(verifier.verify(token) == string(kSignedMessage));
+
+    // With a footer and an implicit assertion:
+    token = signer.sign(string_view(kSignedMessage), kFooter, kImplicit);
+    CHECK(token == "v4.public.eyJkYXRhIjoidGhpcyBpcyBhIHNpZ25lZCBtZXNzYWdlIiwiZXhwIjoiMjAyMi0wMS0w"
+                   "MVQwMDowMDowMCswMDowMCJ9GlTjXtQmrgSu-CZ3QBxa4qg4Pz2uR3V2k2Jra860lLnlorosElos"
+                   "f8XINfd88vgotP7Spi6TBIHwCW03z3C3Bw.eyJraWQiOiJ6VmhNaVBCUDlmUmYyc25FY1Q3Z0ZUaW9l"
+                   "QTlDT2NOeTlEZmdMMVc2MGhhTiJ9");
+    CHECK(paseto::footer(token) == string(kFooter));
+    CHECK(verifier.verify(token, kImplicit) == string(kSignedMessage));
+    CHECK(!verifier.verify(token));
+    CHECK(!verifier.verify(token, "{}"));
+}
+
+
+TEST_CASE("PASETO v4.local test vectors", "[Paseto]") {
+    // The key, nonce and message of spec vector 4-E-1, then with a footer and implicit assertion:
+    paseto::local::key key(from_hex("707172737475767778797a7b7c7d7e7f"
+                                    "808182838485868788898a8b8c8d8e8f").data(), 32);
+    paseto::local local(key);
+    byte_array<32> nonce(0);
+    string token = local.encrypt(string_view(kSecretMessage), {}, {}, nonce);
+    CHECK(token == "v4.local.AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAQAr68PS4AXe7If_ZgesdkUMvSwscF"
+                   "lAl1pk5HC0e8kApeaqMfGo_7OpBnwJOAbY9V7WU6abu74MmcUE8YWAiaArVI8XJ5hOb_4v9RmDkneN"
+                   "0S92dx0OW4pgy7omxgf3S8c3LlQg");
+    CHECK(local.decrypt(token) == string(kSecretMessage));
+
+    nonce.fillWith(from_hex("df654812bac492663825520ba2f6e67cf5ca5bdc13d4e7507a98cc4c2fcc3ad8").data(), 32);
+    token = local.encrypt(string_view(kSecretMessage), kFooter, kImplicit, nonce);
+    CHECK(token == "v4.local.32VIErrEkmY4JVILovbmfPXKW9wT1OdQepjMTC_MOtjA4kiqw7_tcaOM5GNEcnTxl60Wkw"
+                   "MsYXw6FSNb_UdJPXjpzm0KW9ojM5f4O2mRvE2IcweP-PRdoHjd5-RHCiExR1IK6t7o_H6O7tjA4QHH"
+                   "ISwf7tV_o6mz2A3hDAoQsizYe1o0vw.eyJraWQiOiJ6VmhNaVBCUDlmUmYyc25FY1Q3Z0ZUaW9lQTl"
+                   "DT2NOeTlEZmdMMVc2MGhhTiJ9");
+    CHECK(local.decrypt(token, kImplicit) == string(kSecretMessage));
+    CHECK(!local.decrypt(token));
+}
+
+
+TEST_CASE("PASETO v4.local", "[Paseto]") {
+    paseto::local::key key;
+    paseto::local local(key);
+    string message = "Attack at dawn";
+    string token = local.encrypt(message, "kid-1");
+    cout << "Token: " << token << endl;
+    CHECK(token.substr(0, 9) == "v4.local.");
+    CHECK(paseto::footer(token) == "kid-1");
+
+    // Decrypting into a buffer the size of the token:
+    vector<char> buf(token.size());
+    output_bytes out = local.decrypt(token, output_bytes{buf.data(), buf.size()});
+    REQUIRE(out);
+    CHECK(string((char*)out.data, out.size) == message);
+
+    // Tampering with any part of it fails:
+    CHECK(!local.decrypt(token, output_bytes{buf.data(), buf.size() - 1}));     // buffer too small
+    for (size_t pos = 9; pos < token.size(); ++pos) {
+        if (token[pos] == '.')
+            continue;
+        string bad = token;
+        bad[pos] = (bad[pos] == 'A') ? 'B' : 'A';
+        CHECK(!local.decrypt(bad));
+    }
+    CHECK(!local.decrypt("v4.public." + token.substr(9)));
+    CHECK(!local.decrypt(token + "."));
+    CHECK(!local.decrypt("v4.local.AAAA"));
+    CHECK(!paseto::local(paseto::local::key()).decrypt(token));
+
+    // Empty message:
+    token = local.encrypt(string_view());
+    CHECK(local.decrypt(token) == "");
+}
+
+
+TEST_CASE("PASETO v4.public cache", "[Paseto]") {
+    auto kp = key_pair<Ed25519>::generate();
+    paseto::signer signer(kp);
+    paseto::verifier verifier(kp.get_public_key(), 2);
+
+    string t1 = signer.sign(string_view("one")), t2 = signer.sign(string_view("two")),
+           t3 = signer.sign(string_view("three"));
+    CHECK(verifier.verify(t1) == "one");
+    CHECK(verifier.cache_size() == 1);
+    CHECK(verifier.cache_hits() == 0);
+    CHECK(verifier.verify(t1) == "one");
+    CHECK(verifier.cache_hits() == 1);
+
+    // The implicit assertion is part of the cache key:
+    CHECK(!verifier.verify(t1, "x"));
+
+    // Invalid tokens aren't cached:
+    string bad = t2;
+    bad[12] ^= 1;
+    CHECK(!verifier.verify(bad));
+    CHECK(!verifier.verify(bad));
+    CHECK(verifier.cache_size() == 1);
+
+    // The oldest token is evicted:
+    CHECK(verifier.verify(t2) == "two");
+    CHECK(verifier.verify(t3) == "three");
+    CHECK(verifier.cache_size() == 2);
+    uint64_t hits = verifier.cache_hits();
+    CHECK(verifier.verify(t1) == "one");
+    CHECK(verifier.cache_hits() == hits);
+    CHECK(verifier.verify(t3) == "three");
+    CHECK(verifier.cache_hits() == hits + 1);
+
+    // Entries expire:
+    paseto::verifier short_lived(kp.get_public_key(), 10, chrono::seconds(0));
+    CHECK(short_lived.verify(t1) == "one");
+    CHECK(short_lived.verify(t1) == "one");
+    CHECK(short_lived.cache_hits() == 0);
+
+    // Another key's verifier rejects it:
+    CHECK(!paseto::verifier(key_pair<Ed25519>::generate().get_public_key(), 10).verify(t1));
+}
+
+
+TEST_CASE("PASETO v4.public benchmark", "[.][Paseto]") {
+    auto kp = key_pair<Ed25519>::generate();
+    paseto::signer signer(kp);
+    string token = signer.sign(string_view(kSignedMessage), kFooter);
+    vector<char> buf(token.size());
+
+    using clock = chrono::steady_clock;
+    auto time_it = [&](paseto::verifier const& v, int n) {
+        auto start = clock::now();
+        for (int i = 0; i < n; ++i)
+            REQUIRE(v.verify(token, output_bytes{buf.data(), buf.size()}));
+        return chrono::duration<double>(clock::now() - start).count() / n;
+    };
+    double uncached = time_it(paseto::verifier(kp.get_public_key()), 20);
+    paseto::verifier cached(kp.get_public_key(), 1000);
+    double hit = time_it(cached, 20000);
+    cout << "v4.public verify: " << uncached * 1e6 << " µs; cached: " << hit * 1e6 << " µs\n";
+
+    string payload(100000, 'x');
+    string encoded = base64url_encode(payload);
+    vector<uint8_t> decoded(encoded.size());
+    for (bool simd : {false, true}) {
+        bool using_simd = base64url_set_simd(simd);
+        auto start = clock::now();
+        for (int i = 0; i < 200; ++i)
+            REQUIRE(base64url_decode(encoded, {decoded.data(), decoded.size()}));
+        double secs = chrono::duration<double>(clock::now() - start).count();
+        cout << "base64url decode" << (using_simd ? " (AVX2)" : "") << ": "
+             << 200.0 * encoded.size() / secs / 1e9 << " GB/s\n";
+    }
+    base64url_set_simd(true);
+}
@@ -0,0 +1,88 @@
+//
+//  Test_PublicBox.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/public_box.hh"
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+
+TEST_CASE("Public box NaCl test vector", "[PublicBox]") {
+    // From the NaCl distribution's tests/box.c and box2.c:
+    auto alice_sk = from_hex("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    auto bob_sk   = from_hex("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+    auto nonce_   = from_hex("69696ee955b62b73cd62bda875fc73d68219e0036b7a0b37");
+    auto message  = from_hex("be075fc53c81f2d5cf141316ebeb0c7b5228c52a4c62cbd44b66849b64244ffc"
+                             "e5ecbaaf33bd751a1ac728d45e6c61296cdc3c01233561f41db66cce314adb31"
+                             "0e3be8250c46f06dceea3a7fa1348057e2f6556ad6b1318a024a838f21af1fde"
+                             "048977eb48f59ffd4924ca1c60902e52f0a089bc76897040e082f93776384864"
+                             "5e0705");
+
+    public_box<>::key_exchange::secret_key sk1, sk2;
+    sk1.fillWith(alice_sk.data(), 32);
+    sk2.fillWith(bob_sk.data(), 32);
+    public_box<>::key_exchange alice(sk1), bob(sk2);
+    session::nonce nonce;
+    nonce.fillWith(nonce_.data(), 24);
+
+    public_box<> alice_box(alice, bob.get_public_key());
+    public_box<> bob_box(bob, alice.get_public_key());
+    CHECK(alice_box.key() == bob_box.key());
+    cout << "beforenm key: " << hexString(alice_box.key().data(), 32) << endl;
+    CHECK(hexString(alice_box.key().data(), 32, false) ==
+          "1B27556473E985D462CD51197A9A46C76009549EAC6474F206C4EE0844F68389");
+
+    vector<uint8_t> boxed(message.size() + 16);
+    alice_box.box(nonce, {message.data(), message.size()}, {boxed.data(), boxed.size()});
+    cout << "box: " << hexString(boxed.data(), boxed.size()) << endl;
+    CHECK(hexString(boxed.data(), boxed.size(), false) ==
+          "F3FFC7703F9400E52A7DFB4B3D3305D98E993B9F48681273C29650BA32FC76CE"
+          "48332EA7164D96A4476FB8C531A1186AC0DFC17C98DCE87B4DA7F011EC48C972"
+          "71D2C20F9B928FE2270D6FB863D51738B48EEEE314A7CC8AB932164548E526AE"
+          "90224368517ACFEABD6BB3732BC0E9DA99832B61CA01B6DE56244A9E88D5F9B3"
+          "7973F622A43D14A6599B1F654CB45A74E355A5");
+
+    vector<uint8_t> opened(message.size());
+    REQUIRE(bob_box.unbox(nonce, {boxed.data(), boxed.size()}, {opened.data(), opened.size()}));
+    CHECK(opened == message);
+}
+
+
+template <class Algorithm>
+static void test_public_box() {
+    public_box<>::key_exchange alice, bob, eve;
+    public_box<Algorithm> alice_box(alice, bob.get_public_key());
+    public_box<Algorithm> bob_box(bob, alice.get_public_key());
+    public_box<Algorithm> eve_box(eve, alice.get_public_key());
+
+    string message = "Meet me at the café at midnight.";
+    for (int i = 0; i < 3; ++i) {
+        session::nonce nonce;
+        uint8_t boxed[100], opened[100];
+        output_bytes b = alice_box.box(nonce, message, {boxed, sizeof(boxed)});
+        CHECK(b.size == message.size() + 16);
+        output_bytes m = bob_box.unbox(nonce, {b.data, b.size}, {opened, sizeof(opened)});
+        REQUIRE(m);
+        CHECK(string((char*)m.data, m.size) == message);
+        CHECK(!eve_box.unbox(nonce, {b.data, b.size}, {opened, sizeof(opened)}));
+        boxed[20] ^= 1;
+        CHECK(!bob_box.unbox(nonce, {b.data, b.size}, {opened, sizeof(opened)}));
+    }
+
+    // Low-order public keys are rejected:
+    CHECK_THROWS_AS(public_box<Algorithm>(alice, public_box<>::public_key()), invalid_argument);
+}
+
+
+TEST_CASE("Public box XSalsa20", "[PublicBox]")   {test_public_box<XSalsa20_Poly1305>();}
+TEST_CASE("Public box XChaCha20", "[PublicBox]")  {test_public_box<XChaCha20_Poly1305>();}
@@ -0,0 +1,120 @@
+//
+//  Test_ReplayWindow.cc
+//  Monocypher-Cpp
+//
+
+#include "Monocypher.hh"
+#include "monocypher/ext/replay_window.hh"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+TEST_CASE("Replay window", "[ReplayWindow]") {
+    replay_window window(100);
+    CHECK(window.width() == 128);
+    CHECK(window.top() == 0);
+
+    CHECK(window.check(5));
+    CHECK(window.commit(5));
+    CHECK(!window.check(5));
+    CHECK(!window.commit(5));
+    CHECK(window.top() == 6);
+
+    // Out of order, within the window:
+    for (uint64_t seq : {3, 0, 4, 1, 2})
+        CHECK(window.commit(seq));
+    for (uint64_t seq = 0; seq <= 5; ++seq)
+        CHECK(!window.commit(seq));
+
+    // Jump ahead; old ones fall out of the window:
+    CHECK(window.commit(1000));
+    CHECK(window.top() == 1001);
+    CHECK(!window.check(6));
+    CHECK(!window.commit(872));
+    CHECK(window.commit(873));
+    CHECK(window.commit(999));
+    CHECK(!window.commit(999));
+    CHECK(window.top() == 1001);
+
+    // Slots are reused for new blocks as the window advances:
+    for (uint64_t seq = 1001; seq < 2000; ++seq)
+        CHECK(window.commit(seq));
+    for (uint64_t seq = 1900; seq < 2000; ++seq)
+        CHECK(!window.check(seq));
+    CHECK(!window.check(2000 - 129));
+    CHECK(window.check(2005));
+
+    CHECK_THROWS_AS(replay_window(0), invalid_argument);
+}
+
+
+TEST_CASE("Replay window with unbox", "[ReplayWindow]") {
+    session::key key;
+    replay_window window(1024);
+    char buf[100];
+
+    auto box = [&](uint64_t seq, const char *msg) {
+        vector<uint8_t> boxed(strlen(msg) + sizeof(session::mac));
+        key.box(session::nonce(seq), input_bytes(msg, strlen(msg)), {boxed.data(), boxed.size()});
+        return boxed;
+    };
+
+    auto boxed7 = box(7, "seven");
+    auto boxed3 = box(3, "three");
+    CHECK(key.unbox(window, 7, {boxed7.data(), boxed7.size()}, {buf, sizeof(buf)}));
+    CHECK(!key.unbox(window, 7, {boxed7.data(), boxed7.size()}, {buf, sizeof(buf)}));
+
+    // A forgery must not use up its sequence number:
+    boxed3[0] ^= 1;
+    CHECK(!key.unbox(window, 3, {boxed3.data(), boxed3.size()}, {buf, sizeof(buf)}));
+    CHECK(window.check(3));
+    boxed3[0] ^= 1;
+    output_bytes out = key.unbox(window, 3, {boxed3.data(), boxed3.size()}, {buf, sizeof(buf)});
+    REQUIRE(out);
+    CHECK(string(buf, out.size) == "three");
+    CHECK(!window.check(3));
+}
+
+
+TEST_CASE("Replay window concurrency", "[ReplayWindow]") {
+    // Several threads commit the same jittered sequence of numbers; each number must be
+    // accepted by exactly one of them.
+    static constexpr uint64_t kCount = 200000;
+    static constexpr int kThreads = 4;
+    replay_window window(1024);
+    vector<atomic<uint8_t>> accepted(kCount);
+    for (auto &a : accepted)
+        a = 0;
+
+    vector<thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint64_t i = 0; i < kCount; ++i) {
+                // Reorder each group of 16, differently in each thread:
+                uint64_t seq = (i & ~uint64_t(15)) | ((((i & 15) + 5 * t) * 7) & 15);
+                if (window.commit(seq))
+                    ++accepted[seq];
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    size_t total = 0, duplicates = 0;
+    for (auto &a : accepted) {
+        total += a;
+        duplicates += (a > 1);
+    }
+    CHECK(duplicates == 0);
+    cout << "Accepted " << total << " of " << kCount << " sequence numbers\n";
+    CHECK(total > kCount * 9 / 10);
+    CHECK(window.top() == kCount);
+}
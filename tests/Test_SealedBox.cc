@@ -0,0 +1,125 @@
+//
+//  Test_SealedBox.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/sealed_box.hh"
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+TEST_CASE("Sealed box", "[SealedBox]") {
+    sealed_box<>::key_exchange recipient;
+    auto recipient_pub = recipient.get_public_key();
+    string message = "Anonymous tip: the butler did it.";
+
+    uint8_t sealed[100], opened[100];
+    output_bytes box = sealed_box<>::seal(recipient_pub, message, {sealed, sizeof(sealed)});
+    CHECK(box.size == message.size() + 48);
+    cout << "Sealed box: " << hexString(box.data, box.size) << endl;
+
+    output_bytes out = sealed_box<>::open(recipient, {box.data, box.size}, {opened, sizeof(opened)});
+    REQUIRE(out);
+    CHECK(string((char*)out.data, out.size) == message);
+
+    // The format is libsodium's: ephemeral pk, then crypto_box_easy with a Blake2b-192 nonce.
+    sealed_box<>::public_key ephemeral_pub(sealed, 32);
+    auto nonce_hash = monocypher::hash<Blake2b<24>>::create(ephemeral_pub | recipient_pub);
+    session::nonce nonce(nonce_hash);
+    public_box<> pbox(recipient, ephemeral_pub);
+    out = pbox.unbox(nonce, {sealed + 32, box.size - 32}, {opened, sizeof(opened)});
+    REQUIRE(out);
+    CHECK(string((char*)out.data, out.size) == message);
+
+    // Only the recipient can open it, and it can't be modified:
+    sealed_box<>::key_exchange other;
+    CHECK(!sealed_box<>::open(other, {box.data, box.size}, {opened, sizeof(opened)}));
+    sealed[40] ^= 1;
+    CHECK(!sealed_box<>::open(recipient, {box.data, box.size}, {opened, sizeof(opened)}));
+    sealed[40] ^= 1;
+    sealed[3] ^= 1;
+    CHECK(!sealed_box<>::open(recipient, {box.data, box.size}, {opened, sizeof(opened)}));
+    CHECK(!sealed_box<>::open(recipient, {box.data, 47}, {opened, sizeof(opened)}));
+
+    CHECK_THROWS_AS(sealed_box<>::seal(sealed_box<>::public_key(), message, {sealed, sizeof(sealed)}),
+                    invalid_argument);
+}
+
+
+TEST_CASE("Sealed box known answer", "[SealedBox]") {
+    // libsodium's `crypto_box_seal` of "Anonymous tip: the butler did it." to Bob, with Alice's
+    // key as the ephemeral key pair (keys from the NaCl distribution's tests/box.c.) Computed
+    // independently of this library, by a reimplementation that reproduces NaCl's box.c output.
+    sealed_box<>::key_exchange::secret_key bob_sk;
+    bob_sk.fillWith(from_hex("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb").data(), 32);
+    sealed_box<>::key_exchange bob(bob_sk);
+    auto sealed = from_hex("8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a"
+                           "a851a1186cbe4c0b537a06fd2719c4d8e669c3a891956c24a3463f139d41093f"
+                           "073d7e14c93275a18b1ed6f462813d705b");
+    uint8_t opened[100];
+    output_bytes out = sealed_box<>::open(bob, {sealed.data(), sealed.size()}, {opened, sizeof(opened)});
+    REQUIRE(out);
+    CHECK(string((char*)out.data, out.size) == "Anonymous tip: the butler did it.");
+}
+
+
+TEST_CASE("Sealed box seal_many to a low-order key", "[SealedBox]") {
+    // The exception must reach the caller, not `std::terminate` a worker thread:
+    static constexpr size_t N = 40;
+    string message = "Hello";
+    vector<input_bytes> inputs(N, input_bytes(message));
+    vector<vector<uint8_t>> buffers(N, vector<uint8_t>(message.size() + sealed_box<>::overhead));
+    vector<output_bytes> outputs;
+    for (auto &buf : buffers)
+        outputs.emplace_back(buf.data(), buf.size());
+    for (uint8_t u : {0, 1}) {
+        sealed_box<>::public_key low_order;     // (zero-filled)
+        low_order[0] = u;
+        CHECK_THROWS_AS(sealed_box<>::seal_many(low_order, inputs.data(), outputs.data(), N, 4),
+                        invalid_argument);
+    }
+}
+
+
+template <class Algorithm>
+static void test_seal_many() {
+    typename sealed_box<Algorithm>::key_exchange recipient;
+    auto recipient_pub = recipient.get_public_key();
+
+    static constexpr size_t N = 50;
+    vector<string> messages;
+    vector<input_bytes> inputs;
+    vector<vector<uint8_t>> buffers;
+    vector<output_bytes> outputs;
+    for (size_t i = 0; i < N; ++i)
+        messages.push_back("Submission #" + to_string(i));
+    for (size_t i = 0; i < N; ++i) {
+        inputs.emplace_back(messages[i]);
+        buffers.emplace_back(messages[i].size() + sealed_box<Algorithm>::overhead);
+        outputs.emplace_back(buffers[i].data(), buffers[i].size());
+    }
+    sealed_box<Algorithm>::seal_many(recipient_pub, inputs.data(), outputs.data(), N, 4);
+
+    for (size_t i = 0; i < N; ++i) {
+        CHECK(outputs[i].size == buffers[i].size());
+        if (i > 0)
+            CHECK(memcmp(buffers[i].data(), buffers[i-1].data(), 32) != 0);  // distinct ephemerals
+        uint8_t opened[100];
+        auto out = sealed_box<Algorithm>::open(recipient, recipient_pub,
+                                               {outputs[i].data, outputs[i].size},
+                                               {opened, sizeof(opened)});
+        REQUIRE(out);
+        CHECK(string((char*)out.data, out.size) == messages[i]);
+    }
+}
+
+TEST_CASE("Sealed box seal_many XSalsa20", "[SealedBox]")   {test_seal_many<XSalsa20_Poly1305>();}
+TEST_CASE("Sealed box seal_many XChaCha20", "[SealedBox]")  {test_seal_many<XChaCha20_Poly1305>();}
@@ -0,0 +1,163 @@
+//
+//  Test_SecureChannel.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/secure_channel.hh"
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+namespace {
+    // A connected pair of Unix-domain stream sockets.
+    struct socket_pair {
+        int fd[2];
+        socket_pair()   {REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fd) == 0);}
+        ~socket_pair()  {::close(fd[0]); ::close(fd[1]);}
+    };
+
+    // Reads raw bytes from a socket until EOF.
+    vector<uint8_t> read_all(int fd) {
+        vector<uint8_t> data;
+        uint8_t buf[4096];
+        ssize_t n;
+        while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+            data.insert(data.end(), buf, buf + n);
+        return data;
+    }
+
+    void write_all(int fd, vector<uint8_t> const& data) {
+        REQUIRE(::write(fd, data.data(), data.size()) == ssize_t(data.size()));
+    }
+}
+
+
+TEST_CASE("Secure channel", "[SecureChannel]") {
+    secure_channel::key k1, k2;
+    socket_pair sockets;
+    secure_channel a(sockets.fd[0], k1, k2);
+    secure_channel b(sockets.fd[1], k2, k1);
+    char buf[100];
+
+    // Many small writes are coalesced into one record:
+    for (int i = 0; i < 10; ++i)
+        a.write("hello "sv);
+    a.write({"there, "sv, "world"sv});
+    a.flush();
+    CHECK(a.records_sent() == 1);
+
+    string received;
+    while (received.size() < 72) {
+        output_bytes got = b.read({buf, 10});
+        REQUIRE(got);
+        REQUIRE(got.size > 0);
+        received.append(buf, got.size);
+    }
+    CHECK(received.substr(60) == "there, world");
+    CHECK(b.records_received() == 1);
+
+    // Other direction:
+    b.write("goodbye"sv);
+    b.flush();
+    REQUIRE(a.read_exactly({buf, 7}));
+    CHECK(string(buf, 7) == "goodbye");
+
+    // Authenticated end of stream:
+    a.close_write();
+    output_bytes got = b.read({buf, sizeof(buf)});
+    CHECK(got);
+    CHECK(got.size == 0);
+    CHECK(b.records_received() == 2);
+}
+
+
+TEST_CASE("Secure channel large writes", "[SecureChannel]") {
+    secure_channel::key k1, k2;
+    socket_pair sockets;
+    secure_channel::options opts;
+    opts.max_record_size = 1000;
+    opts.max_queued_records = 4;
+    opts.rekey_interval = 7;
+    secure_channel a(sockets.fd[0], k1, k2, opts);
+    secure_channel b(sockets.fd[1], k2, k1, opts);
+
+    vector<uint8_t> data(100000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = uint8_t(i * 7 + (i >> 8));
+
+    // Write from another thread, since the socket buffer can't hold all of it:
+    thread writer([&] {
+        for (size_t pos = 0; pos < data.size(); pos += 333)
+            a.write({&data[pos], min(size_t(333), data.size() - pos)});
+        a.close_write();
+    });
+    vector<uint8_t> received(data.size());
+    bool ok = b.read_exactly({received.data(), received.size()});
+    uint8_t extra;
+    output_bytes eof = b.read({&extra, 1});
+    writer.join();
+
+    CHECK(ok);
+    CHECK(received == data);
+    CHECK(eof);
+    CHECK(eof.size == 0);
+    CHECK(a.records_sent() == 101);            // 100 full records, then end-of-stream
+    CHECK(b.records_received() == 101);
+}
+
+
+TEST_CASE("Secure channel tampering", "[SecureChannel]") {
+    secure_channel::key k1, k2;
+    socket_pair wire, relay;
+    secure_channel a(wire.fd[0], k1, k2);
+    secure_channel b(relay.fd[1], k2, k1);
+    char buf[100];
+
+    a.write("the first message"sv);
+    a.flush();
+    a.write("the second message"sv);
+    a.close_write();
+    vector<uint8_t> sent = read_all(wire.fd[1]);
+    cout << "Wire data: " << hexString(sent.data(), sent.size()) << "\n";
+
+    SECTION("Intact") {
+        write_all(relay.fd[0], sent);
+        ::shutdown(relay.fd[0], SHUT_WR);
+        REQUIRE(b.read_exactly({buf, 35}));
+        CHECK(string(buf, 35) == "the first messagethe second message");
+        CHECK(b.read({buf, sizeof(buf)}).size == 0);
+    }
+    SECTION("Modified") {
+        sent[secure_channel::header_size + 3] ^= 1;
+        write_all(relay.fd[0], sent);
+        ::shutdown(relay.fd[0], SHUT_WR);
+        CHECK(!b.read({buf, sizeof(buf)}));
+        CHECK(!b.read({buf, sizeof(buf)}));     // stays failed
+    }
+    SECTION("Reordered") {
+        size_t first = secure_channel::header_size + 17;
+        vector<uint8_t> swapped(sent.begin() + first, sent.end() - secure_channel::header_size);
+        swapped.insert(swapped.end(), sent.begin(), sent.begin() + first);
+        write_all(relay.fd[0], swapped);
+        ::shutdown(relay.fd[0], SHUT_WR);
+        CHECK(!b.read({buf, sizeof(buf)}));
+    }
+    SECTION("Truncated") {
+        sent.resize(sent.size() - secure_channel::header_size);    // drop end-of-stream record
+        write_all(relay.fd[0], sent);
+        ::shutdown(relay.fd[0], SHUT_WR);
+        CHECK(!b.read_exactly({buf, 36}));
+        CHECK(!b.read({buf, sizeof(buf)}));
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  Test_Shamir.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/shamir.hh"
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+static vector<uint8_t> random_secret(size_t size) {
+    vector<uint8_t> secret((size + 3) & ~size_t(3));
+    randomize(secret.data(), secret.size());
+    secret.resize(size);
+    return secret;
+}
+
+
+TEST_CASE("Shamir split and combine", "[Shamir]") {
+    // Odd sizes exercise both the SIMD loops and the scalar tails:
+    for (size_t size : {1, 15, 16, 31, 32, 33, 100, 1000}) {
+        for (auto [k, n] : vector<pair<unsigned,unsigned>>{{1,1}, {1,3}, {2,2}, {2,5}, {3,5}, {5,9}}) {
+            auto secret = random_secret(size);
+            auto shares = shamir::split({secret.data(), size}, k, n);
+            REQUIRE(shares.size() == n);
+            for (unsigned i = 0; i < n; ++i) {
+                CHECK(shares[i].x == i + 1);
+                CHECK(shares[i].threshold == k);
+                CHECK(shares[i].y.size() == size);
+            }
+            if (k == 1) {
+                // A degree-0 polynomial: every share is the secret itself.
+                for (auto &sh : shares)
+                    CHECK(sh.y == secret);
+            }
+
+            // Any k consecutive shares (wrapping around) reconstruct the secret:
+            for (unsigned start = 0; start < n; ++start) {
+                vector<shamir::share> subset;
+                for (unsigned i = 0; i < k; ++i)
+                    subset.push_back(shares[(start + i) % n]);
+                vector<uint8_t> out(size);
+                REQUIRE(shamir::combine(subset, {out.data(), size}));
+                CHECK(out == secret);
+            }
+
+            // More than k is fine too:
+            vector<uint8_t> out(size);
+            REQUIRE(shamir::combine(shares, {out.data(), size}));
+            CHECK(out == secret);
+
+            // k-1 shares are not enough:
+            if (k > 1) {
+                vector<shamir::share> subset(shares.begin(), shares.begin() + (k - 1));
+                CHECK(!shamir::combine(subset, {out.data(), size}));
+            }
+        }
+    }
+}
+
+
+TEST_CASE("Shamir bad shares", "[Shamir]") {
+    auto secret = random_secret(64);
+    auto shares = shamir::split({secret.data(), secret.size()}, 3, 5);
+    vector<uint8_t> out(64);
+
+    SECTION("Corrupted share") {
+        shares[1].y[17] ^= 0x40;
+        CHECK(!shamir::combine(shares.data(), 3, {out.data(), out.size()}));
+        CHECK(out == vector<uint8_t>(64, 0));       // output is wiped on failure
+    }
+    SECTION("Duplicate shares") {
+        vector<shamir::share> subset {shares[0], shares[0], shares[2]};
+        CHECK(!shamir::combine(subset, {out.data(), out.size()}));
+    }
+    SECTION("Shares from different splits") {
+        auto other = shamir::split({secret.data(), secret.size()}, 3, 5);
+        vector<shamir::share> subset {shares[0], other[1], shares[2]};
+        CHECK(!shamir::combine(subset, {out.data(), out.size()}));
+    }
+    SECTION("Wrong output size") {
+        vector<uint8_t> small(63);
+        CHECK(!shamir::combine(shares, {small.data(), small.size()}));
+    }
+    SECTION("Invalid parameters") {
+        CHECK_THROWS_AS(shamir::split({secret.data(), secret.size()}, 0, 5), invalid_argument);
+        CHECK_THROWS_AS(shamir::split({secret.data(), secret.size()}, 6, 5), invalid_argument);
+        CHECK_THROWS_AS(shamir::split({secret.data(), secret.size()}, 2, 256), invalid_argument);
+    }
+}
+
+
+TEST_CASE("Shamir share serialization", "[Shamir]") {
+    auto secret = random_secret(32);
+    auto shares = shamir::split({secret.data(), secret.size()}, 2, 3);
+
+    vector<shamir::share> parsed(2);
+    for (int i = 0; i < 2; ++i) {
+        auto bytes = shares[i + 1].to_bytes();
+        CHECK(bytes.size() == 1 + 1 + 1 + 16 + 32 + 32 + 16);
+        REQUIRE(parsed[i].from_bytes({bytes.data(), bytes.size()}));
+        CHECK(parsed[i].x == shares[i + 1].x);
+        CHECK(parsed[i].y == shares[i + 1].y);
+    }
+    vector<uint8_t> out(32);
+    REQUIRE(shamir::combine(parsed, {out.data(), out.size()}));
+    CHECK(out == secret);
+
+    auto bytes = shares[0].to_bytes();
+    shamir::share bad;
+    bytes[40] ^= 1;
+    CHECK(!bad.from_bytes({bytes.data(), bytes.size()}));
+    CHECK(!bad.from_bytes({bytes.data(), 20}));
+}
+
+
+TEST_CASE("Shamir large secret", "[Shamir]") {
+    // Larger than the internal chunk size, and not a multiple of it:
+    auto secret = random_secret(1000003);
+    auto shares = shamir::split({secret.data(), secret.size()}, 4, 7);
+    vector<shamir::share> subset {shares[6], shares[1], shares[4], shares[3]};
+    vector<uint8_t> out(secret.size());
+    REQUIRE(shamir::combine(subset, {out.data(), out.size()}));
+    CHECK(out == secret);
+}
@@ -0,0 +1,553 @@
+//
+//  Test_SignatureRules.cc
+//  Monocypher-Cpp
+//
+
+#include "hexString.hh"
+#include "Monocypher.hh"
+#include "monocypher/ext/ed25519.hh"
+#include "monocypher/ext/signature_batch.hh"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+// Edge cases in the spirit of "Taming the many EdDSAs" (Chalkias, Garillot, Nikolaenko 2020):
+// small-order and mixed-order keys and R values, non-canonical point encodings and S values,
+// and points not on the curve. Generated with an independent Python implementation of both
+// rule sets.
+struct rules_vector {
+    const char *label;
+    const char *public_key, *signature, *message;   // hex
+    bool strict, zip215;                            // expected results
+};
+
+static const rules_vector kEd25519Vectors[] = {
+    {"valid, empty message",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+     "", true, true},
+    {"valid",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "a97b56341ffeead8f11f564fdb34614ccd72f1abafcafbd32cd996b0b76d9d982506bfe88f4261cd11fc4d41f4cea754dae5714b4b97bc5c90056dc4331a360b",
+     "54616d696e6720746865206d616e7920456444534173", true, true},
+    {"wrong message",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "a97b56341ffeead8f11f564fdb34614ccd72f1abafcafbd32cd996b0b76d9d982506bfe88f4261cd11fc4d41f4cea754dae5714b4b97bc5c90056dc4331a360b",
+     "54616d696e6720746865206d616e792045644453417321", false, false},
+    {"wrong public key",
+     "e7cf5c91082a2301a4e5d8fd595af033d6279f0a29da3ddc78d4da9d7dfb5e78",
+     "a97b56341ffeead8f11f564fdb34614ccd72f1abafcafbd32cd996b0b76d9d982506bfe88f4261cd11fc4d41f4cea754dae5714b4b97bc5c90056dc4331a360b",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"S + L (non-canonical S)",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "a97b56341ffeead8f11f564fdb34614ccd72f1abafcafbd32cd996b0b76d9d9812dab445aaa57325e89845e4d2c88669dae5714b4b97bc5c90056dc4331a361b",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"S with high bit set",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "a97b56341ffeead8f11f564fdb34614ccd72f1abafcafbd32cd996b0b76d9d982506bfe88f4261cd11fc4d41f4cea754dae5714b4b97bc5c90056dc4331a368b",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"small-order A (order-1), small-order R, S = 0",
+     "0100000000000000000000000000000000000000000000000000000000000000",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac03fa0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722030", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac03fa",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722031", false, true},
+    {"small-order A (order-4), small-order R, S = 0",
+     "0000000000000000000000000000000000000000000000000000000000000000",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac037a0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722032", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc85",
+     "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722033", false, true},
+    {"small-order A (order-2), small-order R, S = 0",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc050000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722034", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc05",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722035", false, true},
+    {"small-order A (order-4), small-order R, S = 0",
+     "0000000000000000000000000000000000000000000000000000000000000080",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc850000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722036", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac037a",
+     "00000000000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722037", false, true},
+    {"mixed-order A",
+     "b2a4b8a3b47d22ea8d86603ab90b393fc1b87399ab55b3806ba4cb815cd509f2",
+     "8f0e44d9319643a8f7bf674bd19dcfdbb34fd61752dc7dcad6e74227ec58b0736e3043ef268824c3092147ac1d7472cc1b4297a8b508d46aa16c5e2b223a120b",
+     "6d697865642d6f72646572206b65792030", false, true},
+    {"mixed-order A, k = 0 mod 8",
+     "b2a4b8a3b47d22ea8d86603ab90b393fc1b87399ab55b3806ba4cb815cd509f2",
+     "e895054e116c4fb92bffd40eecd625aa4f0a8a31cb6d275318956778ff1911f18068ffa0133cbf11621461f002597487516508bd91e1c3f69961421093dd0a00",
+     "6d697865642d6f72646572206b6579203135", true, true},
+    {"mixed-order R",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "57d848cd00b5ce62fc5cc6c32f149e78235d98feab3cb7bf2abb6620ed229ae5a0e38dc9864e411e09dffa6b394c16206d0cc0c479198ddcd4e44e8be0faac0e",
+     "6d697865642d6f726465722052", false, true},
+    {"non-canonical R (y = p + 1)",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7ff441f8946bb560cd831ce7f9e9290ab206b5af19e75251bc9a2de39c038c4702",
+     "6e6f6e2d63616e6f6e6963616c2052202879203d2070202b203129", false, true},
+    {"non-canonical R (negative zero)",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "0100000000000000000000000000000000000000000000000000000000000080e1c3d26b5da49efec25aaa4b8cefc34fa9bd94fafdd8829c6dc34f32a8edf705",
+     "6e6f6e2d63616e6f6e6963616c205220286e65676174697665207a65726f29", false, true},
+    {"canonical R = identity",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "010000000000000000000000000000000000000000000000000000000000000004a6bf21a0ec4c41f83d39c27c9600de01ee392e66d5028630b0e8f5a8fc5c05",
+     "63616e6f6e6963616c2052203d206964656e74697479", false, true},
+    {"non-canonical A (y = p + 0, sign 0)",
+     "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412030", false, true},
+    {"non-canonical A (y = p + 0, sign 1)",
+     "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412030", false, true},
+    {"non-canonical A (y = p + 1, sign 0)",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412031", false, true},
+    {"non-canonical A (y = p + 1, sign 1)",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412031", false, true},
+    {"non-canonical A (y = p + 3, sign 0)",
+     "f0ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412033", false, false},
+    {"non-canonical A (y = p + 3, sign 1)",
+     "f0ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412033", false, false},
+    {"non-canonical A (y = p + 4, sign 0)",
+     "f1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412034", false, false},
+    {"non-canonical A (y = p + 4, sign 1)",
+     "f1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412034", false, false},
+    {"non-canonical A (y = p + 5, sign 0)",
+     "f2ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412035", false, false},
+    {"non-canonical A (y = p + 5, sign 1)",
+     "f2ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412035", false, false},
+    {"non-canonical A (y = p + 6, sign 0)",
+     "f3ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412036", false, false},
+    {"non-canonical A (y = p + 6, sign 1)",
+     "f3ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412036", false, false},
+    {"non-canonical A (y = p + 9, sign 0)",
+     "f6ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412039", false, false},
+    {"non-canonical A (y = p + 9, sign 1)",
+     "f6ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412039", false, false},
+    {"non-canonical A (y = p + 10, sign 0)",
+     "f7ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203130", false, false},
+    {"non-canonical A (y = p + 10, sign 1)",
+     "f7ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203130", false, false},
+    {"non-canonical A (y = p + 14, sign 0)",
+     "fbffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203134", false, false},
+    {"non-canonical A (y = p + 14, sign 1)",
+     "fbffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203134", false, false},
+    {"non-canonical A (y = p + 15, sign 0)",
+     "fcffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203135", false, false},
+    {"non-canonical A (y = p + 15, sign 1)",
+     "fcffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203135", false, false},
+    {"non-canonical A (y = p + 16, sign 0)",
+     "fdffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203136", false, false},
+    {"non-canonical A (y = p + 16, sign 1)",
+     "fdffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203136", false, false},
+    {"non-canonical A (y = p + 18, sign 0)",
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203138", false, false},
+    {"non-canonical A (y = p + 18, sign 1)",
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203138", false, false},
+    {"A = negative zero",
+     "0100000000000000000000000000000000000000000000000000000000000080",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "41203d206e65676174697665207a65726f", false, true},
+    {"A = (0,-1) with sign bit",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "41203d2028302c2d31292077697468207369676e20626974", false, true},
+    {"A not on curve",
+     "0200000000000000000000000000000000000000000000000000000000000000",
+     "e895054e116c4fb92bffd40eecd625aa4f0a8a31cb6d275318956778ff1911f18068ffa0133cbf11621461f002597487516508bd91e1c3f69961421093dd0a00",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"R not on curve",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "02000000000000000000000000000000000000000000000000000000000000008068ffa0133cbf11621461f002597487516508bd91e1c3f69961421093dd0a00",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+};
+
+static const rules_vector kEdDSAVectors[] = {
+    {"valid, empty message",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "9cb4948ff5b1b2c9d3abaabdb5448b514e7900cadfeb6a9a7db5513599c0b26d860e7b61e744db000152ed9b4b491746352719d05a2597b3c6de0f3a62284f07",
+     "", true, true},
+    {"valid",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "d05b9ba66111e8a32c51960e2a1c0060ca62cec7470ba5a16dee43eba085e7d270354a5c5bb402172216c6e62ffc05d9dc501e9dac5f8488c221a05f6ad5700a",
+     "54616d696e6720746865206d616e7920456444534173", true, true},
+    {"wrong message",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "d05b9ba66111e8a32c51960e2a1c0060ca62cec7470ba5a16dee43eba085e7d270354a5c5bb402172216c6e62ffc05d9dc501e9dac5f8488c221a05f6ad5700a",
+     "54616d696e6720746865206d616e792045644453417321", false, false},
+    {"wrong public key",
+     "b5f72c55cc9b8b0a8f2167eb662ae53512b3b83def52f0855b1dee1ad80b24bd",
+     "d05b9ba66111e8a32c51960e2a1c0060ca62cec7470ba5a16dee43eba085e7d270354a5c5bb402172216c6e62ffc05d9dc501e9dac5f8488c221a05f6ad5700a",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"S + L (non-canonical S)",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "d05b9ba66111e8a32c51960e2a1c0060ca62cec7470ba5a16dee43eba085e7d25d0940b97517156ff8b2bd890ef6e4eddc501e9dac5f8488c221a05f6ad5701a",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"S with high bit set",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "d05b9ba66111e8a32c51960e2a1c0060ca62cec7470ba5a16dee43eba085e7d270354a5c5bb402172216c6e62ffc05d9dc501e9dac5f8488c221a05f6ad5708a",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"small-order A (order-1), small-order R, S = 0",
+     "0100000000000000000000000000000000000000000000000000000000000000",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac03fa0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722030", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac03fa",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722031", false, true},
+    {"small-order A (order-4), small-order R, S = 0",
+     "0000000000000000000000000000000000000000000000000000000000000000",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac037a0000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722032", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc85",
+     "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722033", false, true},
+    {"small-order A (order-2), small-order R, S = 0",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc050000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722034", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc05",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722035", false, true},
+    {"small-order A (order-4), small-order R, S = 0",
+     "0000000000000000000000000000000000000000000000000000000000000080",
+     "26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc850000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722036", false, true},
+    {"small-order A (order-8), small-order R, S = 0",
+     "c7176a703d4dd84fba3c0b760d10670f2a2053fa2c39ccc64ec7fd7792ac037a",
+     "00000000000000000000000000000000000000000000000000000000000000800000000000000000000000000000000000000000000000000000000000000000",
+     "736d616c6c206f726465722037", false, true},
+    {"mixed-order A",
+     "e52d9db329c4ee4e07b1f0d268eab15cbf878408f27e10b4d9704e80c881f79a",
+     "f64b1a7ee94263f670759039947b33ea92900810c1038b7a2db0425d33db0bf08315d3d4264a4373f030eda061848b549d7b814b5ed3c8859291af4da7e87c01",
+     "6d697865642d6f72646572206b65792030", false, true},
+    {"mixed-order A, k = 0 mod 8",
+     "e52d9db329c4ee4e07b1f0d268eab15cbf878408f27e10b4d9704e80c881f79a",
+     "d6f37b3ad614e0f5a4e870af6920f73d222cc53ca1ad3c942b68960caf990009e2484cea0d478628913168db10c2f18d17df94e3a153275be839feb0e425ab02",
+     "6d697865642d6f72646572206b65792039", true, true},
+    {"mixed-order R",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "a0ffc6f851b70a066260b5848f67bcf3d20a530f227539bf3099a63197562c4dfe11bfdc91c667b5aa6b7aeb3a4fa914107987651b77d2cdf30c0e1b0eb3ce00",
+     "6d697865642d6f726465722052", false, true},
+    {"non-canonical R (y = p + 1)",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f4dabb39c5b760ebce5844778163aa1098ae22bc2a0e3db4f8a611fe7388e4a03",
+     "6e6f6e2d63616e6f6e6963616c2052202879203d2070202b203129", false, true},
+    {"non-canonical R (negative zero)",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "010000000000000000000000000000000000000000000000000000000000008083e42d6ea64a509b43264171b40d486364e73e2e2c0b5653a14f455e396beb03",
+     "6e6f6e2d63616e6f6e6963616c205220286e65676174697665207a65726f29", false, true},
+    {"canonical R = identity",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "010000000000000000000000000000000000000000000000000000000000000038ba08a9e4a4caa7d71c5cc3b83f75c1583472efac352f99ce79e648b5305206",
+     "63616e6f6e6963616c2052203d206964656e74697479", false, true},
+    {"non-canonical A (y = p + 0, sign 0)",
+     "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412030", false, true},
+    {"non-canonical A (y = p + 0, sign 1)",
+     "edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412030", false, true},
+    {"non-canonical A (y = p + 1, sign 0)",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412031", false, true},
+    {"non-canonical A (y = p + 1, sign 1)",
+     "eeffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412031", false, true},
+    {"non-canonical A (y = p + 3, sign 0)",
+     "f0ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412033", false, false},
+    {"non-canonical A (y = p + 3, sign 1)",
+     "f0ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412033", false, false},
+    {"non-canonical A (y = p + 4, sign 0)",
+     "f1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412034", false, false},
+    {"non-canonical A (y = p + 4, sign 1)",
+     "f1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412034", false, false},
+    {"non-canonical A (y = p + 5, sign 0)",
+     "f2ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412035", false, false},
+    {"non-canonical A (y = p + 5, sign 1)",
+     "f2ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412035", false, false},
+    {"non-canonical A (y = p + 6, sign 0)",
+     "f3ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412036", false, false},
+    {"non-canonical A (y = p + 6, sign 1)",
+     "f3ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412036", false, false},
+    {"non-canonical A (y = p + 9, sign 0)",
+     "f6ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412039", false, false},
+    {"non-canonical A (y = p + 9, sign 1)",
+     "f6ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c20412039", false, false},
+    {"non-canonical A (y = p + 10, sign 0)",
+     "f7ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203130", false, false},
+    {"non-canonical A (y = p + 10, sign 1)",
+     "f7ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203130", false, false},
+    {"non-canonical A (y = p + 14, sign 0)",
+     "fbffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203134", false, false},
+    {"non-canonical A (y = p + 14, sign 1)",
+     "fbffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203134", false, false},
+    {"non-canonical A (y = p + 15, sign 0)",
+     "fcffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203135", false, false},
+    {"non-canonical A (y = p + 15, sign 1)",
+     "fcffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203135", false, false},
+    {"non-canonical A (y = p + 16, sign 0)",
+     "fdffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203136", false, false},
+    {"non-canonical A (y = p + 16, sign 1)",
+     "fdffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203136", false, false},
+    {"non-canonical A (y = p + 18, sign 0)",
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203138", false, false},
+    {"non-canonical A (y = p + 18, sign 1)",
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f0000000000000000000000000000000000000000000000000000000000000000",
+     "6e6f6e2d63616e6f6e6963616c2041203138", false, false},
+    {"A = negative zero",
+     "0100000000000000000000000000000000000000000000000000000000000080",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "41203d206e65676174697665207a65726f", false, true},
+    {"A = (0,-1) with sign bit",
+     "ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+     "01000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+     "41203d2028302c2d31292077697468207369676e20626974", false, true},
+    {"A not on curve",
+     "0200000000000000000000000000000000000000000000000000000000000000",
+     "d6f37b3ad614e0f5a4e870af6920f73d222cc53ca1ad3c942b68960caf990009e2484cea0d478628913168db10c2f18d17df94e3a153275be839feb0e425ab02",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+    {"R not on curve",
+     "2a9ac3585f9bdf64941cb944c8cf2cee046fafbec6cba8dd0cb62f2efeea6621",
+     "0200000000000000000000000000000000000000000000000000000000000000e2484cea0d478628913168db10c2f18d17df94e3a153275be839feb0e425ab02",
+     "54616d696e6720746865206d616e7920456444534173", false, false},
+};
+
+
+template <class T>
+static T from_hex(const char *hex) {
+    auto bytes = from_hex(hex);
+    return T(bytes.data(), bytes.size());
+}
+
+
+template <class Algorithm, size_t N>
+static void check_vectors(const rules_vector (&vectors)[N]) {
+    signature_batch<Algorithm> batch, validBatch;
+    vector<size_t> expectedInvalid;
+    for (auto &v : vectors) {
+        INFO(Algorithm::name << ": " << v.label);
+        auto pk = from_hex<public_key<Algorithm>>(v.public_key);
+        auto sig = from_hex<signature<Algorithm>>(v.signature);
+        auto msg = from_hex(v.message);
+        input_bytes in{msg.data(), msg.size()};
+        CHECK(pk.check(sig, in, signature_rules::strict) == v.strict);
+        CHECK(pk.check(sig, in, signature_rules::zip215) == v.zip215);
+        (void)pk.check(sig, in, signature_rules::monocypher);  // just mustn't crash
+
+        // Each batch-of-one must agree with the single check:
+        signature_batch<Algorithm> one;
+        one.add(pk, sig, in);
+        CHECK(one.verify() == v.zip215);
+
+        if (!v.zip215)
+            expectedInvalid.push_back(batch.size());
+        batch.add(pk, sig, in);
+        if (v.zip215)
+            validBatch.add(pk, sig, in);
+    }
+    CHECK(validBatch.verify());
+    CHECK(validBatch.invalid().empty());
+    CHECK(!batch.verify());
+    CHECK(batch.invalid() == expectedInvalid);
+}
+
+
+TEST_CASE("Ed25519 signature rules corpus", "[SignatureRules]") {
+    check_vectors<Ed25519>(kEd25519Vectors);
+}
+
+
+TEST_CASE("EdDSA signature rules corpus", "[SignatureRules]") {
+    check_vectors<EdDSA>(kEdDSAVectors);
+}
+
+
+TEST_CASE("RFC 8032 signature under every rule set", "[SignatureRules]") {
+    // RFC 8032 section 7.1, TEST 2
+    auto pk = from_hex<Ed25519::public_key>("3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c");
+    auto sig = from_hex<Ed25519::signature>("92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+                                             "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00");
+    uint8_t msg = 0x72;
+    for (auto rules : {signature_rules::monocypher, signature_rules::strict, signature_rules::zip215})
+        CHECK(pk.check(sig, {&msg, 1}, rules));
+    msg = 0x73;
+    for (auto rules : {signature_rules::monocypher, signature_rules::strict, signature_rules::zip215})
+        CHECK(!pk.check(sig, {&msg, 1}, rules));
+}
+
+
+template <class Algorithm>
+static void check_batch(size_t count) {
+    signature_batch<Algorithm> batch;
+    vector<public_key<Algorithm>> keys;
+    vector<signature<Algorithm>> sigs;
+    vector<string> messages;
+    for (size_t i = 0; i < count; ++i) {
+        auto kp = key_pair<Algorithm>::generate();
+        messages.push_back("message #" + to_string(i));
+        keys.push_back(kp.get_public_key());
+        sigs.push_back(kp.sign(messages.back().data(), messages.back().size()));
+        CHECK(keys[i].check(sigs[i], messages[i], signature_rules::strict));
+        CHECK(keys[i].check(sigs[i], messages[i], signature_rules::zip215));
+        batch.add(keys[i], sigs[i], messages[i]);
+    }
+    CHECK(batch.verify());
+    CHECK(batch.invalid().empty());
+
+    // Break a few of them, in different ways:
+    batch.clear();
+    sigs[count / 2][40] ^= 1;
+    messages[count - 1] += "!";
+    for (size_t i = 0; i < count; ++i)
+        batch.add(keys[(i == 0) ? 1 : i], sigs[i], messages[i]);
+    CHECK(!batch.verify());
+    CHECK(batch.invalid() == vector<size_t>{0, count / 2, count - 1});
+}
+
+
+TEST_CASE("Signature batches", "[SignatureRules]") {
+    CHECK(signature_batch<EdDSA>().verify());
+    check_batch<EdDSA>(5);
+    check_batch<Ed25519>(5);
+    check_batch<EdDSA>(150);        // spans several multi-scalar multiplications
+}
+
+
+TEST_CASE("Signature rules benchmark", "[.][SignatureRules]") {
+    constexpr size_t n = 64;
+    vector<Ed25519::public_key> keys;
+    vector<Ed25519::signature> sigs;
+    string msg = "The quick brown fox jumps over the lazy dog";
+    for (size_t i = 0; i < n; ++i) {
+        auto kp = Ed25519::key_pair::generate();
+        keys.push_back(kp.get_public_key());
+        sigs.push_back(kp.sign(msg.data(), msg.size()));
+    }
+
+    auto time = [&](const char *what, auto fn) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        chrono::duration<double, micro> elapsed = chrono::steady_clock::now() - start;
+        cout << "    " << what << ": " << elapsed.count() / n << " us/signature\n";
+    };
+    cout << "Ed25519 verification, " << n << " signatures:\n";
+    for (auto rules : {signature_rules::monocypher, signature_rules::strict, signature_rules::zip215}) {
+        static const char* const kNames[] = {"monocypher", "strict", "zip215"};
+        time(kNames[int(rules)], [&] {
+            for (size_t i = 0; i < n; ++i)
+                CHECK(keys[i].check(sigs[i], msg, rules));
+        });
+    }
+    time("zip215 batch", [&] {
+        signature_batch<Ed25519> batch;
+        for (size_t i = 0; i < n; ++i)
+            batch.add(keys[i], sigs[i], msg);
+        CHECK(batch.verify());
+    });
+}
@@ -26,6 +26,7 @@
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 
 static inline std::string hexString(const void *buf, size_t size, bool spaces =true) {
@@ -54,3 +55,10 @@ static std::string hexString(const std::array<uint8_t,Size> &a) {
 }
 
 
+/// Decodes a string of hex digits (without spaces) into bytes.
+static inline std::vector<uint8_t> from_hex(const char *hex) {
+    std::vector<uint8_t> bytes;
+    for (; hex[0] && hex[1]; hex += 2)
+        bytes.push_back(uint8_t(std::stoul(std::string(hex, 2), nullptr, 16)));
+    return bytes;
+}
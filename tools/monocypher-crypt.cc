@@ -0,0 +1,522 @@
+//
+//  monocypher-crypt.cc
+//  Monocypher-Cpp
+//
+//  Encrypts and decrypts files or pipes with `session::encrypted_writer`, keyed by a raw key
+//  file or a password (via Argon2id.) Reading, encryption and writing run on separate threads
+//  connected by bounded queues, so I/O overlaps with crypto.
+//
+
+#include "Monocypher.hh"
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace monocypher;
+
+
+// File format:
+//   header:  magic (8) | key type (1) | 0 (3) | chunk size (4, little-endian) | salt (16) |
+//            nonce (24)
+//   chunks:  mac (16) | ciphertext
+// Every chunk but the last holds exactly `chunk size` bytes of plaintext; the last holds fewer
+// (maybe none), and is encrypted with the header as additional data. That authenticates the
+// header, and makes truncation at a chunk boundary detectable.
+
+static constexpr char     kMagic[8] = {'M','C','C','R','Y','P','T','1'};
+static constexpr size_t   kHeaderSize = 8 + 4 + 4 + 16 + 24;
+static constexpr uint8_t  kRawKey = 0, kPasswordKey = 1;
+static constexpr size_t   kDefaultChunkSize = 256 * 1024;
+static constexpr size_t   kMaxChunkSize = 64 << 20;
+static constexpr size_t   kQueueDepth = 8;          // buffers in flight per pipeline stage
+
+using key_type = session::encryption_key<>;
+using password_hash = argon2<Argon2id, 32, 100000, 3>;
+
+
+static void usage() {
+    cerr << "usage: monocypher-crypt encrypt|decrypt [options]\n"
+            "       monocypher-crypt keygen > keyfile\n"
+            "\n"
+            "  -k, --key FILE            Raw 32-byte key, binary or hex\n"
+            "  -p, --password            Prompt for a password\n"
+            "      --password-file FILE  Read the password from the first line of FILE\n"
+            "  -i, --in FILE             Input (default: stdin)\n"
+            "  -o, --out FILE            Output (default: stdout)\n"
+            "  -b, --chunk-size KB       Encryption chunk size (default: 256)\n"
+            "  -s, --stats               Print throughput to stderr\n";
+}
+
+
+[[noreturn]] static void fail(string const& message) {
+    cerr << "monocypher-crypt: " << message << "\n";
+    exit(1);
+}
+
+
+//======== I/O
+
+
+// Reads until `size` bytes or EOF; returns the number read.
+static size_t read_fully(int fd, uint8_t *dst, size_t size) {
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = ::read(fd, dst + total, size - total);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw runtime_error(string("read: ") + strerror(errno));
+        if (n == 0)
+            break;
+        total += size_t(n);
+    }
+    return total;
+}
+
+
+static void write_fully(int fd, const uint8_t *src, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, src, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            throw runtime_error(string("write: ") + strerror(errno));
+        src += n;
+        size -= size_t(n);
+    }
+}
+
+
+static string read_password_from_tty() {
+    int tty = ::open("/dev/tty", O_RDWR | O_CLOEXEC);
+    if (tty < 0)
+        fail("can't open terminal to read password");
+    termios saved, noecho;
+    ::tcgetattr(tty, &saved);
+    noecho = saved;
+    noecho.c_lflag &= ~tcflag_t(ECHO);
+    ::tcsetattr(tty, TCSAFLUSH, &noecho);
+    static const char kPrompt[] = "Password: ";
+    (void)!::write(tty, kPrompt, sizeof(kPrompt) - 1);
+    string password;
+    char c;
+    while (::read(tty, &c, 1) == 1 && c != '\n')
+        password += c;
+    ::tcsetattr(tty, TCSAFLUSH, &saved);
+    (void)!::write(tty, "\n", 1);
+    ::close(tty);
+    return password;
+}
+
+
+static string read_file(const string &path, size_t max_size) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        fail(path + ": " + strerror(errno));
+    string data(max_size, '\0');
+    data.resize(read_fully(fd, (uint8_t*)data.data(), max_size));
+    ::close(fd);
+    return data;
+}
+
+
+static key_type read_key_file(const string &path) {
+    string data = read_file(path, 130);
+    key_type key;
+    if (data.size() == 32) {
+        // Raw binary, exactly as written by `keygen`. (Any byte may be a newline.)
+        key.fillWith(data.data(), 32);
+    } else {
+        // Hex, possibly with surrounding whitespace:
+        size_t begin = data.find_first_not_of(" \t\r\n");
+        size_t end = data.find_last_not_of(" \t\r\n");
+        string_view hex;
+        if (begin != string::npos)
+            hex = string_view(data).substr(begin, end + 1 - begin);
+        if (hex.size() != 64)
+            fail(path + ": key must be 32 bytes, or 64 hex digits");
+        auto digit = [&](char c) -> unsigned {
+            if (c >= '0' && c <= '9')   return c - '0';
+            c = char(tolower(c));
+            if (c >= 'a' && c <= 'f')   return c - 'a' + 10;
+            fail(path + ": invalid hex key");
+        };
+        for (size_t i = 0; i < 32; ++i)
+            key[i] = uint8_t(digit(hex[2*i]) << 4 | digit(hex[2*i + 1]));
+    }
+    wipe(data.data(), data.size());
+    return key;
+}
+
+
+// Parses the `--chunk-size` argument, in KB.
+static size_t parse_chunk_size(const string &arg) {
+    size_t kb = 0;
+    try {
+        size_t pos;
+        kb = stoul(arg, &pos);
+        if (pos != arg.size() || !isdigit(uint8_t(arg[0])))
+            kb = 0;
+    } catch (const logic_error&) {      // invalid_argument or out_of_range
+        kb = 0;
+    }
+    if (kb == 0 || kb > kMaxChunkSize / 1024) {
+        cerr << "monocypher-crypt: invalid chunk size '" << arg << "'\n";
+        usage();
+        exit(1);
+    }
+    return kb * 1024;
+}
+
+
+//======== PIPELINE
+
+
+namespace {
+
+    struct block {
+        vector<uint8_t> data;       // mac followed by text
+        size_t          size = 0;   // bytes used in `data`
+        bool            last = false;
+    };
+
+    using block_ptr = unique_ptr<block>;
+
+
+    /// A blocking FIFO queue. `close` wakes everyone up; `pop` then returns nullopt once the
+    /// queue is empty, and `push` discards its item.
+    class block_queue {
+    public:
+        void push(block_ptr b) {
+            unique_lock<mutex> lock(_mutex);
+            if (!_closed) {
+                _items.push_back(std::move(b));
+                _cond.notify_one();
+            }
+        }
+
+        block_ptr pop() {
+            unique_lock<mutex> lock(_mutex);
+            _cond.wait(lock, [&] {return !_items.empty() || _closed;});
+            if (_items.empty())
+                return nullptr;
+            block_ptr b = std::move(_items.front());
+            _items.pop_front();
+            return b;
+        }
+
+        void close() {
+            unique_lock<mutex> lock(_mutex);
+            _closed = true;
+            _cond.notify_all();
+        }
+
+    private:
+        mutex              _mutex;
+        condition_variable _cond;
+        deque<block_ptr>   _items;
+        bool               _closed = false;
+    };
+
+
+    /// Runs read -> transform -> write on three threads. Blocks circulate from the free list
+    /// through the stages and back, so at most `kQueueDepth` are ever allocated.
+    class pipeline {
+    public:
+        pipeline(size_t block_size) {
+            for (size_t i = 0; i < kQueueDepth; ++i) {
+                auto b = make_unique<block>();
+                b->data.resize(block_size);
+                _free.push(std::move(b));
+            }
+        }
+
+        /// `read(block&)` fills a block, setting `last` on the final one.
+        /// `transform(block&)` processes a block in place.
+        /// `write(block const&)` consumes a block.
+        /// Each may throw to abort the pipeline; the first exception is rethrown here.
+        template <class Read, class Transform, class Write>
+        void run(Read read, Transform transform, Write write) {
+            thread reader([&] {
+                stage([&] {
+                    while (block_ptr b = _free.pop()) {
+                        read(*b);
+                        bool last = b->last;
+                        _to_transform.push(std::move(b));
+                        if (last)
+                            break;
+                    }
+                });
+            });
+            thread transformer([&] {
+                stage([&] {
+                    while (block_ptr b = _to_transform.pop()) {
+                        transform(*b);
+                        bool last = b->last;
+                        _to_write.push(std::move(b));
+                        if (last)
+                            break;
+                    }
+                });
+            });
+            stage([&] {
+                while (block_ptr b = _to_write.pop()) {
+                    write(*b);
+                    bool last = b->last;
+                    wipe(b->data.data(), b->size);  // don't leave plaintext lying around
+                    b->last = false;
+                    _free.push(std::move(b));
+                    if (last)
+                        break;
+                }
+            });
+            reader.join();
+            transformer.join();
+            if (_error)
+                rethrow_exception(_error);
+        }
+
+    private:
+        template <class Fn>
+        void stage(Fn fn) {
+            try {
+                fn();
+            } catch (...) {
+                unique_lock<mutex> lock(_error_mutex);
+                if (!_error)
+                    _error = current_exception();
+                lock.unlock();
+                _free.close();
+                _to_transform.close();
+                _to_write.close();
+            }
+        }
+
+        block_queue        _free, _to_transform, _to_write;
+        mutex              _error_mutex;
+        exception_ptr      _error;
+    };
+
+}
+
+
+//======== ENCRYPT / DECRYPT
+
+
+static void make_header(uint8_t header[kHeaderSize], uint8_t key_kind, uint32_t chunk_size,
+                        password_hash::salt const& salt, session::nonce const& nonce)
+{
+    ::memset(header, 0, kHeaderSize);
+    ::memcpy(header, kMagic, 8);
+    header[8] = key_kind;
+    for (int i = 0; i < 4; ++i)
+        header[12 + i] = uint8_t(chunk_size >> (8 * i));
+    ::memcpy(header + 16, salt.data(), 16);
+    ::memcpy(header + 32, nonce.data(), 24);
+}
+
+
+static uint64_t encrypt(int in, int out, key_type const& key, uint8_t key_kind,
+                        password_hash::salt const& salt, size_t chunk_size)
+{
+    session::nonce nonce;                       // (random)
+    uint8_t header[kHeaderSize];
+    make_header(header, key_kind, uint32_t(chunk_size), salt, nonce);
+    write_fully(out, header, kHeaderSize);
+
+    session::encrypted_writer<> writer(key, nonce);
+    uint64_t total = 0;
+    pipeline(sizeof(session::mac) + chunk_size).run(
+        [&](block &b) {
+            // The final chunk is the first short one; if the input's length is a multiple of
+            // the chunk size, that's an empty chunk.
+            size_t n = read_fully(in, b.data.data() + sizeof(session::mac), chunk_size);
+            b.size = sizeof(session::mac) + n;
+            b.last = (n < chunk_size);
+            total += n;
+        },
+        [&](block &b) {
+            uint8_t *text = b.data.data() + sizeof(session::mac);
+            input_bytes plain {text, b.size - sizeof(session::mac)};
+            session::mac mac = b.last ? writer.write(plain, {header, kHeaderSize}, text)
+                                      : writer.write(plain, text);
+            ::memcpy(b.data.data(), mac.data(), sizeof(mac));
+        },
+        [&](block const& b) {
+            write_fully(out, b.data.data(), b.size);
+        });
+    return total;
+}
+
+
+static uint64_t decrypt(int in, int out, key_type const& key, uint8_t const header[kHeaderSize],
+                        size_t chunk_size)
+{
+    session::nonce nonce(*(const std::array<uint8_t,24>*)(header + 32));
+    session::encrypted_reader<> reader(key, nonce);
+    size_t const frame_size = sizeof(session::mac) + chunk_size;
+    uint64_t total = 0;
+    pipeline(frame_size).run(
+        [&](block &b) {
+            b.size = read_fully(in, b.data.data(), frame_size);
+            if (b.size < sizeof(session::mac))
+                throw runtime_error("input is truncated");
+            if (b.size < frame_size) {
+                b.last = true;
+                uint8_t extra;
+                if (read_fully(in, &extra, 1) != 0)
+                    throw runtime_error("unexpected data after the end of the encrypted input");
+            }
+        },
+        [&](block &b) {
+            session::mac mac;
+            ::memcpy(mac.data(), b.data.data(), sizeof(mac));
+            uint8_t *text = b.data.data() + sizeof(session::mac);
+            input_bytes cipher {text, b.size - sizeof(session::mac)};
+            bool ok = b.last ? reader.read(mac, cipher, {header, kHeaderSize}, text)
+                             : reader.read(mac, cipher, text);
+            if (!ok)
+                throw runtime_error("decryption failed: wrong key, or the data is corrupted");
+        },
+        [&](block const& b) {
+            write_fully(out, b.data.data() + sizeof(session::mac), b.size - sizeof(session::mac));
+            total += b.size - sizeof(session::mac);
+        });
+    return total;
+}
+
+
+//======== MAIN
+
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    string command = argv[1];
+    if (command == "keygen") {
+        key_type key;
+        write_fully(STDOUT_FILENO, key.data(), key.size());
+        return 0;
+    } else if (command != "encrypt" && command != "decrypt") {
+        usage();
+        return 1;
+    }
+
+    string key_path, password_path, in_path, out_path;
+    bool prompt = false, stats = false;
+    size_t chunk_size = kDefaultChunkSize;
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> string {
+            if (i + 1 >= argc) {
+                usage();
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "-k" || arg == "--key")                  key_path = value();
+        else if (arg == "-p" || arg == "--password")        prompt = true;
+        else if (arg == "--password-file")                  password_path = value();
+        else if (arg == "-i" || arg == "--in")              in_path = value();
+        else if (arg == "-o" || arg == "--out")             out_path = value();
+        else if (arg == "-s" || arg == "--stats")           stats = true;
+        else if (arg == "-b" || arg == "--chunk-size")      chunk_size = parse_chunk_size(value());
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (int(!key_path.empty()) + int(prompt) + int(!password_path.empty()) != 1)
+        fail("specify exactly one of --key, --password or --password-file");
+    if (chunk_size == 0 || chunk_size > kMaxChunkSize)
+        fail("invalid chunk size");
+
+    int in = STDIN_FILENO;
+    if (!in_path.empty() && in_path != "-") {
+        in = ::open(in_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (in < 0)
+            fail(in_path + ": " + strerror(errno));
+    }
+
+    // Read (or create) the header, and get the key:
+    uint8_t header[kHeaderSize];
+    uint8_t key_kind = key_path.empty() ? kPasswordKey : kRawKey;
+    password_hash::salt salt;
+    if (command == "decrypt") {
+        if (read_fully(in, header, kHeaderSize) != kHeaderSize || memcmp(header, kMagic, 8) != 0)
+            fail("input is not encrypted with monocypher-crypt");
+        if (header[8] != key_kind)
+            fail(header[8] == kPasswordKey ? "input was encrypted with a password"
+                                           : "input was encrypted with a key file");
+        chunk_size = 0;
+        for (int i = 0; i < 4; ++i)
+            chunk_size |= size_t(header[12 + i]) << (8 * i);
+        if (chunk_size == 0 || chunk_size > kMaxChunkSize)
+            fail("invalid chunk size in header");
+        salt = password_hash::salt(header + 16, 16);
+    } else if (key_kind == kPasswordKey) {
+        salt.randomize();
+    }
+
+    key_type key;
+    if (key_kind == kRawKey) {
+        key = read_key_file(key_path);
+    } else {
+        string password = prompt ? read_password_from_tty() : read_file(password_path, 1024);
+        if (auto nl = password.find_first_of("\r\n"); nl != string::npos)
+            password.resize(nl);
+        if (password.empty())
+            fail("empty password");
+        auto hash = password_hash::create(password.data(), password.size(), salt);
+        key = key_type(hash.data(), 32);
+        wipe(password.data(), password.size());
+    }
+
+    int out = STDOUT_FILENO;
+    if (!out_path.empty() && out_path != "-") {
+        out = ::open(out_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (out < 0)
+            fail(out_path + ": " + strerror(errno));
+    }
+
+    auto start = chrono::steady_clock::now();
+    uint64_t bytes;
+    try {
+        if (command == "encrypt")
+            bytes = encrypt(in, out, key, key_kind, salt, chunk_size);
+        else
+            bytes = decrypt(in, out, key, header, chunk_size);
+    } catch (exception const& x) {
+        if (out != STDOUT_FILENO)
+            ::unlink(out_path.c_str());         // don't leave partial output behind
+        fail(x.what());
+    }
+    if (out != STDOUT_FILENO && ::close(out) != 0)
+        fail(out_path + ": " + strerror(errno));
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (stats) {
+        fprintf(stderr, "%sed %.1f MB in %.3f sec: %.1f MB/s\n",
+                command.c_str(), bytes / 1e6, elapsed, elapsed > 0 ? bytes / 1e6 / elapsed : 0.0);
+    }
+    return 0;
+}
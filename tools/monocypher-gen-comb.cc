@@ -0,0 +1,79 @@
+//
+//  monocypher-gen-comb.cc
+//  Monocypher-Cpp
+//
+//  Build-time generator of the Ed25519 fixed-base table used when the library is configured
+//  with `MONOCYPHER_WIDE_COMB`. Writes a C++ array definition to the file named on the command
+//  line; src/Monocypher+fixed_base.cc includes it, so the table lands in read-only data.
+//
+
+#include "../src/edwards25519.hh"
+#include <cstdio>
+
+using namespace monocypher::edwards25519;
+
+
+// Re-encodes a field element canonically, so every limb is in [0, 2^26).
+static fe canonical(const fe &f) {
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    return fe_frombytes(s);
+}
+
+
+static void write_fe(FILE *out, const fe &f) {
+    fe c = canonical(f);
+    fprintf(out, "{");
+    for (int i = 0; i < 10; ++i)
+        fprintf(out, "%s%lld", (i ? "," : ""), (long long)c.v[i]);
+    fprintf(out, "}");
+}
+
+
+int main(int argc, const char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: monocypher-gen-comb <output file>\n");
+        return 1;
+    }
+    ge row;
+    if (!ge_frombytes(row, kBase, true)) {
+        fprintf(stderr, "monocypher-gen-comb: can't decode the base point\n");
+        return 1;
+    }
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "// Generated by monocypher-gen-comb; do not edit.\n"
+                 "// kCombTable[i][j-1] = j * 256^i * B, as affine (y+x, y-x, 2dxy).\n"
+                 "static const int32_t kCombTable[32][8][3][10] = {\n");
+    for (int i = 0; i < 32; ++i) {
+        fprintf(out, "  {\n");
+        ge p = row;
+        ge_cached rowc = ge_to_cached(row);
+        for (int j = 1; j <= 8; ++j) {
+            fe zinv = fe_invert(p.Z);
+            fe x = fe_mul(p.X, zinv), y = fe_mul(p.Y, zinv);
+            fprintf(out, "    {");
+            write_fe(out, fe_add(y, x));
+            fprintf(out, ",");
+            write_fe(out, fe_sub(y, x));
+            fprintf(out, ",");
+            write_fe(out, fe_mul(fe_mul(x, y), curve_2d()));
+            fprintf(out, "},\n");
+            p = ge_add(p, rowc);
+        }
+        fprintf(out, "  },\n");
+        for (int k = 0; k < 8; ++k)
+            row = ge_double(row);
+    }
+    fprintf(out, "};\n");
+
+    if (fclose(out) != 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}
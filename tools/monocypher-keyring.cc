@@ -0,0 +1,147 @@
+//
+//  monocypher-keyring.cc
+//  Monocypher-Cpp
+//
+//  Builds binary keyring files (see monocypher/ext/keyring.hh) from text files, and looks up
+//  keys in them.
+//
+
+#include "monocypher/ext/keyring.hh"
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+
+
+static void usage() {
+    cerr << "usage: monocypher-keyring build <keys.txt> <output.keyring>\n"
+            "       monocypher-keyring lookup <file.keyring> <key or key-id in hex>...\n"
+            "\n"
+            "Each line of the text file is a public key in hex, optionally followed by\n"
+            "whitespace and metadata (the rest of the line.) Blank lines and lines starting\n"
+            "with '#' are ignored.\n";
+}
+
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9')   return c - '0';
+    if (c >= 'a' && c <= 'f')   return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')   return c - 'A' + 10;
+    return -1;
+}
+
+
+// Parses exactly `size` bytes of hex; returns false on bad digits or the wrong length.
+static bool parse_hex(string const& hex, uint8_t *out, size_t size) {
+    if (hex.size() != 2 * size)
+        return false;
+    for (size_t i = 0; i < size; ++i) {
+        int hi = hex_digit(hex[2*i]), lo = hex_digit(hex[2*i + 1]);
+        if (hi < 0 || lo < 0)
+            return false;
+        out[i] = uint8_t(hi << 4 | lo);
+    }
+    return true;
+}
+
+
+static string to_hex(const uint8_t *data, size_t size) {
+    static const char kDigits[] = "0123456789abcdef";
+    string hex;
+    for (size_t i = 0; i < size; ++i) {
+        hex += kDigits[data[i] >> 4];
+        hex += kDigits[data[i] & 0xF];
+    }
+    return hex;
+}
+
+
+static int build(const char *in_path, const char *out_path) {
+    ifstream in(in_path);
+    if (!in) {
+        cerr << "Can't open " << in_path << "\n";
+        return 1;
+    }
+    keyring::builder builder;
+    string line;
+    for (unsigned line_no = 1; getline(in, line); ++line_no) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == string::npos || line[start] == '#')
+            continue;
+        size_t end = line.find_first_of(" \t\r", start);
+        keyring::key key;
+        if (!parse_hex(line.substr(start, end - start), key.data(), key.size())) {
+            cerr << in_path << ":" << line_no << ": invalid key\n";
+            return 1;
+        }
+        string metadata;
+        if (end != string::npos) {
+            size_t meta_start = line.find_first_not_of(" \t", end);
+            if (meta_start != string::npos) {
+                metadata = line.substr(meta_start);
+                if (!metadata.empty() && metadata.back() == '\r')
+                    metadata.pop_back();
+            }
+        }
+        try {
+            builder.add(key, {metadata.data(), metadata.size()});
+        } catch (invalid_argument const& x) {
+            cerr << in_path << ":" << line_no << ": " << x.what() << "\n";
+            return 1;
+        }
+    }
+    builder.write(out_path);
+    cout << "Wrote " << builder.size() << " keys to " << out_path << "\n";
+    return 0;
+}
+
+
+static int lookup(const char *path, char **args, int nargs) {
+    keyring ring(path);
+    int status = 0;
+    for (int i = 0; i < nargs; ++i) {
+        string arg = args[i];
+        vector<keyring::entry> found;
+        keyring::key key;
+        keyring::key_id id;
+        if (parse_hex(arg, key.data(), key.size())) {
+            if (auto e = ring.find(key))
+                found.push_back(*e);
+        } else if (parse_hex(arg, id.data(), id.size())) {
+            found = ring.find_all(id);
+        } else {
+            cerr << arg << ": not a key or key id\n";
+            return 1;
+        }
+        if (found.empty()) {
+            cout << arg << ": not found\n";
+            status = 2;
+        }
+        for (auto &e : found) {
+            cout << to_hex(e.key_ptr->data(), 32) << "  "
+                 << string((const char*)e.metadata.data, e.metadata.size) << "\n";
+        }
+    }
+    return status;
+}
+
+
+int main(int argc, char *argv[]) {
+    try {
+        if (argc == 4 && strcmp(argv[1], "build") == 0)
+            return build(argv[2], argv[3]);
+        else if (argc >= 4 && strcmp(argv[1], "lookup") == 0)
+            return lookup(argv[2], argv + 3, argc - 3);
+        usage();
+        return 1;
+    } catch (exception const& x) {
+        cerr << "Error: " << x.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,291 @@
+//
+//  monocypher-sum.cc
+//  Monocypher-Cpp
+//
+//  Hashes files and directory trees in parallel, b3sum-style, or checks them against a manifest
+//  of previous output. With `--stats` it reports throughput, so it doubles as a benchmark.
+//
+
+#include "Monocypher.hh"
+#include "monocypher/ext/sha256.hh"
+#include "monocypher/ext/sha512.hh"
+#ifdef MONOCYPHER_HAS_BLAKE3
+#include "monocypher/ext/blake3.hh"
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace monocypher;
+using namespace monocypher::ext;
+namespace fs = std::filesystem;
+
+
+static void usage() {
+    cerr << "usage: monocypher-sum [options] <file or directory>...\n"
+            "       monocypher-sum [options] --check <manifest>\n"
+            "\n"
+            "  -a, --algorithm ALG   blake2b (default), sha256, sha512"
+#ifdef MONOCYPHER_HAS_BLAKE3
+            ", blake3"
+#endif
+            "\n"
+            "  -j, --threads N       Number of threads (default: number of CPUs)\n"
+            "  -c, --check FILE      Verify files listed in FILE, a previous output\n"
+            "  -s, --stats           Print file count, bytes and throughput to stderr\n";
+}
+
+
+// Files at least this big are memory-mapped; smaller ones are read.
+static constexpr size_t kMmapThreshold = 1 << 20;
+static constexpr size_t kReadBufferSize = 64 * 1024;
+
+
+// Hashes a file with hash algorithm H, calling `update` on its contents. Returns the digest, or
+// an empty vector (setting `error`) if the file can't be read.
+template <class H>
+static vector<uint8_t> hash_file(const string &path, uint64_t &bytes, string &error) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = strerror(errno);
+        return {};
+    }
+    typename H::builder builder;
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0;
+    if (ok && S_ISREG(st.st_mode) && size_t(st.st_size) >= kMmapThreshold) {
+        size_t size = size_t(st.st_size);
+        void *mem = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mem != MAP_FAILED) {
+            ::madvise(mem, size, MADV_SEQUENTIAL);
+            builder.update(mem, size);
+            ::munmap(mem, size);
+            bytes += size;
+        } else {
+            ok = false;
+        }
+    } else if (ok) {
+        auto buffer = make_unique<uint8_t[]>(kReadBufferSize);
+        ssize_t n;
+        while ((n = ::read(fd, buffer.get(), kReadBufferSize)) > 0) {
+            builder.update(buffer.get(), size_t(n));
+            bytes += size_t(n);
+        }
+        ok = (n == 0);
+    }
+    if (!ok)
+        error = strerror(errno);
+    ::close(fd);
+    if (!ok)
+        return {};
+    auto digest = builder.final();
+    return vector<uint8_t>(digest.begin(), digest.end());
+}
+
+
+using hash_file_fn = vector<uint8_t> (*)(const string&, uint64_t&, string&);
+
+struct algorithm {
+    const char*  name;
+    hash_file_fn fn;
+};
+
+static const algorithm kAlgorithms[] = {
+    {"blake2b", hash_file<blake2b64>},
+    {"sha256",  hash_file<sha256>},
+    {"sha512",  hash_file<sha512>},
+#ifdef MONOCYPHER_HAS_BLAKE3
+    {"blake3",  hash_file<monocypher::hash<Blake3<32>>>},
+#endif
+};
+
+
+static string to_hex(vector<uint8_t> const& data) {
+    static const char kDigits[] = "0123456789abcdef";
+    string hex;
+    for (uint8_t b : data) {
+        hex += kDigits[b >> 4];
+        hex += kDigits[b & 0xF];
+    }
+    return hex;
+}
+
+
+struct job {
+    string          path;
+    string          expected;       // hex digest, in check mode
+    string          digest;         // hex digest, or empty on error
+    string          error;
+};
+
+
+// Hashes all the jobs on `nthreads` threads, each taking the next unclaimed job.
+static uint64_t hash_all(vector<job> &jobs, hash_file_fn fn, unsigned nthreads) {
+    atomic<size_t>   next {0};
+    atomic<uint64_t> total {0};
+    auto worker = [&] {
+        uint64_t bytes = 0;
+        for (size_t i; (i = next++) < jobs.size(); ) {
+            auto &j = jobs[i];
+            auto digest = fn(j.path, bytes, j.error);
+            if (j.error.empty())
+                j.digest = to_hex(digest);
+        }
+        total += bytes;
+    };
+    nthreads = max(1u, min<unsigned>(nthreads, unsigned(jobs.size())));
+    vector<thread> threads;
+    for (unsigned t = 1; t < nthreads; ++t)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &t : threads)
+        t.join();
+    return total;
+}
+
+
+// Adds a job for a file, or for every regular file under a directory (in sorted order.)
+static bool add_path(const string &path, vector<job> &jobs) {
+    error_code err;
+    if (fs::is_directory(path, err)) {
+        vector<string> files;
+        for (auto i = fs::recursive_directory_iterator(path, err); !err && i != fs::end(i);
+                i.increment(err)) {
+            if (i->is_regular_file(err))
+                files.push_back(i->path().string());
+        }
+        if (err) {
+            cerr << path << ": " << err.message() << "\n";
+            return false;
+        }
+        sort(files.begin(), files.end());
+        for (auto &f : files)
+            jobs.push_back({f, "", "", ""});
+    } else {
+        jobs.push_back({path, "", "", ""});
+    }
+    return true;
+}
+
+
+// Reads a manifest of "<hex digest>  <path>" lines.
+static bool read_manifest(const string &path, vector<job> &jobs) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Can't open " << path << "\n";
+        return false;
+    }
+    string line;
+    for (unsigned line_no = 1; getline(in, line); ++line_no) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        size_t sep = line.find("  ");
+        if (sep == string::npos || sep == 0) {
+            cerr << path << ":" << line_no << ": invalid line\n";
+            return false;
+        }
+        string digest = line.substr(0, sep);
+        transform(digest.begin(), digest.end(), digest.begin(), ::tolower);
+        jobs.push_back({line.substr(sep + 2), digest, "", ""});
+    }
+    return true;
+}
+
+
+int main(int argc, char *argv[]) {
+    const algorithm *alg = &kAlgorithms[0];
+    unsigned nthreads = max(1u, thread::hardware_concurrency());
+    string manifest;
+    bool stats = false;
+    vector<string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                usage();
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "-a" || arg == "--algorithm") {
+            string name = value();
+            alg = nullptr;
+            for (auto &a : kAlgorithms)
+                if (name == a.name)
+                    alg = &a;
+            if (!alg) {
+                cerr << "Unknown algorithm " << name << "\n";
+                return 1;
+            }
+        } else if (arg == "-j" || arg == "--threads") {
+            nthreads = unsigned(max(1, atoi(value())));
+        } else if (arg == "-c" || arg == "--check") {
+            manifest = value();
+        } else if (arg == "-s" || arg == "--stats") {
+            stats = true;
+        } else if (arg == "-h" || arg == "--help" || (arg.size() > 1 && arg[0] == '-')) {
+            usage();
+            return 1;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    vector<job> jobs;
+    if (!manifest.empty()) {
+        if (!paths.empty() || !read_manifest(manifest, jobs)) {
+            usage();
+            return 1;
+        }
+    } else {
+        if (paths.empty()) {
+            usage();
+            return 1;
+        }
+        for (auto &p : paths)
+            if (!add_path(p, jobs))
+                return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    uint64_t bytes = hash_all(jobs, alg->fn, nthreads);
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    int status = 0;
+    for (auto &j : jobs) {
+        if (!j.error.empty()) {
+            cerr << j.path << ": " << j.error << "\n";
+            status = 1;
+        } else if (manifest.empty()) {
+            cout << j.digest << "  " << j.path << "\n";
+        } else if (j.digest == j.expected) {
+            cout << j.path << ": OK\n";
+        } else {
+            cout << j.path << ": FAILED\n";
+            status = 1;
+        }
+    }
+
+    if (stats) {
+        fprintf(stderr, "%s: %zu files, %.1f MB in %.3f sec on %u threads: %.1f MB/s\n",
+                alg->name, jobs.size(), bytes / 1e6, elapsed, nthreads,
+                elapsed > 0 ? bytes / 1e6 / elapsed : 0.0);
+    }
+    return status;
+}